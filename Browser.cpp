@@ -4,52 +4,74 @@
   Description: This class defines information about the browser class
 */
 #include "Browser.h"
+#include "CommandRunner.h"
+#include <algorithm>
+#include <climits>
+#include <thread>
+#include <type_traits>
 
 // Name: Browser (Overloaded constructor)
 // Description: Creates a new Browser with the filename passed
 // Preconditions: None
 // Postconditions: Sets m_fileName and m_currentPage to nullptr
 Browser::Browser(string filename)
-    :m_fileName(filename),m_currentPage(nullptr){}
+    :m_times(m_urls),m_visits(m_urls, m_times),m_search(m_urls),m_currentPage(nullptr),
+     m_fileName(filename),m_maxEntries(UNLIMITED),
+     m_maxBytes(UNLIMITED),m_backBytes(0),m_evictions(0),m_peakSize(0),
+     m_loadThreads(1),m_checkpointRecords(JOURNAL_CHECKPOINT_RECORDS){}
 
 // Name: ~Browser (Destructor)
 // Description: Deallocates the items in m_backStack, m_forwardStack and
-//              m_currentPage
+//              m_currentPage. Entries are trivially destructible, so
+//              m_entryPool frees them a block at a time (built without
+//              pools, each entry is released first).
 // Preconditions: None
 // Postconditions: Deallocates all dynamically allocated memory
 Browser::~Browser(){
-    //iterate through BackStack and delete each navEntry
-    while (!m_backStack.IsEmpty()){ //while its not empty
-        NavigationEntry* temp = m_backStack.Pop(); //get the top node navenry
-        delete temp; // delete the navEntry in the node
-    }
-    //iterate through ForwardStack and delete each navEntry
-    while (!m_forwardStack.IsEmpty()){ //while its not empty
-        NavigationEntry* temp = m_forwardStack.Pop();
-        delete temp;
-    }
-    //destroy current page
-    delete m_currentPage;
-    m_currentPage = nullptr;
+    static_assert(is_trivially_destructible<NavigationEntry>::value,
+                  "m_entryPool must run NavigationEntry destructors");
+#if !USE_POOL
+    ClearHistory();
+#endif
+    m_currentPage = nullptr; //m_entryPool releases every entry
 }
 
 // Name: StartBrowser
-// Description: Loads the file and calls the menu
+// Description: Opens the journal beside the file and calls the menu. The
+//              first start imports the file; later starts load its
+//              snapshot and replay the journal tail instead. Menu
+//              operations arrive one at a time, so each is synced at once.
 // Preconditions: None
 // Postconditions: Menu keeps running until exited
 void Browser::StartBrowser(){
-    LoadFile();
+    SetJournalGroup(1, 0); //a group would wait for the next operation
+    try{
+        if (!OpenJournal(m_fileName + SNAPSHOT_SUFFIX, m_fileName + JOURNAL_SUFFIX)){
+            cerr << "Cannot write the journal for " << m_fileName
+                 << "; changes will not be saved" << endl;
+        }
+    } catch (const runtime_error& error){ //the journal is left as it was
+        cerr << error.what() << "; changes will not be saved" << endl;
+    }
     Menu();
 }
 
 // Name: Menu
 // Description: Menu that allows browser history to be displayed, go back,
-//              go forward, visit a site or quit.
+//              go forward, visit a site, show the metrics or quit.
 // Preconditions: None
 // Postconditions: When exiting, thanks user.
 void Browser::Menu(){
     bool running = true; //program flag
+    bool warned = false; //the user knows the journal is failing
     while (running){
+        if (HasJournalFailed() != warned){ //warn once per failure
+            warned = !warned;
+            if (warned){
+                cout << "Warning: cannot write the journal for " << m_fileName
+                     << "; recent changes are not saved\n" << endl;
+            }
+        }
         cout << "Welcome to the Browser History Simulator\n" << endl;
         cout << "Current Website:\n" << m_currentPage << endl; //uses overloaded << operator
         //main menu display
@@ -59,6 +81,7 @@ void Browser::Menu(){
         cout << "3. Go Forward" << endl;
         cout << "4. Visit Site" << endl;
         cout << "5. Quit" << endl; 
+        cout << "6. Show Metrics" << endl;
         //user input
         int input;
         cin >> input;
@@ -80,6 +103,13 @@ void Browser::Menu(){
                 cout << "Ending Browser History Simulator" << endl;
                 running = false;
                 break;
+            case 6:{
+                MetricsSnapshot snapshot;
+                GetMetrics(snapshot);
+                WriteMetrics(snapshot, cout);
+                cout << endl;
+                break;
+            }
             default: //input validation. No message, just reprompt
                 cout << endl; //line break
         }
@@ -87,27 +117,79 @@ void Browser::Menu(){
 }
 
 // Name: Visit
-// Description: Dynamically allocates a new NavigationEntry (NE).
+// Description: Interns url in m_urls and allocates a new NavigationEntry
+//              (NE) from m_entryPool. Discards the forward history.
 //              If m_currentPage is nullptr, assigns new NE to the current Page
 //              Otherwise, pushes the currentPage into the history and updates
-//              m_currentPage to new NE
+//              m_currentPage to new NE. timestamp is in milliseconds
+//              since the epoch.
 // Preconditions: None
 // Postconditions: Adds things to m_backStack or m_currentPage
-void Browser::Visit(const string& url, int timestamp){
-    if (m_currentPage == nullptr){ //if current page is empty
-        m_currentPage = new NavigationEntry(url, timestamp);
-    } else{ 
-        m_backStack.Push(m_currentPage); //put the current page in backstack
-        m_currentPage = new NavigationEntry(url,timestamp);
+void Browser::Visit(string_view url, int64_t timestamp){
+    MetricTimer timer(METRIC_VISIT_TIME);
+    UrlId known = static_cast<UrlId>(m_urls.GetSize());
+    ClearForward(); //a new visit drops the sites you went back from
+    AppendEntry(NewEntry(url, timestamp));
+    EnforceHistoryLimit(); //drop the oldest entries if over the limit
+    m_search.Add(known, static_cast<UrlId>(m_urls.GetSize()), m_visits); //a first visit is searchable
+    Log(JOURNAL_VISIT, url, timestamp, 0);
+    CheckpointIfDue();
+    CountMetric(METRIC_VISITS);
+    PeakMetric(METRIC_PEAK_BACK, GetBackSize());
+}
+
+// Name: VisitBatch
+// Description: Visits count records in order, ending in the same state as
+//              calling Visit on each. The forward history is dropped once,
+//              the back history is reserved up front and new URLs join
+//              m_search in one merge. With only an entry limit, records
+//              that would be evicted before the batch ends are interned
+//              and counted as evictions without allocating an entry.
+// Preconditions: records points to count records (URLs are copied in)
+// Postconditions: The last record is m_currentPage
+void Browser::VisitBatch(const HistoryRecord* records, size_t count){
+    if (count == 0){
+        return;
+    }
+    UrlId known = static_cast<UrlId>(m_urls.GetSize());
+    ClearForward();
+    size_t first = 0;
+    if (m_maxEntries != UNLIMITED && m_maxBytes == UNLIMITED && count > m_maxEntries + 1){
+        //only the last m_maxEntries + 1 records survive, with nothing older
+        first = count - m_maxEntries - 1;
+        size_t dropped = GetBackSize() + ((m_currentPage == nullptr) ? 0 : 1) + first;
+        m_evictions += dropped;
+        CountMetric(METRIC_EVICTIONS, dropped);
+        ClearHistory();
+        for (size_t i = 0; i < first; i++){
+            m_urls.Intern(records[i].m_url);
+        }
+        m_peakSize = max(m_peakSize, m_maxEntries); //the loop fills the limit
     }
+#if USE_TIMELINE_HISTORY
+    m_timeline.Reserve(count - first);
+#else
+    m_backStack.Reserve(m_backStack.GetSize() + count - first);
+#endif
+    for (size_t i = first; i < count; i++){
+        AppendEntry(NewEntry(records[i].m_url, records[i].m_timeStamp));
+        EnforceHistoryLimit();
+    }
+    m_search.Add(known, static_cast<UrlId>(m_urls.GetSize()), m_visits);
+    for (size_t i = 0; i < count; i++){ //the batch is done, so a checkpoint sees all of it
+        Log(JOURNAL_VISIT, records[i].m_url, records[i].m_timeStamp, 0);
+    }
+    CheckpointIfDue();
+    CountMetric(METRIC_VISITS, count);
+    PeakMetric(METRIC_PEAK_BACK, GetBackSize());
 }
 
 // Name: NewVisit
 // Description: User enters the URL of the site visited and populates the
 //              timestamp based on the current system time (below)
 //              auto now = chrono::system_clock::now();
-//              time_t nowAsTimeT = std::chrono::system_clock::to_time_t(now);
-//              int64_t timestamp = static_cast<int64_t>(nowAsTimeT);
+//              int64_t timestamp = duration_cast<milliseconds>(
+//                  now.time_since_epoch()).count();
 // Preconditions: None
 // Postconditions: Adds new URL to m_backStack or m_currentPage
 void Browser::NewVisit(){
@@ -117,16 +199,9 @@ void Browser::NewVisit(){
     cin >> input;
     //make a new timestamp of current system time by using provided code
     auto now = chrono::system_clock::now();
-    time_t nowAsTimeT = std::chrono::system_clock::to_time_t(now);
-    int64_t timestamp = static_cast<int64_t>(nowAsTimeT);
-    //set the new current page (reference Visit)
-    if (m_currentPage == nullptr){ //if no current page exists
-        m_currentPage = new NavigationEntry(input, timestamp);
-    }
-    else{ 
-        m_backStack.Push(m_currentPage); 
-        m_currentPage = new NavigationEntry(input, timestamp);
-    }
+    int64_t timestamp = chrono::duration_cast<chrono::milliseconds>(now.time_since_epoch()).count();
+    //set the new current page
+    Visit(input, timestamp);
 }
 
 // Name: Display
@@ -134,22 +209,70 @@ void Browser::NewVisit(){
 // Preconditions: None
 // Postconditions: None
 void Browser::Display(){
+    StreamSink sink(cout);
+    Display(sink);
+    cout.flush();
+}
+
+// Name: Display (sink)
+// Description: Writes the same text as Display to sink through a
+//              HistoryWriter, so large histories go out in big blocks
+// Preconditions: None
+// Postconditions: Returns false if writing to sink failed
+bool Browser::Display(OutputSink& sink) const{
+    HistoryWriter out(sink);
+    Display(out);
+    return out.Flush();
+}
+
+// Name: Display (writer)
+// Description: Adds the same text as Display to out without flushing it,
+//              so it can share a buffer with other output
+// Preconditions: None
+// Postconditions: None
+void Browser::Display(HistoryWriter& out) const{
+    size_t number = 0;
+    auto line = [&out, &number](const NavigationEntry* entry){
+        out.WriteNumber(++number);
+        out.Write(". ");
+        out.WriteEntry(*entry);
+    };
     //Back Stack Display
-    cout << "**Back Stack**" << endl;
-    m_backStack.Display();
-    cout << endl;
+    out.Write("**Back Stack**\n");
+#if USE_TIMELINE_HISTORY
+    size_t back = m_timeline.GetBackSize();
+    for (size_t i = 1; i <= back; i++){ //newest back entry first, like a stack
+        line(m_timeline.At(back - i));
+    }
+#else
+    m_backStack.ForEach(line); //top first
+#endif
+    if (number == 0){
+        out.Write("the stack is empty\n");
+    }
+    out.Write("\n");
     //Forward Stack Display
-    cout << "**Forward Stack**" << endl;
-    m_forwardStack.Display();
-    cout << endl;
-    //Current Website (use NavEntry overloaded <<)
+    out.Write("**Forward Stack**\n");
+    number = 0;
+#if USE_TIMELINE_HISTORY
+    for (size_t i = 1; i <= m_timeline.GetForwardSize(); i++){ //next page first
+        line(m_timeline.At(back + i));
+    }
+#else
+    m_forwardStack.ForEach(line);
+#endif
+    if (number == 0){
+        out.Write("the stack is empty\n");
+    }
+    out.Write("\n");
+    //Current Website
     if(m_currentPage == nullptr){
-        cout << "No current page" << endl;
+        out.Write("No current page\n");
     }
     else{
-        cout << *m_currentPage << endl;
+        out.WriteEntry(*m_currentPage);
     }
-    cout << endl;
+    out.Write("\n");
 }
 
 // Name: Back (steps)
@@ -157,17 +280,27 @@ void Browser::Display(){
 //              Moves item from m_backStack to m_currentPage
 //              If m_backStack is empty, does not fail but does nothing.
 //              While can do more than one step, normally only moves one.
+//              Stops at the oldest page if steps is too large.
+//              Returns the new current page (an empty entry if nothing
+//              has been visited) by reference, valid until the history
+//              changes, so navigating copies nothing.
 // Preconditions: m_backStack must not be empty.
 // Postconditions: Rotates items as above
-NavigationEntry Browser::Back(int steps){
-    if (m_backStack.IsEmpty()){ // do nothing if backstack is empty
+const NavigationEntry& Browser::Back(int steps){
+    MetricTimer timer(METRIC_BACK_TIME);
+    if (m_currentPage == nullptr){ //nothing visited yet
+        return m_noPage;
+    }
+    if (GetBackSize() == 0){ // do nothing if backstack is empty
         return *m_currentPage;
     }
-    for (int i = 0; i < steps; i++){
-        //set current page into forward stack
-        m_forwardStack.Push(m_currentPage);
-        //set previous page as current
-        m_currentPage = m_backStack.Pop();
+    size_t moved = MoveBack(steps);
+    if (moved > 0){
+        Log(JOURNAL_BACK, string_view(), 0, moved);
+        CheckpointIfDue();
+        CountMetric(METRIC_BACKS);
+        CountMetric(METRIC_BACK_STEPS, moved);
+        PeakMetric(METRIC_PEAK_FORWARD, GetForwardSize());
     }
     return *m_currentPage;
 }
@@ -177,54 +310,733 @@ NavigationEntry Browser::Back(int steps){
 //              Moves item from m_currentPage to m_forwardStack
 //              If m_forwardStack is empty, does not fail but does nothing.
 //              While can do more than one step, normally only moves one.
+//              Stops at the newest page if steps is too large.
+//              Returns the new current page like Back.
 // Preconditions: m_forwardStack must not be empty
 // Postconditions: Rotates items as above
-NavigationEntry Browser::Forward(int steps){
+const NavigationEntry& Browser::Forward(int steps){
+    MetricTimer timer(METRIC_FORWARD_TIME);
+    if (m_currentPage == nullptr){ //nothing visited yet
+        return m_noPage;
+    }
+#if USE_TIMELINE_HISTORY
+    if (m_timeline.GetForwardSize() == 0){ // do nothing if forwardstack is empty
+        return *m_currentPage;
+    }
+    size_t moved = m_timeline.Forward((steps < 0) ? 0 : steps); //only the cursor moves
+    m_currentPage = m_timeline.GetCurrent();
+#else
     if (m_forwardStack.IsEmpty()){ // do nothing if forwardstack is empty
         return *m_currentPage;
     }
-    for (int i = 0; i < steps; i++){
+    size_t moved = 0;
+    for (int i = 0; i < steps && !m_forwardStack.IsEmpty(); i++){ //stop at the newest
         //set current page into back stack
-        m_backStack.Push(m_currentPage);
+        PushHistory(m_currentPage);
         //set forward page as current
         m_currentPage = m_forwardStack.Pop();
+        moved++;
+    }
+#endif
+    m_visits.MoveCursor(static_cast<long long>(moved));
+    if (moved > 0){
+        Log(JOURNAL_FORWARD, string_view(), 0, moved);
+        CheckpointIfDue();
+        CountMetric(METRIC_FORWARDS);
+        CountMetric(METRIC_FORWARD_STEPS, moved);
+        PeakMetric(METRIC_PEAK_BACK, GetBackSize());
     }
     return *m_currentPage;
 }
 
 // Name: GetCurrentPage
-// Description: Returns the current page
+// Description: Returns the current page by reference. It stays valid
+//              until the history changes. Throws runtime_error if
+//              nothing has been visited.
 // Preconditions: None
 // Postconditions: None
-NavigationEntry Browser::GetCurrentPage() const{
+const NavigationEntry& Browser::GetCurrentPage() const{
     if (m_currentPage == nullptr){ //if its nullptr
         throw runtime_error("No current page exists");
     }
     return *m_currentPage;
 }
 
+// Name: HasCurrentPage
+// Description: Returns true if a site has been visited
+// Preconditions: None
+// Postconditions: None
+bool Browser::HasCurrentPage() const{return m_currentPage != nullptr;}
+
 // Name: LoadFile
-// Description: Loads the file using Visit
+// Description: Maps the file into memory and loads each record using Visit.
+//              With more than one load thread the file is parsed in
+//              parallel chunks and visited in file order, giving the same
+//              result as a sequential load. Malformed records are skipped
+//              and kept in m_loadErrors.
 // Preconditions: None
 // Postconditions: Adds things to m_backStack or m_currentPage
 void Browser::LoadFile(){
-    ifstream file(m_fileName); 
-    //opening and processing areas
-    if (file.is_open()){
-        //variables for one NavEntry
-        string url, timestampStr;
-        while(getline(file, url, DELIMITER) &&
-            getline(file, timestampStr, DELIMITER)){
-            //convert all timestamp variable using stoi
-            int timestamp = stoi(timestampStr);
-            if (m_currentPage == nullptr){ // for first NavEntry
-                m_currentPage = new NavigationEntry(url, timestamp);
-            }
-            else{ //push current page into back stack and set current page
-                m_backStack.Push(m_currentPage);
-                m_currentPage = new NavigationEntry(url, timestamp);
-            }
+    MetricTimer timer(METRIC_LOAD_TIME);
+    MappedFile file;
+    m_loadErrors.clear();
+    if (!file.Open(m_fileName)){ //nothing to load
+        return;
+    }
+    size_t records = 0;
+    //processing areas
+    if (m_loadThreads > 1){
+        vector<HistoryChunk> chunks;
+        ParseChunks(file.GetData(), file.GetData() + file.GetSize(), m_loadThreads, chunks);
+        for (size_t i = 0; i < chunks.size(); i++){ //splice in file order
+            VisitBatch(chunks[i].m_records.data(), chunks[i].m_records.size());
+            records += chunks[i].m_records.size();
+            m_loadErrors.insert(m_loadErrors.end(), chunks[i].m_errors.begin(),
+                                chunks[i].m_errors.end());
+        }
+    }
+    else{
+        HistoryParser parser(file.GetData(), file.GetData() + file.GetSize());
+        //variables for one NavEntry (url views the mapped file)
+        string_view url;
+        int64_t timestamp;
+        while (parser.Next(url, timestamp)){
+            Visit(url, timestamp);
+            records++;
+        }
+        m_loadErrors = parser.GetErrors();
+    }
+    CountMetric(METRIC_LOADS);
+    CountMetric(METRIC_LOAD_RECORDS, records);
+    CountMetric(METRIC_LOAD_BYTES, file.GetSize());
+    CountMetric(METRIC_LOAD_ERRORS, m_loadErrors.size());
+    if (!m_loadErrors.empty()){
+        cerr << "Skipped " << m_loadErrors.size() << " malformed record(s) in "
+             << m_fileName << " (first at byte " << m_loadErrors[0].m_offset
+             << ": " << m_loadErrors[0].m_message << ")" << endl;
+    }
+}
+
+// Name: SetLoadThreads
+// Description: Sets how many threads LoadFile parses with. 1 parses on the
+//              calling thread, 0 uses every hardware thread.
+// Preconditions: None
+// Postconditions: Later LoadFile calls use the new thread count
+void Browser::SetLoadThreads(unsigned threads){
+    if (threads == 0){
+        threads = thread::hardware_concurrency();
+    }
+    m_loadThreads = (threads == 0) ? 1 : threads; //hardware_concurrency may not know
+}
+
+// Name: GetLoadErrors
+// Description: Returns the malformed records skipped by the last LoadFile
+// Preconditions: None
+// Postconditions: None
+const vector<LoadError>& Browser::GetLoadErrors() const{return m_loadErrors;}
+
+// Name: RunScript
+// Description: Runs the commands in fileName (COMMAND_STDIN for stdin)
+//              without the menu, writing their output to cout in large
+//              blocks. See CommandRunner.h for the commands. With
+//              pipelined true the script is read and parsed on a second
+//              thread. Malformed lines are skipped and reported on cerr.
+// Preconditions: None
+// Postconditions: Returns false if the script could not be read or the
+//                 output could not be written
+bool Browser::RunScript(const string& fileName, bool pipelined){
+    bool fromStdin = (fileName == COMMAND_STDIN);
+    FILE* in = fromStdin ? stdin : fopen(fileName.c_str(), "rb");
+    if (in == nullptr){
+        cerr << "Cannot open " << fileName << endl;
+        return false;
+    }
+    StreamSink sink(cout);
+    CommandRunner runner(*this, sink);
+    bool ok = runner.Run(in, pipelined);
+    if (!fromStdin){
+        fclose(in);
+    }
+    cout.flush();
+    const vector<LoadError>& errors = runner.GetErrors();
+    if (!errors.empty()){
+        cerr << "Skipped " << errors.size() << " malformed command(s) in " << fileName
+             << " (first at byte " << errors[0].m_offset << ": " << errors[0].m_message
+             << ")" << endl;
+    }
+    return ok;
+}
+
+// Name: SaveSnapshot
+// Description: Writes m_backStack, m_currentPage and m_forwardStack to
+//              fileName in the binary snapshot format
+// Preconditions: None
+// Postconditions: Returns false if the file could not be written
+bool Browser::SaveSnapshot(const string& fileName) const{
+    vector<NavigationEntry*> entries;
+    size_t backCount;
+    GetHistory(entries, backCount);
+    string snapshot;
+    EncodeSnapshot(entries, backCount, snapshot);
+    ofstream file(fileName, ios::binary | ios::trunc);
+    file.write(snapshot.data(), snapshot.size());
+    return file.good();
+}
+
+// Name: LoadSnapshot
+// Description: Replaces the history with the one saved in fileName. If
+//              the snapshot is malformed, throws runtime_error and leaves
+//              the history unchanged.
+// Preconditions: None
+// Postconditions: Returns false if the file could not be opened
+bool Browser::LoadSnapshot(const string& fileName){
+    uint64_t id;
+    if (!ReadSnapshot(fileName, id)){
+        return false;
+    }
+    if (m_journal.IsOpen()){ //the journal's records no longer apply
+        Checkpoint();
+    }
+    return true;
+}
+
+// Name: OpenJournal
+// Description: Loads the snapshot in snapshotName and replays the records
+//              in journalName that follow it, then logs every later
+//              Visit, Back and Forward to journalName. A journal that
+//              names a different snapshot is already in it and is
+//              dropped. Without a readable snapshot, imports m_fileName
+//              with LoadFile, replays a journal that follows no snapshot
+//              and checkpoints. Throws runtime_error, leaving the journal
+//              untouched and closed, if its records cannot be applied:
+//              its header is malformed or its snapshot is gone.
+// Preconditions: Nothing else has been loaded
+// Postconditions: Returns false if the journal or the snapshot could not
+//                 be written
+bool Browser::OpenJournal(const string& snapshotName, const string& journalName){
+    m_journal.Close();
+    m_snapshotName = snapshotName;
+    uint64_t id = 0; //0 names no snapshot
+    bool hasSnapshot = false;
+    try{
+        hasSnapshot = ReadSnapshot(snapshotName, id);
+    } catch (const runtime_error& error){ //rebuilt from m_fileName and the journal
+        cerr << error.what() << "; importing " << m_fileName << " instead" << endl;
+    }
+    if (!hasSnapshot){ //first start, or no checkpoint has survived
+        LoadFile();
+    }
+    MappedFile file;
+    vector<JournalRecord> records; //URLs view the mapped journal
+    uint64_t base = id;
+    size_t validSize = 0;
+    if (file.Open(journalName) &&
+        !DecodeJournal(file.GetData(), file.GetSize(), base, records, validSize)){
+        if (file.GetSize() >= JOURNAL_HEADER_SIZE){ //not just a torn header
+            throw runtime_error("Cannot replay journal " + journalName + ": malformed header");
+        }
+        base = id; //a header cut short by a crash holds no records
+    }
+    if (base != id){
+        if (!hasSnapshot){
+            throw runtime_error("Cannot replay journal " + journalName + ": the snapshot it follows, " +
+                                snapshotName + ", is missing or unreadable");
+        }
+        //a checkpoint stopped between saving the snapshot and emptying
+        //the journal, so the snapshot already holds these records
+        records.clear();
+        validSize = 0;
+    }
+    Replay(records);
+    if (!m_journal.Open(journalName, id, validSize, records.size())){
+        return false;
+    }
+    return hasSnapshot || Checkpoint(); //a failed checkpoint keeps the journal for the next start
+}
+
+// Name: Checkpoint
+// Description: Compacts the journal: saves the history to the snapshot
+//              and empties the journal. Runs by itself every
+//              m_checkpointRecords journal records.
+// Preconditions: None
+// Postconditions: Returns false if no journal is open or the snapshot
+//                 could not be written
+bool Browser::Checkpoint(){
+    if (!m_journal.IsOpen()){
+        return false;
+    }
+    vector<NavigationEntry*> entries;
+    size_t backCount;
+    GetHistory(entries, backCount);
+    string snapshot;
+    EncodeSnapshot(entries, backCount, snapshot);
+    //the new snapshot is in place before the journal is emptied; a crash
+    //between the two leaves a journal naming the old snapshot, which
+    //OpenJournal then drops
+    if (!ReplaceFile(m_snapshotName, snapshot)){
+        return false;
+    }
+    return m_journal.Reset(GetSnapshotId(snapshot.data(), snapshot.size()));
+}
+
+// Name: SetCheckpointInterval
+// Description: Checkpoints once the journal holds records records
+//              (UNLIMITED checkpoints only when asked)
+// Preconditions: None
+// Postconditions: None
+void Browser::SetCheckpointInterval(size_t records){m_checkpointRecords = records;}
+
+// Name: SetJournalGroup
+// Description: Passes the group commit size and delay to m_journal
+// Preconditions: records is greater than 0
+// Postconditions: None
+void Browser::SetJournalGroup(size_t records, int64_t delay){
+    m_journal.SetGroupCommit(records, delay);
+}
+
+// Name: HasJournalFailed
+// Description: Returns true if recent operations could not be written to
+//              the journal; they stay buffered and are retried
+// Preconditions: None
+// Postconditions: None
+bool Browser::HasJournalFailed() const{return m_journal.HasFailed();}
+
+// Name: SetHistoryLimit
+// Description: Caps m_backStack at maxEntries entries and maxBytes bytes of
+//              URL text (UNLIMITED turns a limit off). Whenever a limit is
+//              exceeded the oldest entry is evicted from the bottom of
+//              m_backStack and deallocated.
+// Preconditions: None
+// Postconditions: Limits are stored and enforced immediately
+void Browser::SetHistoryLimit(size_t maxEntries, size_t maxBytes){
+    m_maxEntries = maxEntries;
+    m_maxBytes = maxBytes;
+    EnforceHistoryLimit();
+}
+
+// Name: GetEvictionCount
+// Description: Returns how many entries have been evicted by the limit
+// Preconditions: None
+// Postconditions: None
+size_t Browser::GetEvictionCount() const{return m_evictions;}
+
+// Name: GetUrlTable
+// Description: Returns the table of interned URLs
+// Preconditions: None
+// Postconditions: None
+const UrlTable& Browser::GetUrlTable() const{return m_urls;}
+
+// Name: GetPeakSize
+// Description: Returns the largest size m_backStack has reached
+// Preconditions: None
+// Postconditions: None
+size_t Browser::GetPeakSize() const{return m_peakSize;}
+
+// Name: FindVisit
+// Description: Looks up url in m_visits: how many entries in the history
+//              have it, when it was first and last visited and how many
+//              steps back or forward its newest entry is
+// Preconditions: None
+// Postconditions: Returns true and fills info if url is in the history
+bool Browser::FindVisit(string_view url, VisitInfo& info) const{
+    return m_visits.Find(url, info);
+}
+
+// Name: QueryBetween
+// Description: Returns a query over the visits in the history with
+//              from <= timestamp <= to, oldest first
+// Preconditions: None
+// Postconditions: The query is valid until the history changes
+TimeQuery Browser::QueryBetween(int64_t from, int64_t to) const{return m_times.Between(from, to);}
+
+// Name: QueryBefore
+// Description: Returns a query over the newest count visits in the
+//              history with a timestamp earlier than before, newest first
+// Preconditions: None
+// Postconditions: The query is valid until the history changes
+TimeQuery Browser::QueryBefore(int64_t before, size_t count) const{
+    return m_times.Before(before, count);
+}
+
+// Name: CountVisitsBetween
+// Description: Counts the visits in the history with from <= timestamp <= to
+// Preconditions: None
+// Postconditions: None
+size_t Browser::CountVisitsBetween(int64_t from, int64_t to) const{
+    return m_times.CountBetween(from, to);
+}
+
+// Name: CollectVisitsBetween
+// Description: Sets positions to where each visit with
+//              from <= timestamp <= to is, oldest first, relative to the
+//              current page like VisitInfo's m_position
+// Preconditions: None
+// Postconditions: None
+void Browser::CollectVisitsBetween(int64_t from, int64_t to, vector<long long>& positions) const{
+    vector<size_t> found;
+    m_times.CollectBetween(from, to, found);
+    ToRelative(found, positions);
+}
+
+// Name: FindVisitPositions
+// Description: Sets positions to where every visit to url is, oldest
+//              first, relative to the current page
+// Preconditions: None
+// Postconditions: positions is empty if url is not in the history
+void Browser::FindVisitPositions(string_view url, vector<long long>& positions) const{
+    vector<size_t> found;
+    UrlId id;
+    if (m_urls.Find(url, id)){ //never interned means never visited
+        m_times.FindPositions(id, found);
+    }
+    ToRelative(found, positions);
+}
+
+// Name: CountVisitsByHour
+// Description: Sets hours to HOURS_PER_DAY counts of the visits in the
+//              history in each hour of the day, on a clock utcOffset
+//              milliseconds ahead of UTC
+// Preconditions: None
+// Postconditions: None
+void Browser::CountVisitsByHour(int64_t utcOffset, vector<size_t>& hours) const{
+    m_times.CountByHour(utcOffset, hours);
+}
+
+// Name: Search
+// Description: Autocomplete. Fills results with the best count URLs in the
+//              history whose text, or a label of whose host, starts with
+//              prefix. Ranked by visit count weighted by how recently each
+//              URL was last visited before the newest entry.
+// Preconditions: None
+// Postconditions: results holds at most count suggestions, best first
+void Browser::Search(string_view prefix, size_t count, vector<SearchResult>& results) const{
+    int64_t now = (m_visits.GetSize() == 0) ? 0 : m_visits.GetNewestTimeStamp();
+    m_search.Search(prefix, m_visits, now, count, results);
+}
+
+// Name: GetMetrics
+// Description: Sets snapshot to the process-wide metrics (see Metrics.h)
+//              and this browser's back and forward depths
+// Preconditions: None
+// Postconditions: Counters read 0 when built with -DUSE_METRICS=0
+void Browser::GetMetrics(MetricsSnapshot& snapshot) const{
+    ReadMetrics(snapshot);
+    snapshot.m_backDepth = GetBackSize();
+    snapshot.m_forwardDepth = GetForwardSize();
+}
+
+// Name: GetSharedHistory
+// Description: Sets history to a copy of this browser's history that
+//              can then be forked in constant time (see SharedHistory.h).
+//              Copies each page once, so it takes linear time.
+// Preconditions: None
+// Postconditions: history has the same pages and current page
+void Browser::GetSharedHistory(SharedHistory& history) const{
+    vector<NavigationEntry*> entries;
+    size_t backCount;
+    GetHistory(entries, backCount);
+    history = SharedHistory();
+    for (const NavigationEntry* entry : entries){ //oldest first
+        history.Visit(entry->GetURLView(), entry->GetTimeStamp());
+    }
+    if (!entries.empty()){ //the pages after the current one are forward pages
+        history.Back(static_cast<int>(entries.size() - 1 - backCount));
+    }
+}
+
+// Name: NewEntry
+// Description: Interns url and allocates an entry for it from m_entryPool
+// Preconditions: None
+// Postconditions: Returns the new entry
+NavigationEntry* Browser::NewEntry(string_view url, int64_t timestamp){
+    UrlId id = m_urls.Intern(url); //each distinct URL is stored once
+    return m_entryPool.Allocate(m_urls.Get(id), id, timestamp);
+}
+
+// Name: GetHistory
+// Description: Lists every entry oldest first: m_backStack from the
+//              bottom, m_currentPage, then m_forwardStack from the top
+// Preconditions: None
+// Postconditions: backCount is the number of m_backStack entries
+void Browser::GetHistory(vector<NavigationEntry*>& entries, size_t& backCount) const{
+    entries.clear();
+#if USE_TIMELINE_HISTORY
+    for (size_t i = 0; i < m_timeline.GetSize(); i++){
+        entries.push_back(m_timeline.At(i));
+    }
+    backCount = m_timeline.GetBackSize();
+#else
+    entries.reserve(m_backStack.GetSize() + 1 + m_forwardStack.GetSize());
+    m_backStack.ForEach([&entries](NavigationEntry* entry){ entries.push_back(entry); });
+    reverse(entries.begin(), entries.end()); //ForEach starts at the top
+    backCount = entries.size();
+    if (m_currentPage != nullptr){
+        entries.push_back(m_currentPage);
+    }
+    m_forwardStack.ForEach([&entries](NavigationEntry* entry){ entries.push_back(entry); });
+#endif
+}
+
+// Name: ToRelative
+// Description: Sets relative to each history position in positions (0
+//              being the oldest) less the current page's position
+// Preconditions: None
+// Postconditions: relative is the same size as positions
+void Browser::ToRelative(const vector<size_t>& positions, vector<long long>& relative) const{
+    long long current = static_cast<long long>(GetBackSize()); //back entries sit below the page
+    relative.resize(positions.size());
+    for (size_t i = 0; i < positions.size(); i++){
+        relative[i] = static_cast<long long>(positions[i]) - current;
+    }
+}
+
+// Name: ReadSnapshot
+// Description: Replaces the history with the one saved in fileName and
+//              sets id to the snapshot's id. If the snapshot is
+//              malformed, throws runtime_error and leaves the history
+//              unchanged.
+// Preconditions: None
+// Postconditions: Returns false if the file could not be opened
+bool Browser::ReadSnapshot(const string& fileName, uint64_t& id){
+    MappedFile file;
+    if (!file.Open(fileName)){
+        return false;
+    }
+    vector<HistoryRecord> records; //URLs view the mapped file
+    size_t backCount;
+    string error;
+    if (!DecodeSnapshot(file.GetData(), file.GetSize(), records, backCount, error)){
+        throw runtime_error("Cannot load snapshot " + fileName + ": " + error);
+    }
+    UrlId known = static_cast<UrlId>(m_urls.GetSize());
+    ClearHistory();
+    for (size_t i = 0; i < records.size(); i++){ //oldest first, then step back
+        AppendEntry(NewEntry(records[i].m_url, records[i].m_timeStamp));
+    }
+    if (backCount + 1 < records.size()){ //forward history after the current page
+        MoveBack(static_cast<int>(records.size() - backCount - 1)); //restoring is not a navigation
+    }
+    EnforceHistoryLimit();
+    m_search.Add(known, static_cast<UrlId>(m_urls.GetSize()), m_visits);
+    id = GetSnapshotId(file.GetData(), file.GetSize());
+    return true;
+}
+
+// Name: Replay
+// Description: Applies journal records to the history in order, visits
+//              in batches
+// Preconditions: m_journal is closed, so nothing is logged again
+// Postconditions: None
+void Browser::Replay(const vector<JournalRecord>& records){
+    vector<HistoryRecord> visits;
+    for (size_t i = 0; i <= records.size(); i++){
+        if (i < records.size() && records[i].m_op == JOURNAL_VISIT){
+            visits.push_back({records[i].m_url, records[i].m_timeStamp});
+            continue;
         }
+        VisitBatch(visits.data(), visits.size()); //visits since the last step
+        visits.clear();
+        if (i == records.size()){
+            break;
+        }
+        int steps = static_cast<int>(min<uint64_t>(records[i].m_steps, INT_MAX));
+        if (records[i].m_op == JOURNAL_BACK){
+            Back(steps);
+        } else{
+            Forward(steps);
+        }
+    }
+}
+
+// Name: Log
+// Description: Appends an operation to m_journal if it is open
+// Preconditions: The operation has been applied
+// Postconditions: None
+void Browser::Log(JournalOp op, string_view url, int64_t timestamp, uint64_t steps){
+    if (m_journal.IsOpen()){
+        m_journal.Append({op, url, timestamp, steps});
+    }
+}
+
+// Name: CheckpointIfDue
+// Description: Checkpoints if the journal holds m_checkpointRecords records
+// Preconditions: Every operation so far has been logged
+// Postconditions: None
+void Browser::CheckpointIfDue(){
+    if (m_checkpointRecords != UNLIMITED && m_journal.IsOpen() &&
+        m_journal.GetRecordCount() >= m_checkpointRecords){
+        Checkpoint();
+    }
+}
+
+// Name: ClearHistory
+// Description: Releases every entry and empties the history
+// Preconditions: None
+// Postconditions: m_currentPage is nullptr
+void Browser::ClearHistory(){
+#if USE_TIMELINE_HISTORY
+    for (size_t i = 0; i < m_timeline.GetSize(); i++){
+        m_entryPool.Release(m_timeline.At(i));
+    }
+    m_timeline.Clear();
+#else
+    while (!m_backStack.IsEmpty()){
+        m_entryPool.Release(m_backStack.Pop());
+    }
+    while (!m_forwardStack.IsEmpty()){
+        m_entryPool.Release(m_forwardStack.Pop());
+    }
+    m_entryPool.Release(m_currentPage);
+    m_backBytes = 0;
+#endif
+    m_visits.Clear();
+    m_times.Clear();
+    m_currentPage = nullptr;
+}
+
+// Name: ClearForward
+// Description: Releases every entry in the forward history
+// Preconditions: None
+// Postconditions: Forward history is empty
+void Browser::ClearForward(){
+#if USE_TIMELINE_HISTORY
+    size_t first = m_timeline.GetBackSize() + 1; //first forward entry
+    for (size_t i = first; i < m_timeline.GetSize(); i++){
+        m_entryPool.Release(m_timeline.At(i));
+    }
+    m_timeline.TruncateForward(); //one resize drops them all
+#else
+    while (!m_forwardStack.IsEmpty()){
+        m_entryPool.Release(m_forwardStack.Pop());
+    }
+#endif
+    m_visits.TruncateForward();
+    m_times.Truncate(m_visits.GetSize()); //keep the back history and current page
+}
+
+// Name: MoveBack
+// Description: Moves back steps pages, stopping at the oldest, without
+//              logging or counting the move
+// Preconditions: m_currentPage is not nullptr
+// Postconditions: Returns how many pages it moved
+size_t Browser::MoveBack(int steps){
+#if USE_TIMELINE_HISTORY
+    size_t moved = m_timeline.Back((steps < 0) ? 0 : steps); //only the cursor moves
+    m_currentPage = m_timeline.GetCurrent();
+#else
+    size_t moved = 0;
+    for (int i = 0; i < steps && !m_backStack.IsEmpty(); i++){ //stop at the oldest
+        //set current page into forward stack
+        m_forwardStack.Push(m_currentPage);
+        //set previous page as current
+        m_currentPage = PopHistory();
+        moved++;
+    }
+#endif
+    m_visits.MoveCursor(-static_cast<long long>(moved));
+    return moved;
+}
+
+// Name: AppendEntry
+// Description: Makes entry the current page, moving the old current page
+//              into the back history
+// Preconditions: Forward history is empty
+// Postconditions: m_currentPage is entry
+void Browser::AppendEntry(NavigationEntry* entry){
+#if USE_TIMELINE_HISTORY
+    m_timeline.Push(entry);
+#else
+    if (m_currentPage != nullptr){ //put the current page in backstack
+        PushHistory(m_currentPage);
+    }
+#endif
+    m_times.Append(entry->GetURLId(), entry->GetTimeStamp());
+    m_visits.Append(entry->GetURLId());
+    m_search.Touch(entry->GetURLId(), m_visits); //its score bound may have risen
+    m_currentPage = entry;
+}
+
+// Name: GetBackSize
+// Description: Returns the number of entries in the back history
+// Preconditions: None
+// Postconditions: None
+size_t Browser::GetBackSize() const{
+#if USE_TIMELINE_HISTORY
+    return m_timeline.GetBackSize();
+#else
+    return m_backStack.GetSize();
+#endif
+}
+
+// Name: GetForwardSize
+// Description: Returns the number of entries in the forward history
+// Preconditions: None
+// Postconditions: None
+size_t Browser::GetForwardSize() const{
+#if USE_TIMELINE_HISTORY
+    return m_timeline.GetForwardSize();
+#else
+    return m_forwardStack.GetSize();
+#endif
+}
+
+// Name: GetBackBytes
+// Description: Returns the URL bytes held in the back history
+// Preconditions: None
+// Postconditions: None
+size_t Browser::GetBackBytes() const{
+#if USE_TIMELINE_HISTORY
+    return m_timeline.GetBackBytes();
+#else
+    return m_backBytes;
+#endif
+}
+
+#if !USE_TIMELINE_HISTORY
+
+// Name: PushHistory
+// Description: Pushes an entry on m_backStack and updates the URL byte count
+// Preconditions: entry is not nullptr
+// Postconditions: entry is the top of m_backStack
+void Browser::PushHistory(NavigationEntry* entry){
+    m_backStack.Push(entry);
+    m_backBytes += entry->GetURLView().length();
+}
+
+// Name: PopHistory
+// Description: Pops the top of m_backStack and updates the URL byte count
+// Preconditions: m_backStack is not empty
+// Postconditions: Returns the popped entry
+NavigationEntry* Browser::PopHistory(){
+    NavigationEntry* entry = m_backStack.Pop();
+    m_backBytes -= entry->GetURLView().length();
+    return entry;
+}
+#endif
+
+// Name: EnforceHistoryLimit
+// Description: Evicts and releases entries from the bottom of
+//              m_backStack until both limits are met, then updates the
+//              peak size
+// Preconditions: None
+// Postconditions: m_backStack is within m_maxEntries and m_maxBytes
+void Browser::EnforceHistoryLimit(){
+    while (GetBackSize() > 0 &&
+           ((m_maxEntries != UNLIMITED && GetBackSize() > m_maxEntries) ||
+            (m_maxBytes != UNLIMITED && GetBackBytes() > m_maxBytes))){
+#if USE_TIMELINE_HISTORY
+        NavigationEntry* oldest = m_timeline.RemoveOldest();
+#else
+        NavigationEntry* oldest = m_backStack.RemoveBottom(); //O(1) with RingStack
+        m_backBytes -= oldest->GetURLView().length();
+#endif
+        m_entryPool.Release(oldest); //slot is reused by the next Visit
+        m_visits.RemoveOldest();
+        m_times.RemoveOldest();
+        m_evictions++;
+        CountMetric(METRIC_EVICTIONS);
+    }
+    if (GetBackSize() > m_peakSize){ //new high water mark
+        m_peakSize = GetBackSize();
     }
-    file.close(); 
 }
\ No newline at end of file
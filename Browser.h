@@ -8,20 +8,72 @@
 
 #include <iostream>
 #include <string>
+#include <string_view>
 #include <fstream>
 #include <iomanip> //For timestamps
 #include <chrono> //For timestamps
 #include "Stack.cpp"
+#include "RingStack.cpp"
+#include "Pool.cpp"
+#include "ColumnStack.h"
 #include "NavigationEntry.h"
+#include "UrlTable.h"
+#include "HistoryLoader.h"
+#include "HistorySnapshot.h"
+#include "Timeline.h"
+#include "VisitIndex.h"
+#include "TimeIndex.h"
+#include "UrlSearch.h"
+#include "HistoryWriter.h"
+#include "Journal.h"
+#include "Metrics.h"
+#include "SharedHistory.h"
 
 using namespace std;
 
 //Constants
-const char DELIMITER = ',';
+
+const size_t UNLIMITED = 0; //History limit value meaning "no limit"
+const size_t JOURNAL_CHECKPOINT_RECORDS = 100000; //Journal records that trigger a checkpoint
+const char SNAPSHOT_SUFFIX[] = ".snapshot"; //StartBrowser's snapshot is m_fileName + this
+const char JOURNAL_SUFFIX[] = ".journal"; //StartBrowser's journal is m_fileName + this
+
+//Backend for m_backStack and m_forwardStack. The circular array (RingStack)
+//evicts the oldest entry in constant time. Build with -DUSE_RING_STACK=0 to
+//use the linked list (Stack) instead
+#ifndef USE_RING_STACK
+#define USE_RING_STACK 1
+#endif
+
+#if USE_RING_STACK
+template <typename T>
+using HistoryStack = RingStack<T>;
+#else
+template <typename T>
+using HistoryStack = Stack<T>;
+#endif
+
+//Build with -DUSE_COLUMN_STACK=1 to make m_backStack and m_forwardStack
+//ColumnStacks, which keep each entry's timestamp and URL id in their own
+//arrays. Browser answers time and URL queries from TimeIndex and VisitIndex,
+//so nothing here scans the stacks; the columns only pay off for the stack
+//scans in the benchmark, and HistoryStack stays the default
+#ifndef USE_COLUMN_STACK
+#define USE_COLUMN_STACK 0
+#endif
+
+//History model. By default the back and forward history are two stacks.
+//Build with -DUSE_TIMELINE_HISTORY=1 to keep one Timeline with a cursor
+//instead, so Back(steps) and Forward(steps) only move the cursor
+#ifndef USE_TIMELINE_HISTORY
+#define USE_TIMELINE_HISTORY 0
+#endif
 
 //This class acts like a browser and keeps track of the website you are currently
 //viewing (m_currentPage), the sites you have previously viewed (m_backStack) and
-//the sites you went back from (m_forwardStack).
+//the sites you went back from (m_forwardStack). Every entry is owned by
+//m_entryPool alone; the stacks, m_timeline and m_currentPage only point at
+//entries, so navigating moves pointers and never copies or frees a page.
 class Browser {
  public:
   // Name: Browser (Overloaded constructor)
@@ -31,35 +83,52 @@ class Browser {
   Browser(string filename);
   // Name: ~Browser (Destructor)
   // Description: Deallocates the items in m_backStack, m_forwardStack and
-  //              m_currentPage
+  //              m_currentPage. Entries are trivially destructible, so
+  //              m_entryPool frees them a block at a time (built without
+  //              pools, each entry is released first).
   // Preconditions: None
   // Postconditions: Deallocates all dynamically allocated memory
   ~Browser();
  // Name: StartBrowser
-  // Description: Loads the file and calls the menu
+  // Description: Opens the journal beside the file and calls the menu. The
+  //              first start imports the file; later starts load its
+  //              snapshot and replay the journal tail instead. Menu
+  //              operations arrive one at a time, so each is synced at once.
   // Preconditions: None
   // Postconditions: Menu keeps running until exited
   void StartBrowser();
   // Name: Menu
   // Description: Menu that allows browser history to be displayed, go back,
-  //              go forward, visit a site or quit.
+  //              go forward, visit a site, show the metrics or quit.
   // Preconditions: None
   // Postconditions: When exiting, thanks user.
   void Menu();
   // Name: Visit
-  // Description: Dynamically allocates a new NavigationEntry (NE).
+  // Description: Interns url in m_urls and allocates a new NavigationEntry
+  //              (NE) from m_entryPool. Discards the forward history.
   //              If m_currentPage is nullptr, assigns new NE to the current Page
   //              Otherwise, pushes the currentPage into the history and updates
-  //              m_currentPage to new NE
+  //              m_currentPage to new NE. timestamp is in milliseconds
+  //              since the epoch.
   // Preconditions: None
   // Postconditions: Adds things to m_backStack or m_currentPage
-  void Visit(const string& url, int timestamp);
+  void Visit(string_view url, int64_t timestamp);
+  // Name: VisitBatch
+  // Description: Visits count records in order, ending in the same state as
+  //              calling Visit on each. The forward history is dropped once,
+  //              the back history is reserved up front and new URLs join
+  //              m_search in one merge. With only an entry limit, records
+  //              that would be evicted before the batch ends are interned
+  //              and counted as evictions without allocating an entry.
+  // Preconditions: records points to count records (URLs are copied in)
+  // Postconditions: The last record is m_currentPage
+  void VisitBatch(const HistoryRecord* records, size_t count);
  // Name: NewVisit
   // Description: User enters the URL of the site visited and populates the
   //              timestamp based on the current system time (below)
   //              auto now = chrono::system_clock::now();
-  //              time_t nowAsTimeT = std::chrono::system_clock::to_time_t(now);
-  //              int64_t timestamp = static_cast<int64_t>(nowAsTimeT);
+  //              int64_t timestamp = duration_cast<milliseconds>(
+  //                  now.time_since_epoch()).count();
   // Preconditions: None
   // Postconditions: Adds new URL to m_backStack or m_currentPage
   void NewVisit();
@@ -68,37 +137,348 @@ class Browser {
   // Preconditions: None
   // Postconditions: None
   void Display();
+  // Name: Display (sink)
+  // Description: Writes the same text as Display to sink through a
+  //              HistoryWriter, so large histories go out in big blocks
+  // Preconditions: None
+  // Postconditions: Returns false if writing to sink failed
+  bool Display(OutputSink& sink) const;
+  // Name: Display (writer)
+  // Description: Adds the same text as Display to out without flushing it,
+  //              so it can share a buffer with other output
+  // Preconditions: None
+  // Postconditions: None
+  void Display(HistoryWriter& out) const;
  // Name: Back (steps)
   // Description: Moves item from m_currentPage to m_forwardStack
   //              Moves item from m_backStack to m_currentPage
   //              If m_backStack is empty, does not fail but does nothing.
   //              While can do more than one step, normally only moves one.
+  //              Stops at the oldest page if steps is too large.
+  //              Returns the new current page (an empty entry if nothing
+  //              has been visited) by reference, valid until the history
+  //              changes, so navigating copies nothing.
   // Preconditions: m_backStack must not be empty.
   // Postconditions: Rotates items as above
-  NavigationEntry Back(int steps);
+  const NavigationEntry& Back(int steps);
   // Name: Forward (steps)
   // Description: Moves item from m_backStack to m_currentPage
   //              Moves item from m_currentPage to m_forwardStack
   //              If m_forwardStack is empty, does not fail but does nothing.
   //              While can do more than one step, normally only moves one.
+  //              Stops at the newest page if steps is too large.
+  //              Returns the new current page like Back.
   // Preconditions: m_forwardStack must not be empty
   // Postconditions: Rotates items as above
-  NavigationEntry Forward(int steps);
+  const NavigationEntry& Forward(int steps);
   // Name: GetCurrentPage
-  // Description: Returns the current page
+  // Description: Returns the current page by reference. It stays valid
+  //              until the history changes. Throws runtime_error if
+  //              nothing has been visited.
+  // Preconditions: None
+  // Postconditions: None
+  const NavigationEntry& GetCurrentPage() const;
+  // Name: HasCurrentPage
+  // Description: Returns true if a site has been visited
   // Preconditions: None
   // Postconditions: None
-  NavigationEntry GetCurrentPage() const;
+  bool HasCurrentPage() const;
   // Name: LoadFile
-  // Description: Loads the file using Visit
+  // Description: Maps the file into memory and loads each record using Visit.
+  //              With more than one load thread the file is parsed in
+  //              parallel chunks and visited in file order, giving the same
+  //              result as a sequential load. Malformed records are skipped
+  //              and kept in m_loadErrors.
   // Preconditions: None
   // Postconditions: Adds things to m_backStack or m_currentPage
   void LoadFile();
+  // Name: SetLoadThreads
+  // Description: Sets how many threads LoadFile parses with. 1 parses on the
+  //              calling thread, 0 uses every hardware thread.
+  // Preconditions: None
+  // Postconditions: Later LoadFile calls use the new thread count
+  void SetLoadThreads(unsigned threads);
+  // Name: GetLoadErrors
+  // Description: Returns the malformed records skipped by the last LoadFile
+  // Preconditions: None
+  // Postconditions: None
+  const vector<LoadError>& GetLoadErrors() const;
+  // Name: RunScript
+  // Description: Runs the commands in fileName (COMMAND_STDIN for stdin)
+  //              without the menu, writing their output to cout in large
+  //              blocks. See CommandRunner.h for the commands. With
+  //              pipelined true the script is read and parsed on a second
+  //              thread. Malformed lines are skipped and reported on cerr.
+  // Preconditions: None
+  // Postconditions: Returns false if the script could not be read or the
+  //                 output could not be written
+  bool RunScript(const string& fileName, bool pipelined = false);
+  // Name: SaveSnapshot
+  // Description: Writes m_backStack, m_currentPage and m_forwardStack to
+  //              fileName in the binary snapshot format
+  // Preconditions: None
+  // Postconditions: Returns false if the file could not be written
+  bool SaveSnapshot(const string& fileName) const;
+  // Name: LoadSnapshot
+  // Description: Replaces the history with the one saved in fileName. If
+  //              the snapshot is malformed, throws runtime_error and leaves
+  //              the history unchanged.
+  // Preconditions: None
+  // Postconditions: Returns false if the file could not be opened
+  bool LoadSnapshot(const string& fileName);
+  // Name: OpenJournal
+  // Description: Loads the snapshot in snapshotName and replays the records
+  //              in journalName that follow it, then logs every later
+  //              Visit, Back and Forward to journalName. A journal that
+  //              names a different snapshot is already in it and is
+  //              dropped. Without a readable snapshot, imports m_fileName
+  //              with LoadFile, replays a journal that follows no snapshot
+  //              and checkpoints. Throws runtime_error, leaving the journal
+  //              untouched and closed, if its records cannot be applied:
+  //              its header is malformed or its snapshot is gone.
+  // Preconditions: Nothing else has been loaded
+  // Postconditions: Returns false if the journal or the snapshot could not
+  //                 be written
+  bool OpenJournal(const string& snapshotName, const string& journalName);
+  // Name: Checkpoint
+  // Description: Compacts the journal: saves the history to the snapshot
+  //              and empties the journal. Runs by itself every
+  //              m_checkpointRecords journal records.
+  // Preconditions: None
+  // Postconditions: Returns false if no journal is open or the snapshot
+  //                 could not be written
+  bool Checkpoint();
+  // Name: SetCheckpointInterval
+  // Description: Checkpoints once the journal holds records records
+  //              (UNLIMITED checkpoints only when asked)
+  // Preconditions: None
+  // Postconditions: None
+  void SetCheckpointInterval(size_t records);
+  // Name: SetJournalGroup
+  // Description: Passes the group commit size and delay to m_journal
+  // Preconditions: records is greater than 0
+  // Postconditions: None
+  void SetJournalGroup(size_t records, int64_t delay);
+  // Name: HasJournalFailed
+  // Description: Returns true if recent operations could not be written to
+  //              the journal; they stay buffered and are retried
+  // Preconditions: None
+  // Postconditions: None
+  bool HasJournalFailed() const;
+  // Name: SetHistoryLimit
+  // Description: Caps m_backStack at maxEntries entries and maxBytes bytes of
+  //              URL text (UNLIMITED turns a limit off). Whenever a limit is
+  //              exceeded the oldest entry is evicted from the bottom of
+  //              m_backStack and deallocated.
+  // Preconditions: None
+  // Postconditions: Limits are stored and enforced immediately
+  void SetHistoryLimit(size_t maxEntries, size_t maxBytes = UNLIMITED);
+  // Name: GetEvictionCount
+  // Description: Returns how many entries have been evicted by the limit
+  // Preconditions: None
+  // Postconditions: None
+  size_t GetEvictionCount() const;
+  // Name: GetUrlTable
+  // Description: Returns the table of interned URLs
+  // Preconditions: None
+  // Postconditions: None
+  const UrlTable& GetUrlTable() const;
+  // Name: GetPeakSize
+  // Description: Returns the largest size m_backStack has reached
+  // Preconditions: None
+  // Postconditions: None
+  size_t GetPeakSize() const;
+  // Name: FindVisit
+  // Description: Looks up url in m_visits: how many entries in the history
+  //              have it, when it was first and last visited and how many
+  //              steps back or forward its newest entry is
+  // Preconditions: None
+  // Postconditions: Returns true and fills info if url is in the history
+  bool FindVisit(string_view url, VisitInfo& info) const;
+  // Name: QueryBetween
+  // Description: Returns a query over the visits in the history with
+  //              from <= timestamp <= to, oldest first
+  // Preconditions: None
+  // Postconditions: The query is valid until the history changes
+  TimeQuery QueryBetween(int64_t from, int64_t to) const;
+  // Name: QueryBefore
+  // Description: Returns a query over the newest count visits in the
+  //              history with a timestamp earlier than before, newest first
+  // Preconditions: None
+  // Postconditions: The query is valid until the history changes
+  TimeQuery QueryBefore(int64_t before, size_t count) const;
+  // Name: CountVisitsBetween
+  // Description: Counts the visits in the history with from <= timestamp <= to
+  // Preconditions: None
+  // Postconditions: None
+  size_t CountVisitsBetween(int64_t from, int64_t to) const;
+  // Name: CollectVisitsBetween
+  // Description: Sets positions to where each visit with
+  //              from <= timestamp <= to is, oldest first, relative to the
+  //              current page like VisitInfo's m_position
+  // Preconditions: None
+  // Postconditions: None
+  void CollectVisitsBetween(int64_t from, int64_t to, vector<long long>& positions) const;
+  // Name: FindVisitPositions
+  // Description: Sets positions to where every visit to url is, oldest
+  //              first, relative to the current page
+  // Preconditions: None
+  // Postconditions: positions is empty if url is not in the history
+  void FindVisitPositions(string_view url, vector<long long>& positions) const;
+  // Name: CountVisitsByHour
+  // Description: Sets hours to HOURS_PER_DAY counts of the visits in the
+  //              history in each hour of the day, on a clock utcOffset
+  //              milliseconds ahead of UTC
+  // Preconditions: None
+  // Postconditions: None
+  void CountVisitsByHour(int64_t utcOffset, vector<size_t>& hours) const;
+  // Name: Search
+  // Description: Autocomplete. Fills results with the best count URLs in the
+  //              history whose text, or a label of whose host, starts with
+  //              prefix. Ranked by visit count weighted by how recently each
+  //              URL was last visited before the newest entry.
+  // Preconditions: None
+  // Postconditions: results holds at most count suggestions, best first
+  void Search(string_view prefix, size_t count, vector<SearchResult>& results) const;
+  // Name: GetMetrics
+  // Description: Sets snapshot to the process-wide metrics (see Metrics.h)
+  //              and this browser's back and forward depths
+  // Preconditions: None
+  // Postconditions: Counters read 0 when built with -DUSE_METRICS=0
+  void GetMetrics(MetricsSnapshot& snapshot) const;
+  // Name: GetSharedHistory
+  // Description: Sets history to a copy of this browser's history that
+  //              can then be forked in constant time (see SharedHistory.h).
+  //              Copies each page once, so it takes linear time.
+  // Preconditions: None
+  // Postconditions: history has the same pages and current page
+  void GetSharedHistory(SharedHistory& history) const;
  private:
-  Stack<NavigationEntry*> m_backStack; //History of sites you have already viewed
-  Stack<NavigationEntry*> m_forwardStack; //Sites you viewed but went back from
+  // Name: NewEntry
+  // Description: Interns url and allocates an entry for it from m_entryPool
+  // Preconditions: None
+  // Postconditions: Returns the new entry
+  NavigationEntry* NewEntry(string_view url, int64_t timestamp);
+  // Name: GetHistory
+  // Description: Lists every entry oldest first: m_backStack from the
+  //              bottom, m_currentPage, then m_forwardStack from the top
+  // Preconditions: None
+  // Postconditions: backCount is the number of m_backStack entries
+  void GetHistory(vector<NavigationEntry*>& entries, size_t& backCount) const;
+  // Name: ToRelative
+  // Description: Sets relative to each history position in positions (0
+  //              being the oldest) less the current page's position
+  // Preconditions: None
+  // Postconditions: relative is the same size as positions
+  void ToRelative(const vector<size_t>& positions, vector<long long>& relative) const;
+  // Name: ReadSnapshot
+  // Description: Replaces the history with the one saved in fileName and
+  //              sets id to the snapshot's id. If the snapshot is
+  //              malformed, throws runtime_error and leaves the history
+  //              unchanged.
+  // Preconditions: None
+  // Postconditions: Returns false if the file could not be opened
+  bool ReadSnapshot(const string& fileName, uint64_t& id);
+  // Name: Replay
+  // Description: Applies journal records to the history in order, visits
+  //              in batches
+  // Preconditions: m_journal is closed, so nothing is logged again
+  // Postconditions: None
+  void Replay(const vector<JournalRecord>& records);
+  // Name: Log
+  // Description: Appends an operation to m_journal if it is open
+  // Preconditions: The operation has been applied
+  // Postconditions: None
+  void Log(JournalOp op, string_view url, int64_t timestamp, uint64_t steps);
+  // Name: CheckpointIfDue
+  // Description: Checkpoints if the journal holds m_checkpointRecords records
+  // Preconditions: Every operation so far has been logged
+  // Postconditions: None
+  void CheckpointIfDue();
+  // Name: ClearHistory
+  // Description: Releases every entry and empties the history
+  // Preconditions: None
+  // Postconditions: m_currentPage is nullptr
+  void ClearHistory();
+  // Name: ClearForward
+  // Description: Releases every entry in the forward history
+  // Preconditions: None
+  // Postconditions: Forward history is empty
+  void ClearForward();
+  // Name: MoveBack
+  // Description: Moves back steps pages, stopping at the oldest, without
+  //              logging or counting the move
+  // Preconditions: m_currentPage is not nullptr
+  // Postconditions: Returns how many pages it moved
+  size_t MoveBack(int steps);
+  // Name: AppendEntry
+  // Description: Makes entry the current page, moving the old current page
+  //              into the back history
+  // Preconditions: Forward history is empty
+  // Postconditions: m_currentPage is entry
+  void AppendEntry(NavigationEntry* entry);
+  // Name: GetBackSize
+  // Description: Returns the number of entries in the back history
+  // Preconditions: None
+  // Postconditions: None
+  size_t GetBackSize() const;
+  // Name: GetForwardSize
+  // Description: Returns the number of entries in the forward history
+  // Preconditions: None
+  // Postconditions: None
+  size_t GetForwardSize() const;
+  // Name: GetBackBytes
+  // Description: Returns the URL bytes held in the back history
+  // Preconditions: None
+  // Postconditions: None
+  size_t GetBackBytes() const;
+#if !USE_TIMELINE_HISTORY
+  // Name: PushHistory
+  // Description: Pushes an entry on m_backStack and updates the URL byte count
+  // Preconditions: entry is not nullptr
+  // Postconditions: entry is the top of m_backStack
+  void PushHistory(NavigationEntry* entry);
+  // Name: PopHistory
+  // Description: Pops the top of m_backStack and updates the URL byte count
+  // Preconditions: m_backStack is not empty
+  // Postconditions: Returns the popped entry
+  NavigationEntry* PopHistory();
+#endif
+  // Name: EnforceHistoryLimit
+  // Description: Evicts and releases entries from the bottom of
+  //              m_backStack until both limits are met, then updates the
+  //              peak size
+  // Preconditions: None
+  // Postconditions: m_backStack is within m_maxEntries and m_maxBytes
+  void EnforceHistoryLimit();
+
+  UrlTable m_urls; //Every distinct URL visited, stored once
+  Pool<NavigationEntry> m_entryPool; //Allocates every NavigationEntry the browser owns
+  TimeIndex m_times; //Timestamp of every entry in the history, oldest first
+  VisitIndex m_visits; //Visit count and newest position of every URL in the history
+  UrlSearch m_search; //Autocomplete keys for every URL in m_urls
+#if USE_TIMELINE_HISTORY
+  Timeline m_timeline; //Every site oldest first, with the cursor on m_currentPage
+#elif USE_COLUMN_STACK
+  ColumnStack m_backStack; //History of sites you have already viewed
+  ColumnStack m_forwardStack; //Sites you viewed but went back from
+#else
+  HistoryStack<NavigationEntry*> m_backStack; //History of sites you have already viewed
+  HistoryStack<NavigationEntry*> m_forwardStack; //Sites you viewed but went back from
+#endif
   NavigationEntry* m_currentPage; //Site you are currently viewing
+  const NavigationEntry m_noPage; //What Back and Forward return before any visit
   string m_fileName; //Name of the input file to import browsing history
+  size_t m_maxEntries; //Most entries kept in m_backStack (UNLIMITED for no cap)
+  size_t m_maxBytes; //Most URL bytes kept in m_backStack (UNLIMITED for no cap)
+  size_t m_backBytes; //URL bytes currently held in m_backStack (stack model)
+  size_t m_evictions; //Number of entries evicted by the history limit
+  size_t m_peakSize; //Largest size m_backStack has reached
+  unsigned m_loadThreads; //Threads LoadFile parses with
+  vector<LoadError> m_loadErrors; //Records skipped by the last LoadFile
+  string m_snapshotName; //Snapshot the journal follows
+  size_t m_checkpointRecords; //Journal records that trigger a checkpoint
+  Journal m_journal; //Write-ahead log of operations since the snapshot
 };
 
 #endif
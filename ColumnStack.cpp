@@ -0,0 +1,205 @@
+/*Title: ColumnStack.cpp
+  Author: Shariq Moghees
+  Date: 10/17/2026
+  Description: This class is a stack of history entries that keeps their
+               timestamps and URL ids in separate arrays for fast scans
+*/
+#include "ColumnStack.h"
+#include "Metrics.h"
+#include <algorithm>
+
+// Name: ColumnStack (Default constructor)
+// Description: Creates a new ColumnStack object
+// Preconditions: None
+// Postconditions: Creates a new ColumnStack object with no slots allocated
+ColumnStack::ColumnStack()
+  :m_bottom(0),m_size(0){}
+
+// Name: Push
+// Description: Adds a new entry to the top of the stack. Doubles the slot
+//              arrays when they are full (amortized constant time)
+// Preconditions: entry is not nullptr
+// Postconditions: Adds a new entry to the top of the stack
+void ColumnStack::Push(NavigationEntry* entry){
+  MetricTimer timer(METRIC_PUSH_TIME, METRIC_SAMPLE_EVERY);
+  if (m_size == m_entries.size()){ //no free slot left
+    Grow(m_entries.empty() ? COLUMN_STACK_MIN_CAPACITY : m_entries.size() * 2);
+  }
+  size_t slot = Slot(m_size); //slot above the top
+  m_entries[slot] = entry;
+  m_times[slot] = entry->GetTimeStamp();
+  m_ids[slot] = entry->GetURLId();
+  m_size++;
+  CountMetric(METRIC_PUSHES);
+  PeakMetric(METRIC_PEAK_STACK, m_size);
+}
+
+// Name: Pop
+// Description: If stack is empty, throw runtime_error("Stack is empty");
+//              Removes the entry at the top of the stack and returns it.
+// Preconditions: Stack has at least one entry
+// Postconditions: See description
+NavigationEntry* ColumnStack::Pop(){
+  MetricTimer timer(METRIC_POP_TIME, METRIC_SAMPLE_EVERY);
+  if (m_size == 0){
+    throw runtime_error("Stack is empty");
+  }
+  CountMetric(METRIC_POPS);
+  m_size--; //top slot is now free
+  return m_entries[Slot(m_size)];
+}
+
+// Name: Peek
+// Description: If stack is empty, throw runtime_error("Stack is empty");
+//              Returns the entry at the top of the stack.
+// Preconditions: Stack has at least one entry
+// Postconditions: See description
+NavigationEntry* ColumnStack::Peek() const{
+  if (m_size == 0){
+    throw runtime_error("Stack is empty");
+  }
+  return m_entries[Slot(m_size - 1)];
+}
+
+// Name: At
+// Description: If stack is empty, throw runtime_error("Stack is empty")
+//              Returns the entry num places below the top in constant time.
+// Preconditions: Stack has more than num entries
+// Postconditions: Returns the entry num places below the top
+NavigationEntry* ColumnStack::At(int num) const{
+  if (m_size == 0){ //if empty
+    throw runtime_error("Stack is empty");
+  }
+  if (num < 0 || static_cast<size_t>(num) >= m_size){ //past the bottom
+    throw out_of_range("Stack index out of range");
+  }
+  return m_entries[Slot(m_size - 1 - num)];
+}
+
+// Name: IsEmpty
+// Description: Returns if the stack has any entries.
+// Preconditions: None
+// Postconditions: If stack has no entries, returns true. Else false.
+bool ColumnStack::IsEmpty() const{return m_size == 0;}
+
+// Name: RemoveBottom
+// Description: If stack is empty, throw runtime_error("Stack is empty")
+//              Removes the entry at the bottom of the stack in constant
+//              time and returns it.
+// Preconditions: Stack has at least one entry
+// Postconditions: Removes entry from bottom of stack and returns it
+NavigationEntry* ColumnStack::RemoveBottom(){
+  if (m_size == 0){ //if empty
+    throw runtime_error("Stack is empty");
+  }
+  NavigationEntry* entry = m_entries[m_bottom];
+  m_bottom = (m_bottom + 1) & (m_entries.size() - 1); //next slot is the new bottom
+  m_size--;
+  return entry;
+}
+
+// Name: GetSize
+// Description: Returns the number of entries in the stack
+// Preconditions: None
+// Postconditions: Returns the number of entries in the stack.
+size_t ColumnStack::GetSize() const{return m_size;}
+
+// Name: Reserve
+// Description: Grows the slot arrays so count entries fit without another
+//              reallocation
+// Preconditions: None
+// Postconditions: The capacity is at least count
+void ColumnStack::Reserve(size_t count){
+  if (count <= m_entries.size()){ //already fits
+    return;
+  }
+  size_t newCapacity = COLUMN_STACK_MIN_CAPACITY;
+  while (newCapacity < count){ //keep the capacity a power of 2
+    newCapacity *= 2;
+  }
+  Grow(newCapacity);
+}
+
+// Name: CountBetween
+// Description: Counts the entries with from <= timestamp <= to
+// Preconditions: None
+// Postconditions: Stack is unchanged
+size_t ColumnStack::CountBetween(int64_t from, int64_t to) const{
+  if (m_size == 0 || from > to){
+    return 0;
+  }
+  //one unsigned compare tests both ends: below from wraps past the width.
+  //64-bit compares vectorize on SSE4.2 and later targets
+  uint64_t width = static_cast<uint64_t>(to) - static_cast<uint64_t>(from);
+  size_t count = 0;
+  size_t first = m_bottom;
+  size_t left = m_size;
+  while (left > 0){ //the live slots are at most two runs
+    size_t run = min(left, m_entries.size() - first);
+    const int64_t* times = m_times.data() + first;
+    for (size_t i = 0; i < run; i++){
+      count += (static_cast<uint64_t>(times[i]) - static_cast<uint64_t>(from) <= width);
+    }
+    left -= run;
+    first = 0;
+  }
+  return count;
+}
+
+// Name: FindUrl
+// Description: Finds the entry nearest the top with URL id
+// Preconditions: None
+// Postconditions: Returns false if no entry has id; otherwise sets depth
+//                 to how many places below the top it is
+bool ColumnStack::FindUrl(UrlId id, size_t& depth) const{
+  size_t end = m_size; //entries [0, end) above the bottom are still unscanned
+  while (end > 0){
+    //scan the top-most chunk that stays inside one run of slots
+    size_t top = Slot(end - 1);
+    size_t run = min(min(end, COLUMN_SCAN_CHUNK), top + 1);
+    const UrlId* ids = m_ids.data() + (top + 1 - run);
+    unsigned hit = 0; //a bool here keeps gcc from vectorizing
+    for (size_t i = 0; i < run; i++){ //no early exit, so it vectorizes
+      hit |= (ids[i] == id);
+    }
+    if (hit != 0){
+      for (size_t i = run; i > 0; i--){ //newest first
+        if (ids[i - 1] == id){
+          depth = m_size - end + (run - i);
+          return true;
+        }
+      }
+    }
+    end -= run;
+  }
+  return false;
+}
+
+// Name: Grow
+// Description: Moves the entries into slot arrays of newCapacity slots and
+//              unwraps them so the bottom of the stack sits in slot 0
+// Preconditions: newCapacity is a power of 2 and at least m_size
+// Postconditions: The capacity is newCapacity, m_bottom is 0
+void ColumnStack::Grow(size_t newCapacity){
+  vector<NavigationEntry*> entries(newCapacity);
+  vector<int64_t> times(newCapacity);
+  vector<UrlId> ids(newCapacity);
+  for (size_t i = 0; i < m_size; i++){ //copy bottom to top
+    size_t slot = Slot(i);
+    entries[i] = m_entries[slot];
+    times[i] = m_times[slot];
+    ids[i] = m_ids[slot];
+  }
+  m_entries.swap(entries);
+  m_times.swap(times);
+  m_ids.swap(ids);
+  m_bottom = 0;
+}
+
+// Name: Slot
+// Description: Returns the slot of the entry index places above the bottom
+// Preconditions: index is less than the capacity
+// Postconditions: None
+size_t ColumnStack::Slot(size_t index) const{
+  return (m_bottom + index) & (m_entries.size() - 1);
+}
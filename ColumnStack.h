@@ -0,0 +1,129 @@
+/*Title: ColumnStack.h
+  Author: Shariq Moghees
+  Date: 10/17/2026
+  Description: This class is a stack of history entries that keeps their
+               timestamps and URL ids in separate arrays for fast scans
+*/
+#ifndef COLUMN_STACK_H //Header guards
+#define COLUMN_STACK_H //Header guards
+
+#include <cstddef>
+#include <cstdint>
+#include <stdexcept>
+#include <vector>
+#include "NavigationEntry.h"
+using namespace std;
+
+//Constants
+const size_t COLUMN_STACK_MIN_CAPACITY = 16; //Starting number of slots (power of 2)
+const size_t COLUMN_SCAN_CHUNK = 64; //Slots tested together before looking for the match
+
+//Stack of NavigationEntry* with the same interface as RingStack. It is a
+//circular array like RingStack, but each entry's timestamp and URL id are
+//copied into their own arrays beside the entry pointers. A scan over the
+//timestamps or URL ids then reads at most two contiguous runs of plain
+//integers instead of following a pointer per entry, and its loops have no
+//branches, so the compiler can vectorize them. Does not own the entries.
+class ColumnStack {
+public:
+  // Name: ColumnStack (Default constructor)
+  // Description: Creates a new ColumnStack object
+  // Preconditions: None
+  // Postconditions: Creates a new ColumnStack object with no slots allocated
+  ColumnStack();
+  // Name: Push
+  // Description: Adds a new entry to the top of the stack. Doubles the slot
+  //              arrays when they are full (amortized constant time)
+  // Preconditions: entry is not nullptr
+  // Postconditions: Adds a new entry to the top of the stack
+  void Push(NavigationEntry* entry);
+  // Name: Pop
+  // Description: If stack is empty, throw runtime_error("Stack is empty");
+  //              Removes the entry at the top of the stack and returns it.
+  // Preconditions: Stack has at least one entry
+  // Postconditions: See description
+  NavigationEntry* Pop();
+  // Name: Peek
+  // Description: If stack is empty, throw runtime_error("Stack is empty");
+  //              Returns the entry at the top of the stack.
+  // Preconditions: Stack has at least one entry
+  // Postconditions: See description
+  NavigationEntry* Peek() const;
+  // Name: At
+  // Description: If stack is empty, throw runtime_error("Stack is empty")
+  //              Returns the entry num places below the top in constant time.
+  // Preconditions: Stack has more than num entries
+  // Postconditions: Returns the entry num places below the top
+  NavigationEntry* At(int num) const;
+  // Name: IsEmpty
+  // Description: Returns if the stack has any entries.
+  // Preconditions: None
+  // Postconditions: If stack has no entries, returns true. Else false.
+  bool IsEmpty() const;
+  // Name: RemoveBottom
+  // Description: If stack is empty, throw runtime_error("Stack is empty")
+  //              Removes the entry at the bottom of the stack in constant
+  //              time and returns it.
+  // Preconditions: Stack has at least one entry
+  // Postconditions: Removes entry from bottom of stack and returns it
+  NavigationEntry* RemoveBottom();
+  // Name: ForEach
+  // Description: Calls visit with each entry, starting at the top
+  // Preconditions: None
+  // Postconditions: Stack is unchanged
+  template <typename F>
+  void ForEach(F visit) const;
+  // Name: GetSize
+  // Description: Returns the number of entries in the stack
+  // Preconditions: None
+  // Postconditions: Returns the number of entries in the stack.
+  size_t GetSize() const;
+  // Name: Reserve
+  // Description: Grows the slot arrays so count entries fit without another
+  //              reallocation
+  // Preconditions: None
+  // Postconditions: The capacity is at least count
+  void Reserve(size_t count);
+  // Name: CountBetween
+  // Description: Counts the entries with from <= timestamp <= to
+  // Preconditions: None
+  // Postconditions: Stack is unchanged
+  size_t CountBetween(int64_t from, int64_t to) const;
+  // Name: FindUrl
+  // Description: Finds the entry nearest the top with URL id
+  // Preconditions: None
+  // Postconditions: Returns false if no entry has id; otherwise sets depth
+  //                 to how many places below the top it is
+  bool FindUrl(UrlId id, size_t& depth) const;
+private:
+  // Name: Grow
+  // Description: Moves the entries into slot arrays of newCapacity slots and
+  //              unwraps them so the bottom of the stack sits in slot 0
+  // Preconditions: newCapacity is a power of 2 and at least m_size
+  // Postconditions: The capacity is newCapacity, m_bottom is 0
+  void Grow(size_t newCapacity);
+  // Name: Slot
+  // Description: Returns the slot of the entry index places above the bottom
+  // Preconditions: index is less than the capacity
+  // Postconditions: None
+  size_t Slot(size_t index) const;
+
+  vector<NavigationEntry*> m_entries; //Entry of each slot (size is a power of 2)
+  vector<int64_t> m_times; //Timestamp of each slot's entry
+  vector<UrlId> m_ids; //URL id of each slot's entry
+  size_t m_bottom; //Slot holding the bottom entry of the stack
+  size_t m_size; //Number of entries in stack
+};
+
+// Name: ForEach
+// Description: Calls visit with each entry, starting at the top
+// Preconditions: None
+// Postconditions: Stack is unchanged
+template <typename F>
+void ColumnStack::ForEach(F visit) const{
+  for (size_t i = m_size; i > 0; i--){
+    visit(m_entries[Slot(i - 1)]);
+  }
+}
+
+#endif
@@ -0,0 +1,287 @@
+/*Title: CommandRunner.cpp
+  Author: Shariq Moghees
+  Date: 10/17/2026
+  Description: These classes read a script of browser commands and run it
+               against a Browser without going through the menu
+*/
+#include "CommandRunner.h"
+#include <charconv>
+#include <chrono>
+#include <condition_variable>
+#include <cstring>
+#include <mutex>
+#include <thread>
+
+// Name: CommandParser (Overloaded constructor)
+// Description: Parses [begin, end). baseOffset is added to error offsets
+//              when the range is part of a larger script.
+// Preconditions: begin <= end
+// Postconditions: Creates a parser positioned at begin
+CommandParser::CommandParser(const char* begin, const char* end, size_t baseOffset)
+    :m_begin(begin),m_pos(begin),m_end(end),m_baseOffset(baseOffset){}
+
+// Name: Next
+// Description: Reads the next well-formed command
+// Preconditions: None
+// Postconditions: Returns false once the range is exhausted
+bool CommandParser::Next(Command& command){
+    while (m_pos < m_end){
+        const char* newline = static_cast<const char*>(memchr(m_pos, '\n', m_end - m_pos));
+        const char* lineEnd = (newline == nullptr) ? m_end : newline;
+        const char* start = m_pos;
+        string_view first = NextWord(lineEnd);
+        const char* message = nullptr;
+        if (!first.empty() && first[0] != '#'){ //blank lines and comments are skipped
+            m_pos = start;
+            message = ParseLine(lineEnd, command);
+            if (message == nullptr){
+                m_pos = (newline == nullptr) ? m_end : newline + 1;
+                return true;
+            }
+            m_errors.push_back({m_baseOffset + static_cast<size_t>(start - m_begin), message});
+        }
+        m_pos = (newline == nullptr) ? m_end : newline + 1;
+    }
+    return false;
+}
+
+// Name: GetErrors
+// Description: Returns the lines skipped so far
+// Preconditions: None
+// Postconditions: None
+const vector<LoadError>& CommandParser::GetErrors() const{return m_errors;}
+
+// Name: NextWord
+// Description: Returns the next word on the line ending at lineEnd and
+//              moves past it
+// Preconditions: m_pos <= lineEnd
+// Postconditions: Returns an empty view if the line has no more words
+string_view CommandParser::NextWord(const char* lineEnd){
+    auto space = [](char c){return c == ' ' || c == '\t' || c == '\r';};
+    while (m_pos < lineEnd && space(*m_pos)){
+        m_pos++;
+    }
+    const char* start = m_pos;
+    while (m_pos < lineEnd && !space(*m_pos)){
+        m_pos++;
+    }
+    return string_view(start, m_pos - start);
+}
+
+// Name: ParseLine
+// Description: Parses the line [m_pos, lineEnd) into command
+// Preconditions: The line is not blank or a comment
+// Postconditions: Returns an error message, or nullptr on success
+const char* CommandParser::ParseLine(const char* lineEnd, Command& command){
+    string_view name = NextWord(lineEnd);
+    command.m_url = string_view();
+    command.m_timeStamp = 0;
+    command.m_steps = 0;
+    if (name == "visit"){
+        command.m_type = COMMAND_VISIT;
+        command.m_url = NextWord(lineEnd);
+        if (command.m_url.empty()){
+            return "missing URL";
+        }
+        string_view time = NextWord(lineEnd);
+        if (time.empty()){ //no timestamp means now, like NewVisit
+            command.m_timeStamp = chrono::duration_cast<chrono::milliseconds>(
+                chrono::system_clock::now().time_since_epoch()).count();
+        } else if (!HistoryParser::ParseTimeStamp(time, command.m_timeStamp)){
+            return "invalid timestamp";
+        }
+    } else if (name == "back" || name == "forward"){
+        command.m_type = (name == "back") ? COMMAND_BACK : COMMAND_FORWARD;
+        command.m_steps = 1;
+        string_view steps = NextWord(lineEnd);
+        if (!steps.empty()){
+            auto result = from_chars(steps.data(), steps.data() + steps.size(), command.m_steps);
+            if (result.ec != errc() || result.ptr != steps.data() + steps.size() || command.m_steps < 0){
+                return "invalid step count";
+            }
+        }
+    } else if (name == "display"){
+        command.m_type = COMMAND_DISPLAY;
+    } else if (name == "current"){
+        command.m_type = COMMAND_CURRENT;
+    } else{
+        return "unknown command";
+    }
+    if (!NextWord(lineEnd).empty()){
+        return "too many arguments";
+    }
+    return nullptr;
+}
+
+// Name: CommandRunner (Overloaded constructor)
+// Description: Creates a runner for browser that writes to sink
+// Preconditions: browser and sink outlive the runner
+// Postconditions: Creates a new CommandRunner
+CommandRunner::CommandRunner(Browser& browser, OutputSink& sink)
+    :m_browser(browser),m_out(sink),m_offset(0),m_count(0),m_readFailed(false){}
+
+// Name: Run
+// Description: Runs every command in in until the end of the input
+// Preconditions: in is open for reading
+// Postconditions: Returns false if reading in or writing the sink failed.
+//                 The output has been flushed.
+bool CommandRunner::Run(FILE* in, bool pipelined){
+    if (pipelined){
+        RunPipelined(in);
+    } else{
+        CommandBlock block; //reused, so its buffers are allocated once
+        do{
+            ReadBlock(in, block);
+            Execute(block);
+        } while (!block.m_last);
+    }
+    bool written = m_out.Flush();
+    return written && !m_readFailed;
+}
+
+// Name: GetCommandCount
+// Description: Returns how many commands have been run
+// Preconditions: None
+// Postconditions: None
+size_t CommandRunner::GetCommandCount() const{return m_count;}
+
+// Name: GetErrors
+// Description: Returns the malformed lines skipped so far
+// Preconditions: None
+// Postconditions: None
+const vector<LoadError>& CommandRunner::GetErrors() const{return m_errors;}
+
+// Name: ReadBlock
+// Description: Reads the next block of in and parses it
+// Preconditions: None
+// Postconditions: Sets block.m_last at the end of the input
+void CommandRunner::ReadBlock(FILE* in, CommandBlock& block){
+    block.m_text.swap(m_carry); //starts with the partial line left last time
+    m_carry.clear();
+    block.m_commands.clear();
+    block.m_errors.clear();
+    block.m_last = false;
+    size_t cut;
+    while (true){ //until the block holds a line break or the input ends
+        size_t used = block.m_text.size();
+        block.m_text.resize(used + COMMAND_BLOCK_SIZE);
+        size_t got = fread(&block.m_text[used], 1, COMMAND_BLOCK_SIZE, in);
+        block.m_text.resize(used + got);
+        if (got < COMMAND_BLOCK_SIZE){
+            m_readFailed = m_readFailed || ferror(in);
+            block.m_last = true;
+            cut = block.m_text.size();
+            break;
+        }
+        size_t newline = block.m_text.rfind('\n');
+        if (newline != string::npos){
+            cut = newline + 1;
+            break;
+        }
+    }
+    m_carry.assign(block.m_text, cut, string::npos); //next block finishes the line
+    block.m_text.resize(cut);
+    const char* text = block.m_text.data();
+    CommandParser parser(text, text + block.m_text.size(), m_offset);
+    Command command;
+    while (parser.Next(command)){
+        block.m_commands.push_back(command);
+    }
+    block.m_errors = parser.GetErrors();
+    m_offset += cut;
+}
+
+// Name: Execute
+// Description: Runs the commands of block in order
+// Preconditions: None
+// Postconditions: Adds block's errors to m_errors
+void CommandRunner::Execute(const CommandBlock& block){
+    for (const Command& command : block.m_commands){
+        if (command.m_type == COMMAND_VISIT){ //collect a run of visits for one batch
+            m_visits.push_back({command.m_url, command.m_timeStamp});
+            continue;
+        }
+        if (!m_visits.empty()){
+            m_browser.VisitBatch(m_visits.data(), m_visits.size());
+            m_visits.clear();
+        }
+        switch (command.m_type){
+            case COMMAND_BACK:
+                m_browser.Back(command.m_steps);
+                break;
+            case COMMAND_FORWARD:
+                m_browser.Forward(command.m_steps);
+                break;
+            case COMMAND_DISPLAY:
+                m_browser.Display(m_out);
+                break;
+            case COMMAND_CURRENT:
+                if (m_browser.HasCurrentPage()){
+                    m_out.WriteEntry(m_browser.GetCurrentPage());
+                } else{
+                    m_out.Write("No current page\n");
+                }
+                break;
+            default:
+                break;
+        }
+    }
+    if (!m_visits.empty()){ //the URLs view this block's text
+        m_browser.VisitBatch(m_visits.data(), m_visits.size());
+        m_visits.clear();
+    }
+    m_count += block.m_commands.size();
+    m_errors.insert(m_errors.end(), block.m_errors.begin(), block.m_errors.end());
+}
+
+// Name: RunPipelined
+// Description: Reads and parses on a second thread while this one executes
+// Preconditions: None
+// Postconditions: Every block has been executed
+void CommandRunner::RunPipelined(FILE* in){
+    vector<CommandBlock> blocks(COMMAND_QUEUE_BLOCKS); //never resized, so blocks stay put
+    vector<CommandBlock*> free; //blocks waiting to be read into
+    vector<CommandBlock*> ready; //parsed blocks in script order (oldest first)
+    for (CommandBlock& block : blocks){
+        free.push_back(&block);
+    }
+    mutex lock;
+    condition_variable changed; //a block moved between free and ready
+    thread reader([&](){
+        bool last = false;
+        while (!last){
+            CommandBlock* block;
+            {
+                unique_lock<mutex> hold(lock);
+                changed.wait(hold, [&free](){return !free.empty();});
+                block = free.back();
+                free.pop_back();
+            }
+            ReadBlock(in, *block); //only this thread touches m_carry and m_offset
+            last = block->m_last;
+            {
+                lock_guard<mutex> hold(lock);
+                ready.push_back(block);
+            }
+            changed.notify_all();
+        }
+    });
+    bool last = false;
+    while (!last){
+        CommandBlock* block;
+        {
+            unique_lock<mutex> hold(lock);
+            changed.wait(hold, [&ready](){return !ready.empty();});
+            block = ready.front();
+            ready.erase(ready.begin()); //at most COMMAND_QUEUE_BLOCKS long
+        }
+        Execute(*block);
+        last = block->m_last;
+        {
+            lock_guard<mutex> hold(lock);
+            free.push_back(block);
+        }
+        changed.notify_all();
+    }
+    reader.join(); //the reader stopped after the last block
+}
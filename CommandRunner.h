@@ -0,0 +1,157 @@
+/*Title: CommandRunner.h
+  Author: Shariq Moghees
+  Date: 10/17/2026
+  Description: These classes read a script of browser commands and run it
+               against a Browser without going through the menu
+*/
+#ifndef COMMAND_RUNNER_H //Header guards
+#define COMMAND_RUNNER_H //Header guards
+
+#include <cstddef>
+#include <cstdint>
+#include <cstdio>
+#include <string>
+#include <string_view>
+#include <vector>
+#include "Browser.h"
+using namespace std;
+
+//Script format: one command per line, words separated by spaces or tabs.
+//  visit URL [TS]   TS is seconds with an optional fraction, as in history
+//                   files; without it the visit is at the current time
+//  back [N]         N defaults to 1
+//  forward [N]
+//  display          writes the same text as the menu's Display
+//  current          writes the current page
+//Blank lines and lines starting with # are skipped. Any other line that
+//does not parse is recorded as an error and skipped.
+
+//Constants
+const size_t COMMAND_BLOCK_SIZE = 1024 * 1024; //Bytes of script read at a time
+const size_t COMMAND_QUEUE_BLOCKS = 4; //Blocks the reader thread keeps parsed ahead
+const char COMMAND_STDIN[] = "-"; //Script file name that reads stdin
+
+//What a command does
+enum CommandType {
+  COMMAND_VISIT, //Browser::Visit(m_url, m_timeStamp)
+  COMMAND_BACK, //Browser::Back(m_steps)
+  COMMAND_FORWARD, //Browser::Forward(m_steps)
+  COMMAND_DISPLAY, //Browser::Display
+  COMMAND_CURRENT //Writes Browser::GetCurrentPage
+};
+
+//One parsed command. m_url views the parsed range.
+struct Command {
+  CommandType m_type; //What to do
+  string_view m_url; //URL to visit (visit only)
+  int64_t m_timeStamp; //Milliseconds since the epoch (visit only)
+  int m_steps; //Steps to move (back and forward only)
+};
+
+//Parses commands out of a byte range, one line at a time
+class CommandParser {
+ public:
+  // Name: CommandParser (Overloaded constructor)
+  // Description: Parses [begin, end). baseOffset is added to error offsets
+  //              when the range is part of a larger script.
+  // Preconditions: begin <= end
+  // Postconditions: Creates a parser positioned at begin
+  CommandParser(const char* begin, const char* end, size_t baseOffset = 0);
+  // Name: Next
+  // Description: Reads the next well-formed command
+  // Preconditions: None
+  // Postconditions: Returns false once the range is exhausted
+  bool Next(Command& command);
+  // Name: GetErrors
+  // Description: Returns the lines skipped so far
+  // Preconditions: None
+  // Postconditions: None
+  const vector<LoadError>& GetErrors() const;
+ private:
+  // Name: NextWord
+  // Description: Returns the next word on the line ending at lineEnd and
+  //              moves past it
+  // Preconditions: m_pos <= lineEnd
+  // Postconditions: Returns an empty view if the line has no more words
+  string_view NextWord(const char* lineEnd);
+  // Name: ParseLine
+  // Description: Parses the line [m_pos, lineEnd) into command
+  // Preconditions: The line is not blank or a comment
+  // Postconditions: Returns an error message, or nullptr on success
+  const char* ParseLine(const char* lineEnd, Command& command);
+
+  const char* m_begin; //Start of the range
+  const char* m_pos; //Next unread byte
+  const char* m_end; //One past the last byte
+  size_t m_baseOffset; //Script offset of m_begin
+  vector<LoadError> m_errors; //Lines that were skipped
+};
+
+//Reads a script a block at a time and runs each command on a Browser.
+//Text written by display and current goes through one HistoryWriter, so
+//the sink sees large blocks and nothing is flushed per command. Runs of
+//visits go through VisitBatch. With pipelining a second thread reads and
+//parses the next blocks while this one runs the current block.
+class CommandRunner {
+ public:
+  // Name: CommandRunner (Overloaded constructor)
+  // Description: Creates a runner for browser that writes to sink
+  // Preconditions: browser and sink outlive the runner
+  // Postconditions: Creates a new CommandRunner
+  CommandRunner(Browser& browser, OutputSink& sink);
+  // Name: Run
+  // Description: Runs every command in in until the end of the input
+  // Preconditions: in is open for reading
+  // Postconditions: Returns false if reading in or writing the sink failed.
+  //                 The output has been flushed.
+  bool Run(FILE* in, bool pipelined = false);
+  // Name: GetCommandCount
+  // Description: Returns how many commands have been run
+  // Preconditions: None
+  // Postconditions: None
+  size_t GetCommandCount() const;
+  // Name: GetErrors
+  // Description: Returns the malformed lines skipped so far
+  // Preconditions: None
+  // Postconditions: None
+  const vector<LoadError>& GetErrors() const;
+
+  CommandRunner(const CommandRunner&) = delete; //Holds references
+  CommandRunner& operator=(const CommandRunner&) = delete;
+ private:
+  //A piece of the script that ends at a line break, with its commands. The
+  //commands view m_text, so a block is reused in place and never moved.
+  struct CommandBlock {
+    string m_text; //Script text
+    vector<Command> m_commands; //Commands parsed from m_text
+    vector<LoadError> m_errors; //Lines of m_text that were skipped
+    bool m_last; //Nothing follows this block
+  };
+
+  // Name: ReadBlock
+  // Description: Reads the next block of in and parses it
+  // Preconditions: None
+  // Postconditions: Sets block.m_last at the end of the input
+  void ReadBlock(FILE* in, CommandBlock& block);
+  // Name: Execute
+  // Description: Runs the commands of block in order
+  // Preconditions: None
+  // Postconditions: Adds block's errors to m_errors
+  void Execute(const CommandBlock& block);
+  // Name: RunPipelined
+  // Description: Reads and parses on a second thread while this one executes
+  // Preconditions: None
+  // Postconditions: Every block has been executed
+  void RunPipelined(FILE* in);
+
+  Browser& m_browser; //Browser the commands run on
+  HistoryWriter m_out; //Buffers the output of display and current
+  vector<HistoryRecord> m_visits; //Consecutive visits waiting for VisitBatch
+  string m_carry; //Partial line read after the last block's line break
+  size_t m_offset; //Script offset of the next block
+  size_t m_count; //Commands run
+  vector<LoadError> m_errors; //Malformed lines skipped
+  bool m_readFailed; //Reading the input failed
+};
+
+#endif
@@ -0,0 +1,402 @@
+/*Title: ConcurrentStack.cpp
+  Author: Shariq Moghees
+  Date: 10/17/2026
+  Description: This class defines a templated lock-free stack (Treiber stack)
+               that many threads can push to and pop from at once. Nodes come
+               from a pool of blocks and are reused, never freed, while the
+               stack exists.
+*/
+#ifndef CONCURRENT_STACK_CPP //Header guards
+#define CONCURRENT_STACK_CPP //Header guards
+
+#include <atomic>
+#include <cstdint>
+#include <cstring>
+#include <stdexcept>
+#include <type_traits>
+using namespace std;
+
+//Constants
+const uint32_t CONCURRENT_STACK_FIRST_BLOCK = 64; //Nodes in the first pool block
+const int CONCURRENT_STACK_MAX_BLOCKS = 32; //Each block doubles, so 32 covers every index
+const uint32_t CONCURRENT_STACK_NIL = UINT32_MAX; //Index meaning "no node"
+
+//**********ConcurrentStack Class Declaration***********
+//The top of the stack is one 64-bit word: a node index in the low half and
+//a tag in the high half that changes on every successful push or pop. A
+//thread that read an old top fails its compare-and-swap even if the same
+//node is back on top (the ABA problem), so a plain 64-bit CAS is enough.
+//Popped nodes go on a free list built the same way and are reused by later
+//pushes. Because nodes are never freed, a stale thread can always read a
+//node safely; the tag check throws its result away. Items are stored as
+//relaxed atomic 64-bit words, so TryPeek reading a node that a Push is
+//rewriting is a stale read, not a data race (a seqlock with the top as
+//its sequence).
+template <typename T> //Indicates concurrent stack is templated
+class ConcurrentStack {
+public:
+  // Name: ConcurrentStack (Default constructor)
+  // Description: Creates a new ConcurrentStack object
+  // Preconditions: None
+  // Postconditions: Creates an empty stack with no pool blocks allocated
+  ConcurrentStack();
+  // Name: ~ConcurrentStack
+  // Description: Deallocates every pool block
+  // Preconditions: No other thread is using the stack
+  // Postconditions: All blocks are deleted. No memory leaks.
+  ~ConcurrentStack();
+  // Name: Push
+  // Description: Adds a new item to the top of the stack. Safe to call
+  //              from any number of threads.
+  // Preconditions: None
+  // Postconditions: Adds a new item to the top of the stack
+  void Push(const T& value);
+  // Name: TryPop
+  // Description: Removes the item at the top of the stack into value
+  // Preconditions: None
+  // Postconditions: Returns false if the stack was empty
+  bool TryPop(T& value);
+  // Name: Pop
+  // Description: If stack is empty, throw runtime_error("Stack is empty.");
+  //              Removes the item at the top of the stack and returns it.
+  // Preconditions: Stack has at least one item
+  // Postconditions: See description
+  T Pop();
+  // Name: TryPeek
+  // Description: Copies the item at the top of the stack into value. Safe
+  //              to call while other threads push and pop.
+  // Preconditions: None
+  // Postconditions: Returns false if the stack was empty
+  bool TryPeek(T& value) const;
+  // Name: Peek
+  // Description: If stack is empty, throw runtime_error("Stack is empty");
+  //              Returns the item at the top of the stack.
+  // Preconditions: Stack has at least one item
+  // Postconditions: See description
+  T Peek() const;
+  // Name: IsEmpty
+  // Description: Returns if the stack has any items at the moment of the call
+  // Preconditions: None
+  // Postconditions: If stack has no items, returns true. Else false.
+  bool IsEmpty() const;
+  // Name: GetSize
+  // Description: Returns the number of items in the stack. Exact once
+  //              other threads stop pushing and popping.
+  // Preconditions: None
+  // Postconditions: Returns the number of items in the stack.
+  size_t GetSize() const;
+private:
+  static_assert(is_trivially_copyable<T>::value,
+                "Items are copied word by word");
+
+  static const size_t WORDS = (sizeof(T) + sizeof(uint64_t) - 1) / sizeof(uint64_t); //Words per item
+
+  //One pooled node. Both fields are atomic because a thread holding a
+  //stale top may read them while the node is reused.
+  struct Node {
+    atomic<uint64_t> m_data[WORDS]; //Item stored in the node
+    atomic<uint32_t> m_next; //Index of the node below (or on the free list)
+  };
+
+  ConcurrentStack(const ConcurrentStack&) = delete; //Shared by threads, not copied
+  ConcurrentStack& operator=(const ConcurrentStack&) = delete;
+
+  // Name: GetNode
+  // Description: Returns the node with the given pool index
+  // Preconditions: index was handed out by NewNode
+  // Postconditions: None
+  Node& GetNode(uint32_t index) const;
+  // Name: NewNode
+  // Description: Takes a node from the free list, or a fresh one from the
+  //              pool, allocating its block if no thread has yet
+  // Preconditions: None
+  // Postconditions: Returns the index of a node owned by the caller
+  uint32_t NewNode();
+  // Name: PushIndex
+  // Description: Pushes a node the caller owns onto the list headed by head
+  // Preconditions: The caller owns node index
+  // Postconditions: index is the top of the list
+  void PushIndex(atomic<uint64_t>& head, uint32_t index);
+  // Name: PopIndex
+  // Description: Pops the top node of the list headed by head
+  // Preconditions: None
+  // Postconditions: Returns CONCURRENT_STACK_NIL if the list was empty,
+  //                 otherwise the caller owns the returned node
+  uint32_t PopIndex(atomic<uint64_t>& head);
+  // Name: Store
+  // Description: Copies value into node's words
+  // Preconditions: The caller owns node
+  // Postconditions: None
+  static void Store(Node& node, const T& value);
+  // Name: Load
+  // Description: Copies node's words into value. The copy may be torn if
+  //              another thread is storing into node.
+  // Preconditions: None
+  // Postconditions: None
+  static void Load(const Node& node, T& value);
+  // Name: GetBlock
+  // Description: Splits a pool index into its block and offset. Block b
+  //              holds CONCURRENT_STACK_FIRST_BLOCK << b nodes.
+  // Preconditions: None
+  // Postconditions: Returns the block and sets offset
+  static int GetBlock(uint32_t index, uint32_t& offset);
+
+  atomic<uint64_t> m_top; //Tag and index of the top node
+  atomic<uint64_t> m_free; //Tag and index of the first free node
+  atomic<uint32_t> m_nextFresh; //Next pool index never handed out
+  atomic<size_t> m_size; //Number of items in stack
+  atomic<Node*> m_blocks[CONCURRENT_STACK_MAX_BLOCKS]; //Pool blocks (nullptr until used)
+};
+
+//*********************CONCURRENTSTACK FUNCTIONS IMPLEMENTED HERE******************
+
+// Name: ConcurrentStack (Default constructor)
+// Description: Creates a new ConcurrentStack object
+// Preconditions: None
+// Postconditions: Creates an empty stack with no pool blocks allocated
+template <typename T>
+ConcurrentStack<T>::ConcurrentStack()
+  :m_top(CONCURRENT_STACK_NIL),m_free(CONCURRENT_STACK_NIL),m_nextFresh(0),m_size(0){
+  for (int i = 0; i < CONCURRENT_STACK_MAX_BLOCKS; i++){
+    m_blocks[i].store(nullptr, memory_order_relaxed);
+  }
+}
+
+// Name: ~ConcurrentStack
+// Description: Deallocates every pool block
+// Preconditions: No other thread is using the stack
+// Postconditions: All blocks are deleted. No memory leaks.
+template <typename T>
+ConcurrentStack<T>::~ConcurrentStack(){
+  for (int i = 0; i < CONCURRENT_STACK_MAX_BLOCKS; i++){
+    delete[] m_blocks[i].load(memory_order_relaxed);
+  }
+}
+
+// Name: Push
+// Description: Adds a new item to the top of the stack. Safe to call
+//              from any number of threads.
+// Preconditions: None
+// Postconditions: Adds a new item to the top of the stack
+template <typename T>
+void ConcurrentStack<T>::Push(const T& value){
+  uint32_t index = NewNode();
+  //a TryPeek that reads any word stored below also sees the top change
+  //that freed the node, so it retries
+  atomic_thread_fence(memory_order_release);
+  Store(GetNode(index), value); //published by the release CAS in PushIndex
+  PushIndex(m_top, index);
+  m_size.fetch_add(1, memory_order_relaxed);
+}
+
+// Name: TryPop
+// Description: Removes the item at the top of the stack into value
+// Preconditions: None
+// Postconditions: Returns false if the stack was empty
+template <typename T>
+bool ConcurrentStack<T>::TryPop(T& value){
+  uint32_t index = PopIndex(m_top);
+  if (index == CONCURRENT_STACK_NIL){
+    return false;
+  }
+  Load(GetNode(index), value); //node is ours until it is freed
+  PushIndex(m_free, index);
+  m_size.fetch_sub(1, memory_order_relaxed);
+  return true;
+}
+
+// Name: Pop
+// Description: If stack is empty, throw runtime_error("Stack is empty.");
+//              Removes the item at the top of the stack and returns it.
+// Preconditions: Stack has at least one item
+// Postconditions: See description
+template <typename T>
+T ConcurrentStack<T>::Pop(){
+  T value;
+  if (!TryPop(value)){
+    throw runtime_error("Stack is empty.");
+  }
+  return value;
+}
+
+// Name: TryPeek
+// Description: Copies the item at the top of the stack into value. Safe
+//              to call while other threads push and pop.
+// Preconditions: None
+// Postconditions: Returns false if the stack was empty
+template <typename T>
+bool ConcurrentStack<T>::TryPeek(T& value) const{
+  uint64_t top = m_top.load(memory_order_acquire);
+  while (true){
+    uint32_t index = static_cast<uint32_t>(top);
+    if (index == CONCURRENT_STACK_NIL){
+      return false;
+    }
+    T copy;
+    Load(GetNode(index), copy); //may be torn by a Push reusing the node
+    //if the tag is unchanged the node was still on top while we copied it
+    atomic_thread_fence(memory_order_acquire);
+    uint64_t again = m_top.load(memory_order_relaxed);
+    if (again == top){
+      value = copy;
+      return true;
+    }
+    top = again;
+  }
+}
+
+// Name: Peek
+// Description: If stack is empty, throw runtime_error("Stack is empty");
+//              Returns the item at the top of the stack.
+// Preconditions: Stack has at least one item
+// Postconditions: See description
+template <typename T>
+T ConcurrentStack<T>::Peek() const{
+  T value;
+  if (!TryPeek(value)){
+    throw runtime_error("Stack is empty");
+  }
+  return value;
+}
+
+// Name: IsEmpty
+// Description: Returns if the stack has any items at the moment of the call
+// Preconditions: None
+// Postconditions: If stack has no items, returns true. Else false.
+template <typename T>
+bool ConcurrentStack<T>::IsEmpty() const{
+  return static_cast<uint32_t>(m_top.load(memory_order_acquire)) == CONCURRENT_STACK_NIL;
+}
+
+// Name: GetSize
+// Description: Returns the number of items in the stack. Exact once
+//              other threads stop pushing and popping.
+// Preconditions: None
+// Postconditions: Returns the number of items in the stack.
+template <typename T>
+size_t ConcurrentStack<T>::GetSize() const{return m_size.load(memory_order_relaxed);}
+
+// Name: GetNode
+// Description: Returns the node with the given pool index
+// Preconditions: index was handed out by NewNode
+// Postconditions: None
+template <typename T>
+typename ConcurrentStack<T>::Node& ConcurrentStack<T>::GetNode(uint32_t index) const{
+  uint32_t offset;
+  int block = GetBlock(index, offset);
+  return m_blocks[block].load(memory_order_acquire)[offset];
+}
+
+// Name: NewNode
+// Description: Takes a node from the free list, or a fresh one from the
+//              pool, allocating its block if no thread has yet
+// Preconditions: None
+// Postconditions: Returns the index of a node owned by the caller
+template <typename T>
+uint32_t ConcurrentStack<T>::NewNode(){
+  uint32_t index = PopIndex(m_free);
+  if (index != CONCURRENT_STACK_NIL){ //reuse a popped node
+    return index;
+  }
+  index = m_nextFresh.fetch_add(1, memory_order_relaxed);
+  if (index == CONCURRENT_STACK_NIL){
+    throw length_error("ConcurrentStack pool is full");
+  }
+  uint32_t offset;
+  int block = GetBlock(index, offset);
+  if (m_blocks[block].load(memory_order_acquire) == nullptr){
+    //several threads may race to allocate the block; one install wins
+    Node* fresh = new Node[static_cast<size_t>(CONCURRENT_STACK_FIRST_BLOCK) << block];
+    Node* expected = nullptr;
+    if (!m_blocks[block].compare_exchange_strong(expected, fresh, memory_order_acq_rel)){
+      delete[] fresh;
+    }
+  }
+  return index;
+}
+
+// Name: PushIndex
+// Description: Pushes a node the caller owns onto the list headed by head
+// Preconditions: The caller owns node index
+// Postconditions: index is the top of the list
+template <typename T>
+void ConcurrentStack<T>::PushIndex(atomic<uint64_t>& head, uint32_t index){
+  Node& node = GetNode(index);
+  uint64_t top = head.load(memory_order_relaxed);
+  uint64_t next;
+  do{
+    node.m_next.store(static_cast<uint32_t>(top), memory_order_relaxed);
+    next = ((top >> 32) + 1) << 32 | index; //new tag, new index
+  } while (!head.compare_exchange_weak(top, next, memory_order_release, memory_order_relaxed));
+}
+
+// Name: PopIndex
+// Description: Pops the top node of the list headed by head
+// Preconditions: None
+// Postconditions: Returns CONCURRENT_STACK_NIL if the list was empty,
+//                 otherwise the caller owns the returned node
+template <typename T>
+uint32_t ConcurrentStack<T>::PopIndex(atomic<uint64_t>& head){
+  uint64_t top = head.load(memory_order_acquire);
+  uint64_t next;
+  do{
+    uint32_t index = static_cast<uint32_t>(top);
+    if (index == CONCURRENT_STACK_NIL){
+      return CONCURRENT_STACK_NIL;
+    }
+    //may be stale if another thread popped index first; the CAS then fails
+    uint32_t below = GetNode(index).m_next.load(memory_order_relaxed);
+    next = ((top >> 32) + 1) << 32 | below;
+  } while (!head.compare_exchange_weak(top, next, memory_order_acquire, memory_order_acquire));
+  return static_cast<uint32_t>(top);
+}
+
+// Name: Store
+// Description: Copies value into node's words
+// Preconditions: The caller owns node
+// Postconditions: None
+template <typename T>
+void ConcurrentStack<T>::Store(Node& node, const T& value){
+  uint64_t words[WORDS] = {};
+  memcpy(words, &value, sizeof(T));
+  for (size_t i = 0; i < WORDS; i++){
+    node.m_data[i].store(words[i], memory_order_relaxed);
+  }
+}
+
+// Name: Load
+// Description: Copies node's words into value. The copy may be torn if
+//              another thread is storing into node.
+// Preconditions: None
+// Postconditions: None
+template <typename T>
+void ConcurrentStack<T>::Load(const Node& node, T& value){
+  uint64_t words[WORDS];
+  for (size_t i = 0; i < WORDS; i++){
+    words[i] = node.m_data[i].load(memory_order_relaxed);
+  }
+  memcpy(&value, words, sizeof(T));
+}
+
+// Name: GetBlock
+// Description: Splits a pool index into its block and offset. Block b
+//              holds CONCURRENT_STACK_FIRST_BLOCK << b nodes.
+// Preconditions: None
+// Postconditions: Returns the block and sets offset
+template <typename T>
+int ConcurrentStack<T>::GetBlock(uint32_t index, uint32_t& offset){
+  //block b starts at FIRST * (2^b - 1), so b is the top bit of index / FIRST + 1
+  uint64_t scaled = static_cast<uint64_t>(index) / CONCURRENT_STACK_FIRST_BLOCK + 1;
+  int block = 0;
+#if defined(__GNUC__)
+  block = 63 - __builtin_clzll(scaled);
+#else
+  while ((scaled >> (block + 1)) != 0){
+    block++;
+  }
+#endif
+  offset = static_cast<uint32_t>(index - CONCURRENT_STACK_FIRST_BLOCK * ((uint64_t(1) << block) - 1));
+  return block;
+}
+
+#endif
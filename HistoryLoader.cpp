@@ -0,0 +1,308 @@
+/*Title: HistoryLoader.cpp
+  Author: Shariq Moghees
+  Date: 10/17/2026
+  Description: These classes map a history file into memory and parse its
+               url,timestamp records without copying them
+*/
+#include "HistoryLoader.h"
+#include "TimeFormatter.h"
+#include <atomic>
+#include <charconv>
+#include <climits>
+#include <cstring>
+#include <fstream>
+#include <thread>
+
+#if defined(__unix__) || defined(__APPLE__)
+#define HISTORY_LOADER_MMAP 1
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#else
+#define HISTORY_LOADER_MMAP 0
+#endif
+
+#if defined(__SSE2__)
+#include <emmintrin.h>
+#endif
+
+//Constants
+const unsigned CHUNKS_PER_THREAD = 4; //Extra chunks so fast threads pick up slack
+const size_t MIN_CHUNK_BYTES = 64 * 1024; //Smaller ranges are not worth a chunk
+
+// Name: MappedFile (Default constructor)
+// Description: Creates a MappedFile with nothing open
+// Preconditions: None
+// Postconditions: GetSize() is 0
+MappedFile::MappedFile()
+    :m_data(nullptr),m_size(0),m_mapped(false){}
+
+// Name: ~MappedFile
+// Description: Unmaps the file
+// Preconditions: None
+// Postconditions: Calls Close()
+MappedFile::~MappedFile(){Close();}
+
+// Name: Open
+// Description: Maps fileName into memory (closing any open file first)
+// Preconditions: None
+// Postconditions: Returns false if the file could not be opened
+bool MappedFile::Open(const string& fileName){
+    Close();
+#if HISTORY_LOADER_MMAP
+    int fd = open(fileName.c_str(), O_RDONLY);
+    if (fd < 0){
+        return false;
+    }
+    struct stat info;
+    if (fstat(fd, &info) != 0){
+        close(fd);
+        return false;
+    }
+    m_size = static_cast<size_t>(info.st_size);
+    if (m_size > 0){ //mmap rejects zero-length mappings
+        void* data = mmap(nullptr, m_size, PROT_READ, MAP_PRIVATE, fd, 0);
+        if (data == MAP_FAILED){
+            close(fd);
+            m_size = 0;
+            return false;
+        }
+        madvise(data, m_size, MADV_SEQUENTIAL); //parser reads front to back
+        m_data = static_cast<const char*>(data);
+        m_mapped = true;
+    }
+    close(fd); //the mapping stays valid after the descriptor is closed
+    return true;
+#else
+    ifstream file(fileName, ios::binary | ios::ate);
+    if (!file.is_open()){
+        return false;
+    }
+    m_buffer.resize(static_cast<size_t>(file.tellg()));
+    file.seekg(0);
+    file.read(m_buffer.data(), m_buffer.size());
+    m_data = m_buffer.data();
+    m_size = m_buffer.size();
+    return true;
+#endif
+}
+
+// Name: Close
+// Description: Unmaps the file and releases any buffer
+// Preconditions: None
+// Postconditions: GetSize() is 0
+void MappedFile::Close(){
+#if HISTORY_LOADER_MMAP
+    if (m_mapped){
+        munmap(const_cast<char*>(m_data), m_size);
+    }
+#endif
+    m_buffer.clear();
+    m_data = nullptr;
+    m_size = 0;
+    m_mapped = false;
+}
+
+// Name: GetData
+// Description: Returns the first byte of the file
+// Preconditions: None
+// Postconditions: None
+const char* MappedFile::GetData() const{return m_data;}
+
+// Name: GetSize
+// Description: Returns the size of the file in bytes
+// Preconditions: None
+// Postconditions: None
+size_t MappedFile::GetSize() const{return m_size;}
+
+// Name: HistoryParser (Overloaded constructor)
+// Description: Parses [begin, end). baseOffset is added to error offsets
+//              when the range is part of a larger file.
+// Preconditions: begin <= end
+// Postconditions: Creates a parser positioned at begin
+HistoryParser::HistoryParser(const char* begin, const char* end, size_t baseOffset)
+    :m_begin(begin),m_pos(begin),m_end(end),m_baseOffset(baseOffset){}
+
+// Name: Next
+// Description: Reads the next well-formed record
+// Preconditions: None
+// Postconditions: Returns false once the range is exhausted
+bool HistoryParser::Next(string_view& url, int64_t& timestamp){
+    while (m_pos < m_end){
+        //skip blank fields left by trailing delimiters and empty lines
+        char c = *m_pos;
+        if (c == DELIMITER || c == '\n' || c == '\r' || c == ' ' || c == '\t'){
+            m_pos++;
+            continue;
+        }
+        const char* start = m_pos;
+        bool endsLine = false;
+        url = NextField(endsLine);
+        if (endsLine){ //url with no timestamp after it
+            AddError(start, "missing timestamp");
+            continue;
+        }
+        string_view field = NextField(endsLine);
+        if (!ParseTimeStamp(field, timestamp)){
+            AddError(start, "invalid timestamp");
+            if (!endsLine){
+                SkipLine(); //resynchronize on the next line
+            }
+            continue;
+        }
+        return true;
+    }
+    return false;
+}
+
+// Name: GetErrors
+// Description: Returns the records skipped so far
+// Preconditions: None
+// Postconditions: None
+const vector<LoadError>& HistoryParser::GetErrors() const{return m_errors;}
+
+// Name: NextField
+// Description: Returns the next field (without its separator) and moves
+//              past the separator
+// Preconditions: m_pos < m_end
+// Postconditions: Sets endsLine if the field ended at a newline or the end
+string_view HistoryParser::NextField(bool& endsLine){
+    const char* start = m_pos;
+    const char* stop = FindSeparator(m_pos, m_end);
+    endsLine = (stop == m_end || *stop == '\n');
+    m_pos = (stop == m_end) ? m_end : stop + 1;
+    while (start < stop && (*start == ' ' || *start == '\t')){
+        start++; //drop leading whitespace
+    }
+    while (stop > start && (stop[-1] == '\r' || stop[-1] == ' ' || stop[-1] == '\t')){
+        stop--; //drop trailing whitespace and Windows line endings
+    }
+    return string_view(start, stop - start);
+}
+
+// Name: SkipLine
+// Description: Moves m_pos past the next newline
+// Preconditions: None
+// Postconditions: m_pos is at the start of a line or at m_end
+void HistoryParser::SkipLine(){
+    const void* newline = memchr(m_pos, '\n', m_end - m_pos);
+    m_pos = (newline == nullptr) ? m_end : static_cast<const char*>(newline) + 1;
+}
+
+// Name: AddError
+// Description: Records a malformed record starting at start
+// Preconditions: start is inside the range
+// Postconditions: Appends to m_errors
+void HistoryParser::AddError(const char* start, const char* message){
+    m_errors.push_back(LoadError{m_baseOffset + static_cast<size_t>(start - m_begin), message});
+}
+
+// Name: ParseTimeStamp
+// Description: Converts seconds with an optional fraction to milliseconds
+// Preconditions: None
+// Postconditions: Returns false if field is not a timestamp
+bool HistoryParser::ParseTimeStamp(string_view field, int64_t& timestamp){
+    const char* pos = field.data();
+    const char* last = pos + field.size();
+    int64_t seconds;
+    auto result = from_chars(pos, last, seconds);
+    if (result.ec != errc() || seconds >= INT64_MAX / MS_PER_SECOND ||
+        seconds <= INT64_MIN / MS_PER_SECOND){
+        return false;
+    }
+    int64_t milliseconds = 0;
+    pos = result.ptr;
+    if (pos != last && *pos == '.'){
+        pos++;
+        if (pos == last){ //"12." has no fraction
+            return false;
+        }
+        for (int scale = 100; pos != last && *pos >= '0' && *pos <= '9'; pos++, scale /= 10){
+            milliseconds += (*pos - '0') * scale; //scale reaches 0 past the millisecond
+        }
+    }
+    if (pos != last){
+        return false;
+    }
+    bool negative = (field[0] == '-');
+    timestamp = seconds * MS_PER_SECOND + (negative ? -milliseconds : milliseconds);
+    return true;
+}
+
+// Name: ParseChunks
+// Description: Splits [begin, end) at newlines into record-aligned chunks and
+//              parses them on threadCount threads. Concatenating the chunks
+//              in order gives the same records and errors as one
+//              HistoryParser over the whole range.
+// Preconditions: begin <= end, threadCount is at least 1
+// Postconditions: chunks holds the parsed chunks in file order
+void ParseChunks(const char* begin, const char* end, unsigned threadCount,
+                 vector<HistoryChunk>& chunks){
+    //cut the range into pieces that each start at the beginning of a line
+    size_t size = end - begin;
+    size_t target = size / (threadCount * CHUNKS_PER_THREAD);
+    if (target < MIN_CHUNK_BYTES){
+        target = MIN_CHUNK_BYTES;
+    }
+    vector<const char*> bounds(1, begin);
+    while (end - bounds.back() > static_cast<ptrdiff_t>(target)){
+        const char* cut = bounds.back() + target;
+        const void* newline = memchr(cut, '\n', end - cut);
+        if (newline == nullptr){ //no later line to start a chunk on
+            break;
+        }
+        bounds.push_back(static_cast<const char*>(newline) + 1);
+    }
+    bounds.push_back(end);
+
+    //threads take the next unparsed chunk until none are left
+    chunks.clear();
+    chunks.resize(bounds.size() - 1);
+    atomic<size_t> nextChunk(0);
+    auto worker = [&](){
+        size_t i;
+        while ((i = nextChunk.fetch_add(1, memory_order_relaxed)) < chunks.size()){
+            HistoryParser parser(bounds[i], bounds[i + 1], bounds[i] - begin);
+            HistoryRecord record;
+            while (parser.Next(record.m_url, record.m_timeStamp)){
+                chunks[i].m_records.push_back(record);
+            }
+            chunks[i].m_errors = parser.GetErrors();
+        }
+    };
+    vector<thread> threads;
+    for (unsigned i = 1; i < threadCount && i < chunks.size(); i++){
+        threads.emplace_back(worker);
+    }
+    worker(); //this thread parses too
+    for (size_t i = 0; i < threads.size(); i++){
+        threads[i].join();
+    }
+}
+
+// Name: FindSeparator
+// Description: Returns the first DELIMITER or newline in [pos, end), or end.
+//              Scans 16 bytes at a time with SSE2 where available.
+// Preconditions: pos <= end
+// Postconditions: None
+const char* FindSeparator(const char* pos, const char* end){
+#if defined(__SSE2__)
+    const __m128i delimiter = _mm_set1_epi8(DELIMITER);
+    const __m128i newline = _mm_set1_epi8('\n');
+    while (end - pos >= 16){
+        __m128i bytes = _mm_loadu_si128(reinterpret_cast<const __m128i*>(pos));
+        __m128i hits = _mm_or_si128(_mm_cmpeq_epi8(bytes, delimiter),
+                                    _mm_cmpeq_epi8(bytes, newline));
+        int mask = _mm_movemask_epi8(hits);
+        if (mask != 0){
+            return pos + __builtin_ctz(mask);
+        }
+        pos += 16;
+    }
+#endif
+    while (pos < end && *pos != DELIMITER && *pos != '\n'){
+        pos++;
+    }
+    return pos;
+}
@@ -0,0 +1,154 @@
+/*Title: HistoryLoader.h
+  Author: Shariq Moghees
+  Date: 10/17/2026
+  Description: These classes map a history file into memory and parse its
+               url,timestamp records without copying them
+*/
+#ifndef HISTORY_LOADER_H //Header guards
+#define HISTORY_LOADER_H //Header guards
+
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <string_view>
+#include <vector>
+using namespace std;
+
+//Constants
+const char DELIMITER = ','; //Separates the url and timestamp fields
+
+//A record the parser could not read and where it starts in the file
+struct LoadError {
+  size_t m_offset; //Byte offset of the malformed record
+  string m_message; //Why the record was skipped
+};
+
+//One parsed url,timestamp record. m_url views the parsed range.
+struct HistoryRecord {
+  string_view m_url; //URL of the visit
+  int64_t m_timeStamp; //Timestamp of the visit in milliseconds
+};
+
+//Records and errors parsed from one record-aligned piece of a file
+struct HistoryChunk {
+  vector<HistoryRecord> m_records; //Records in file order
+  vector<LoadError> m_errors; //Malformed records in file order
+};
+
+//Read-only view of a whole file. Uses mmap where available and otherwise
+//reads the file into a buffer.
+class MappedFile {
+ public:
+  // Name: MappedFile (Default constructor)
+  // Description: Creates a MappedFile with nothing open
+  // Preconditions: None
+  // Postconditions: GetSize() is 0
+  MappedFile();
+  // Name: ~MappedFile
+  // Description: Unmaps the file
+  // Preconditions: None
+  // Postconditions: Calls Close()
+  ~MappedFile();
+  // Name: Open
+  // Description: Maps fileName into memory (closing any open file first)
+  // Preconditions: None
+  // Postconditions: Returns false if the file could not be opened
+  bool Open(const string& fileName);
+  // Name: Close
+  // Description: Unmaps the file and releases any buffer
+  // Preconditions: None
+  // Postconditions: GetSize() is 0
+  void Close();
+  // Name: GetData
+  // Description: Returns the first byte of the file
+  // Preconditions: None
+  // Postconditions: None
+  const char* GetData() const;
+  // Name: GetSize
+  // Description: Returns the size of the file in bytes
+  // Preconditions: None
+  // Postconditions: None
+  size_t GetSize() const;
+ private:
+  MappedFile(const MappedFile&) = delete; //Owns the mapping
+  MappedFile& operator=(const MappedFile&) = delete;
+
+  const char* m_data; //Start of the mapped bytes
+  size_t m_size; //Number of mapped bytes
+  bool m_mapped; //True if m_data came from mmap rather than m_buffer
+  vector<char> m_buffer; //File contents when mmap is not available
+};
+
+//Parses url,timestamp records out of a byte range. Fields are separated by
+//DELIMITER or a newline, so "url,ts\n", "url,ts,\n" and one long
+//"url,ts,url,ts" line all read the same. A timestamp is whole seconds with
+//an optional fraction ("1520000000" or "1520000000.250") and is returned in
+//milliseconds; digits past the millisecond are dropped. URLs are returned as views into the
+//range; a malformed record is recorded in GetErrors() and skipped up to the
+//next newline.
+class HistoryParser {
+ public:
+  // Name: HistoryParser (Overloaded constructor)
+  // Description: Parses [begin, end). baseOffset is added to error offsets
+  //              when the range is part of a larger file.
+  // Preconditions: begin <= end
+  // Postconditions: Creates a parser positioned at begin
+  HistoryParser(const char* begin, const char* end, size_t baseOffset = 0);
+  // Name: Next
+  // Description: Reads the next well-formed record
+  // Preconditions: None
+  // Postconditions: Returns false once the range is exhausted
+  bool Next(string_view& url, int64_t& timestamp);
+  // Name: GetErrors
+  // Description: Returns the records skipped so far
+  // Preconditions: None
+  // Postconditions: None
+  const vector<LoadError>& GetErrors() const;
+  // Name: ParseTimeStamp
+  // Description: Converts seconds with an optional fraction to milliseconds
+  // Preconditions: None
+  // Postconditions: Returns false if field is not a timestamp
+  static bool ParseTimeStamp(string_view field, int64_t& timestamp);
+ private:
+  // Name: NextField
+  // Description: Returns the next field (without its separator) and moves
+  //              past the separator
+  // Preconditions: m_pos < m_end
+  // Postconditions: Sets endsLine if the field ended at a newline or the end
+  string_view NextField(bool& endsLine);
+  // Name: SkipLine
+  // Description: Moves m_pos past the next newline
+  // Preconditions: None
+  // Postconditions: m_pos is at the start of a line or at m_end
+  void SkipLine();
+  // Name: AddError
+  // Description: Records a malformed record starting at start
+  // Preconditions: start is inside the range
+  // Postconditions: Appends to m_errors
+  void AddError(const char* start, const char* message);
+
+  const char* m_begin; //Start of the range
+  const char* m_pos; //Next unread byte
+  const char* m_end; //One past the last byte
+  size_t m_baseOffset; //File offset of m_begin
+  vector<LoadError> m_errors; //Records that were skipped
+};
+
+// Name: ParseChunks
+// Description: Splits [begin, end) at newlines into record-aligned chunks and
+//              parses them on threadCount threads. Concatenating the chunks
+//              in order gives the same records and errors as one
+//              HistoryParser over the whole range.
+// Preconditions: begin <= end, threadCount is at least 1
+// Postconditions: chunks holds the parsed chunks in file order
+void ParseChunks(const char* begin, const char* end, unsigned threadCount,
+                 vector<HistoryChunk>& chunks);
+
+// Name: FindSeparator
+// Description: Returns the first DELIMITER or newline in [pos, end), or end.
+//              Scans 16 bytes at a time with SSE2 where available.
+// Preconditions: pos <= end
+// Postconditions: None
+const char* FindSeparator(const char* pos, const char* end);
+
+#endif
@@ -0,0 +1,197 @@
+/*Title: HistorySnapshot.cpp
+  Author: Shariq Moghees
+  Date: 10/17/2026
+  Description: These functions convert browser history to and from the
+               binary snapshot format
+*/
+#include "HistorySnapshot.h"
+#include "TimeFormatter.h"
+#include <cstring>
+
+//Constants
+const uint64_t FNV_OFFSET = 14695981039346656037ULL; //FNV-1a 64-bit basis
+const uint64_t FNV_PRIME = 1099511628211ULL; //FNV-1a 64-bit prime
+
+// Name: Checksum
+// Description: Returns the FNV-1a 64-bit hash of [data, data + size)
+// Preconditions: None
+// Postconditions: None
+uint64_t Checksum(const char* data, size_t size){
+    uint64_t hash = FNV_OFFSET;
+    for (size_t i = 0; i < size; i++){
+        hash ^= static_cast<unsigned char>(data[i]);
+        hash *= FNV_PRIME;
+    }
+    return hash;
+}
+
+// Name: PutVarint
+// Description: Appends value to out as a LEB128 varint
+// Preconditions: None
+// Postconditions: 1 to 10 bytes are appended
+void PutVarint(string& out, uint64_t value){
+    while (value >= 0x80){
+        out.push_back(static_cast<char>((value & 0x7F) | 0x80));
+        value >>= 7;
+    }
+    out.push_back(static_cast<char>(value));
+}
+
+// Name: GetVarint
+// Description: Reads a LEB128 varint at pos and moves pos past it
+// Preconditions: pos <= end
+// Postconditions: Returns false if the varint runs past end or is too long
+bool GetVarint(const char*& pos, const char* end, uint64_t& value){
+    value = 0;
+    for (int shift = 0; shift < 64 && pos < end; shift += 7){
+        unsigned char byte = static_cast<unsigned char>(*pos++);
+        value |= static_cast<uint64_t>(byte & 0x7F) << shift;
+        if ((byte & 0x80) == 0){
+            return true;
+        }
+    }
+    return false;
+}
+
+// Name: PutFixed64
+// Description: Appends value to out as 8 little-endian bytes
+// Preconditions: None
+// Postconditions: 8 bytes are appended
+void PutFixed64(string& out, uint64_t value){
+    for (size_t i = 0; i < CHECKSUM_BYTES; i++){
+        out.push_back(static_cast<char>(value >> (8 * i)));
+    }
+}
+
+// Name: GetFixed64
+// Description: Reads 8 little-endian bytes at data
+// Preconditions: data points to at least 8 bytes
+// Postconditions: None
+uint64_t GetFixed64(const char* data){
+    uint64_t value = 0;
+    for (size_t i = 0; i < CHECKSUM_BYTES; i++){
+        value |= static_cast<uint64_t>(static_cast<unsigned char>(data[i])) << (8 * i);
+    }
+    return value;
+}
+
+// Name: EncodeSnapshot
+// Description: Serializes entries (oldest first, with the first backCount of
+//              them being the back stack) into out
+// Preconditions: backCount <= entries.size(); if backCount < entries.size()
+//                the next entry is the current page
+// Postconditions: out holds a complete snapshot
+void EncodeSnapshot(const vector<NavigationEntry*>& entries, size_t backCount, string& out){
+    out.assign(SNAPSHOT_MAGIC, sizeof(SNAPSHOT_MAGIC));
+    PutVarint(out, SNAPSHOT_VERSION);
+
+    //number the URLs that are still referenced, in first-seen order
+    const uint32_t UNSEEN = UINT32_MAX;
+    vector<uint32_t> remap;
+    vector<string_view> urls;
+    vector<uint32_t> indexes(entries.size());
+    for (size_t i = 0; i < entries.size(); i++){
+        UrlId id = entries[i]->GetURLId();
+        if (id >= remap.size()){
+            remap.resize(id + 1, UNSEEN);
+        }
+        if (remap[id] == UNSEEN){
+            remap[id] = static_cast<uint32_t>(urls.size());
+            urls.push_back(entries[i]->GetURLView());
+        }
+        indexes[i] = remap[id];
+    }
+    PutVarint(out, urls.size());
+    for (size_t i = 0; i < urls.size(); i++){
+        PutVarint(out, urls[i].size());
+        out.append(urls[i].data(), urls[i].size());
+    }
+
+    PutVarint(out, entries.size());
+    PutVarint(out, backCount);
+    int64_t previous = 0;
+    for (size_t i = 0; i < entries.size(); i++){
+        int64_t timestamp = entries[i]->GetTimeStamp();
+        uint64_t delta = static_cast<uint64_t>(timestamp) - static_cast<uint64_t>(previous);
+        PutVarint(out, indexes[i]);
+        PutVarint(out, (delta << 1) ^ (0 - (delta >> 63))); //zigzag keeps small negatives short
+        previous = timestamp;
+    }
+
+    PutFixed64(out, Checksum(out.data(), out.size()));
+}
+
+// Name: DecodeSnapshot
+// Description: Checks and decodes a snapshot. The URLs in records view the
+//              snapshot's URL table inside [data, data + size).
+// Preconditions: None
+// Postconditions: Returns false and sets error if the snapshot is malformed
+bool DecodeSnapshot(const char* data, size_t size, vector<HistoryRecord>& records,
+                    size_t& backCount, string& error){
+    records.clear();
+    backCount = 0;
+    if (size < sizeof(SNAPSHOT_MAGIC) + CHECKSUM_BYTES ||
+        memcmp(data, SNAPSHOT_MAGIC, sizeof(SNAPSHOT_MAGIC)) != 0){
+        error = "not a history snapshot";
+        return false;
+    }
+    const char* end = data + size - CHECKSUM_BYTES;
+    if (GetFixed64(end) != Checksum(data, size - CHECKSUM_BYTES)){
+        error = "checksum mismatch";
+        return false;
+    }
+
+    const char* pos = data + sizeof(SNAPSHOT_MAGIC);
+    uint64_t version, urlCount, entryCount, backTotal;
+    if (!GetVarint(pos, end, version) ||
+        (version != SNAPSHOT_VERSION && version != SNAPSHOT_SECONDS_VERSION)){
+        error = "unsupported snapshot version";
+        return false;
+    }
+    if (!GetVarint(pos, end, urlCount) || urlCount > static_cast<uint64_t>(end - pos)){
+        error = "truncated URL table";
+        return false;
+    }
+    vector<string_view> urls(urlCount);
+    for (uint64_t i = 0; i < urlCount; i++){
+        uint64_t length;
+        if (!GetVarint(pos, end, length) || length > static_cast<uint64_t>(end - pos)){
+            error = "truncated URL table";
+            return false;
+        }
+        urls[i] = string_view(pos, length);
+        pos += length;
+    }
+
+    if (!GetVarint(pos, end, entryCount) || !GetVarint(pos, end, backTotal) ||
+        backTotal > entryCount || entryCount > static_cast<uint64_t>(end - pos) / 2){
+        error = "bad entry count";
+        return false;
+    }
+    records.resize(entryCount);
+    int64_t scale = (version == SNAPSHOT_SECONDS_VERSION) ? MS_PER_SECOND : 1;
+    int64_t previous = 0;
+    for (uint64_t i = 0; i < entryCount; i++){
+        uint64_t index, zigzag;
+        if (!GetVarint(pos, end, index) || !GetVarint(pos, end, zigzag) || index >= urlCount){
+            error = "bad entry";
+            records.clear();
+            return false;
+        }
+        uint64_t delta = (zigzag >> 1) ^ (0 - (zigzag & 1));
+        previous = static_cast<int64_t>(static_cast<uint64_t>(previous) + delta);
+        records[i].m_url = urls[index];
+        records[i].m_timeStamp = previous * scale;
+    }
+    backCount = backTotal;
+    return true;
+}
+
+// Name: GetSnapshotId
+// Description: Returns the checksum stored at the end of a snapshot. A
+//              journal names the snapshot it follows by this id.
+// Preconditions: size is at least CHECKSUM_BYTES
+// Postconditions: None
+uint64_t GetSnapshotId(const char* data, size_t size){
+    return GetFixed64(data + size - CHECKSUM_BYTES);
+}
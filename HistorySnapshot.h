@@ -0,0 +1,86 @@
+/*Title: HistorySnapshot.h
+  Author: Shariq Moghees
+  Date: 10/17/2026
+  Description: These functions convert browser history to and from the
+               binary snapshot format
+*/
+#ifndef HISTORY_SNAPSHOT_H //Header guards
+#define HISTORY_SNAPSHOT_H //Header guards
+
+#include <cstdint>
+#include <string>
+#include <vector>
+#include "HistoryLoader.h"
+#include "NavigationEntry.h"
+using namespace std;
+
+//Snapshot layout (integers are LEB128 varints unless noted):
+//  magic "BHSN" (4 bytes), version
+//  URL table: count, then (length, bytes) per URL, each URL once
+//  entry count, back count
+//  per entry: index into the URL table, zigzag delta from previous timestamp
+//             (milliseconds; version 1 stored seconds and is still read)
+//  FNV-1a 64-bit checksum of everything before it (8 bytes, little endian)
+//Entries run oldest first: the back stack from the bottom, the current page,
+//then the forward stack from the top.
+
+//Constants
+const char SNAPSHOT_MAGIC[4] = {'B', 'H', 'S', 'N'};
+const uint64_t SNAPSHOT_VERSION = 2;
+const uint64_t SNAPSHOT_SECONDS_VERSION = 1; //Last version with timestamps in seconds
+const size_t CHECKSUM_BYTES = 8; //Size of the checksum ending a snapshot
+
+// Name: Checksum
+// Description: Returns the FNV-1a 64-bit hash of [data, data + size)
+// Preconditions: None
+// Postconditions: None
+uint64_t Checksum(const char* data, size_t size);
+
+// Name: PutVarint
+// Description: Appends value to out as a LEB128 varint
+// Preconditions: None
+// Postconditions: 1 to 10 bytes are appended
+void PutVarint(string& out, uint64_t value);
+
+// Name: GetVarint
+// Description: Reads a LEB128 varint at pos and moves pos past it
+// Preconditions: pos <= end
+// Postconditions: Returns false if the varint runs past end or is too long
+bool GetVarint(const char*& pos, const char* end, uint64_t& value);
+
+// Name: PutFixed64
+// Description: Appends value to out as 8 little-endian bytes
+// Preconditions: None
+// Postconditions: 8 bytes are appended
+void PutFixed64(string& out, uint64_t value);
+
+// Name: GetFixed64
+// Description: Reads 8 little-endian bytes at data
+// Preconditions: data points to at least 8 bytes
+// Postconditions: None
+uint64_t GetFixed64(const char* data);
+
+// Name: EncodeSnapshot
+// Description: Serializes entries (oldest first, with the first backCount of
+//              them being the back stack) into out
+// Preconditions: backCount <= entries.size(); if backCount < entries.size()
+//                the next entry is the current page
+// Postconditions: out holds a complete snapshot
+void EncodeSnapshot(const vector<NavigationEntry*>& entries, size_t backCount, string& out);
+
+// Name: DecodeSnapshot
+// Description: Checks and decodes a snapshot. The URLs in records view the
+//              snapshot's URL table inside [data, data + size).
+// Preconditions: None
+// Postconditions: Returns false and sets error if the snapshot is malformed
+bool DecodeSnapshot(const char* data, size_t size, vector<HistoryRecord>& records,
+                    size_t& backCount, string& error);
+
+// Name: GetSnapshotId
+// Description: Returns the checksum stored at the end of a snapshot. A
+//              journal names the snapshot it follows by this id.
+// Preconditions: size is at least CHECKSUM_BYTES
+// Postconditions: None
+uint64_t GetSnapshotId(const char* data, size_t size);
+
+#endif
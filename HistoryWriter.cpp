@@ -0,0 +1,151 @@
+/*Title: HistoryWriter.cpp
+  Author: Shariq Moghees
+  Date: 10/17/2026
+  Description: These classes format browser history into a reusable buffer
+               and hand it to an output sink in large blocks
+*/
+#include "HistoryWriter.h"
+#include <cstring>
+
+//Text around each entry, matching NavigationEntry's <<
+const string_view ENTRY_PREFIX = "URL:";
+const string_view ENTRY_INFIX = " Visited On: ";
+
+// Name: ~OutputSink (Destructor)
+// Description: Destroys the sink
+// Preconditions: None
+// Postconditions: None
+OutputSink::~OutputSink(){}
+
+// Name: StreamSink (Overloaded constructor)
+// Description: Creates a sink that writes to out
+// Preconditions: out outlives the sink
+// Postconditions: Creates a new StreamSink
+StreamSink::StreamSink(ostream& out)
+    :m_out(out){}
+
+// Name: Write
+// Description: Writes size bytes starting at data to the stream
+// Preconditions: None
+// Postconditions: Returns false if the stream failed
+bool StreamSink::Write(const char* data, size_t size){
+    m_out.write(data, static_cast<streamsize>(size));
+    return m_out.good();
+}
+
+// Name: StringSink (Overloaded constructor)
+// Description: Creates a sink that appends to out
+// Preconditions: out outlives the sink
+// Postconditions: Creates a new StringSink
+StringSink::StringSink(string& out)
+    :m_out(out){}
+
+// Name: Write
+// Description: Appends size bytes starting at data to the string
+// Preconditions: None
+// Postconditions: Returns true
+bool StringSink::Write(const char* data, size_t size){
+    m_out.append(data, size);
+    return true;
+}
+
+// Name: HistoryWriter (Overloaded constructor)
+// Description: Creates a writer that flushes to sink every bufferSize bytes
+// Preconditions: sink outlives the writer; bufferSize is greater than 0
+// Postconditions: Creates a new HistoryWriter with an empty buffer
+HistoryWriter::HistoryWriter(OutputSink& sink, size_t bufferSize)
+    :m_sink(sink),m_buffer(bufferSize),m_used(0),m_failed(false){}
+
+// Name: ~HistoryWriter (Destructor)
+// Description: Flushes anything still buffered
+// Preconditions: None
+// Postconditions: The buffer has been written to the sink
+HistoryWriter::~HistoryWriter(){
+    Flush();
+}
+
+// Name: Write
+// Description: Adds text to the buffer
+// Preconditions: None
+// Postconditions: Flushes first if text does not fit
+void HistoryWriter::Write(string_view text){
+    if (text.size() > m_buffer.size()){ //too long to buffer, pass it straight through
+        Flush();
+        if (!m_sink.Write(text.data(), text.size())){
+            m_failed = true;
+        }
+        return;
+    }
+    Reserve(text.size());
+    memcpy(m_buffer.data() + m_used, text.data(), text.size());
+    m_used += text.size();
+}
+
+// Name: WriteNumber
+// Description: Adds value as decimal digits to the buffer
+// Preconditions: None
+// Postconditions: Flushes first if the digits do not fit
+void HistoryWriter::WriteNumber(uint64_t value){
+    char digits[WRITER_NUMBER_LENGTH];
+    size_t start = WRITER_NUMBER_LENGTH;
+    do{ //digits come out lowest first
+        digits[--start] = static_cast<char>('0' + value % 10);
+        value /= 10;
+    } while (value != 0);
+    Write(string_view(digits + start, WRITER_NUMBER_LENGTH - start));
+}
+
+// Name: WriteEntry
+// Description: Adds entry and a newline to the buffer
+// Preconditions: None
+// Postconditions: Flushes first if the line does not fit
+void HistoryWriter::WriteEntry(const NavigationEntry& entry){
+    string_view url = entry.GetURLView();
+    size_t length = ENTRY_PREFIX.size() + url.size() + ENTRY_INFIX.size() + TIME_TEXT_LENGTH + 1;
+    if (length > m_buffer.size()){ //only a huge URL gets here
+        Write(ENTRY_PREFIX);
+        Write(url);
+        Write(ENTRY_INFIX);
+        char time[TIME_TEXT_LENGTH];
+        m_times.Format(entry.GetTimeStamp(), time);
+        Write(string_view(time, TIME_TEXT_LENGTH));
+        Write("\n");
+        return;
+    }
+    Reserve(length);
+    char* out = m_buffer.data() + m_used;
+    memcpy(out, ENTRY_PREFIX.data(), ENTRY_PREFIX.size());
+    out += ENTRY_PREFIX.size();
+    memcpy(out, url.data(), url.size());
+    out += url.size();
+    memcpy(out, ENTRY_INFIX.data(), ENTRY_INFIX.size());
+    out += ENTRY_INFIX.size();
+    m_times.Format(entry.GetTimeStamp(), out);
+    out[TIME_TEXT_LENGTH] = '\n';
+    m_used += length;
+}
+
+// Name: Flush
+// Description: Writes the buffer to the sink and empties it
+// Preconditions: None
+// Postconditions: Returns false if this or any earlier write to the sink
+//                 failed
+bool HistoryWriter::Flush(){
+    if (m_used > 0){
+        if (!m_sink.Write(m_buffer.data(), m_used)){
+            m_failed = true;
+        }
+        m_used = 0;
+    }
+    return !m_failed;
+}
+
+// Name: Reserve
+// Description: Makes room for size more bytes in the buffer
+// Preconditions: size is at most the buffer size
+// Postconditions: Flushes if the bytes would not fit
+void HistoryWriter::Reserve(size_t size){
+    if (m_buffer.size() - m_used < size){
+        Flush();
+    }
+}
@@ -0,0 +1,125 @@
+/*Title: HistoryWriter.h
+  Author: Shariq Moghees
+  Date: 10/17/2026
+  Description: These classes format browser history into a reusable buffer
+               and hand it to an output sink in large blocks
+*/
+#ifndef HISTORY_WRITER_H //Header guards
+#define HISTORY_WRITER_H //Header guards
+
+#include <cstddef>
+#include <cstdint>
+#include <ostream>
+#include <string>
+#include <string_view>
+#include <vector>
+#include "NavigationEntry.h"
+#include "TimeFormatter.h"
+using namespace std;
+
+//Constants
+const size_t WRITER_BUFFER_SIZE = 64 * 1024; //Default bytes buffered before a flush
+const size_t WRITER_NUMBER_LENGTH = 20; //Digits in the largest uint64_t
+
+//Where a HistoryWriter sends its blocks of text
+class OutputSink {
+ public:
+  // Name: ~OutputSink (Destructor)
+  // Description: Destroys the sink
+  // Preconditions: None
+  // Postconditions: None
+  virtual ~OutputSink();
+  // Name: Write
+  // Description: Writes size bytes starting at data
+  // Preconditions: None
+  // Postconditions: Returns false if the bytes could not be written
+  virtual bool Write(const char* data, size_t size) = 0;
+};
+
+//Writes to an ostream such as cout or an ofstream
+class StreamSink : public OutputSink {
+ public:
+  // Name: StreamSink (Overloaded constructor)
+  // Description: Creates a sink that writes to out
+  // Preconditions: out outlives the sink
+  // Postconditions: Creates a new StreamSink
+  StreamSink(ostream& out);
+  // Name: Write
+  // Description: Writes size bytes starting at data to the stream
+  // Preconditions: None
+  // Postconditions: Returns false if the stream failed
+  bool Write(const char* data, size_t size);
+ private:
+  ostream& m_out; //Stream written to
+};
+
+//Appends to a string in memory
+class StringSink : public OutputSink {
+ public:
+  // Name: StringSink (Overloaded constructor)
+  // Description: Creates a sink that appends to out
+  // Preconditions: out outlives the sink
+  // Postconditions: Creates a new StringSink
+  StringSink(string& out);
+  // Name: Write
+  // Description: Appends size bytes starting at data to the string
+  // Preconditions: None
+  // Postconditions: Returns true
+  bool Write(const char* data, size_t size);
+ private:
+  string& m_out; //String appended to
+};
+
+//Formats text, numbers and entries into one buffer that is reused for the
+//whole export, and passes it to the sink only when it fills up or on Flush.
+//Entries are written as "URL:<url> Visited On: <date and time>", the same
+//text NavigationEntry's << prints, but the date is built by a TimeFormatter
+//instead of a localtime and stream call per entry.
+class HistoryWriter {
+ public:
+  // Name: HistoryWriter (Overloaded constructor)
+  // Description: Creates a writer that flushes to sink every bufferSize bytes
+  // Preconditions: sink outlives the writer; bufferSize is greater than 0
+  // Postconditions: Creates a new HistoryWriter with an empty buffer
+  HistoryWriter(OutputSink& sink, size_t bufferSize = WRITER_BUFFER_SIZE);
+  // Name: ~HistoryWriter (Destructor)
+  // Description: Flushes anything still buffered
+  // Preconditions: None
+  // Postconditions: The buffer has been written to the sink
+  ~HistoryWriter();
+  // Name: Write
+  // Description: Adds text to the buffer
+  // Preconditions: None
+  // Postconditions: Flushes first if text does not fit
+  void Write(string_view text);
+  // Name: WriteNumber
+  // Description: Adds value as decimal digits to the buffer
+  // Preconditions: None
+  // Postconditions: Flushes first if the digits do not fit
+  void WriteNumber(uint64_t value);
+  // Name: WriteEntry
+  // Description: Adds entry and a newline to the buffer
+  // Preconditions: None
+  // Postconditions: Flushes first if the line does not fit
+  void WriteEntry(const NavigationEntry& entry);
+  // Name: Flush
+  // Description: Writes the buffer to the sink and empties it
+  // Preconditions: None
+  // Postconditions: Returns false if this or any earlier write to the sink
+  //                 failed
+  bool Flush();
+ private:
+  // Name: Reserve
+  // Description: Makes room for size more bytes in the buffer
+  // Preconditions: size is at most the buffer size
+  // Postconditions: Flushes if the bytes would not fit
+  void Reserve(size_t size);
+
+  OutputSink& m_sink; //Where full blocks go
+  vector<char> m_buffer; //Text not yet written to the sink
+  size_t m_used; //Bytes of m_buffer in use
+  bool m_failed; //A write to the sink has failed
+  TimeFormatter m_times; //Caches the current day and minute text
+};
+
+#endif
@@ -0,0 +1,408 @@
+/*Title: Journal.cpp
+  Author: Shariq Moghees
+  Date: 10/17/2026
+  Description: This class appends browser history operations to a
+               write-ahead journal that is replayed on top of a snapshot
+*/
+#include "Journal.h"
+#include "HistorySnapshot.h"
+#include <algorithm>
+#include <chrono>
+#include <cstdio>
+#include <cstring>
+
+#if defined(__unix__) || defined(__APPLE__)
+#define JOURNAL_POSIX 1
+#include <fcntl.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#else
+#define JOURNAL_POSIX 0
+#include <fcntl.h>
+#include <io.h>
+#include <sys/stat.h>
+#endif
+
+//Constants
+const size_t RECORD_CHECKSUM_BYTES = 4; //Checksum bytes after each payload
+const size_t JOURNAL_MAX_WRITE = 1 << 30; //Largest single write call
+
+// Name: NowMs
+// Description: Returns the steady clock in milliseconds
+// Preconditions: None
+// Postconditions: None
+static int64_t NowMs(){
+    return chrono::duration_cast<chrono::milliseconds>(
+        chrono::steady_clock::now().time_since_epoch()).count();
+}
+
+// Name: OpenForAppend
+// Description: Opens fileName for appending, creating it if needed
+// Preconditions: None
+// Postconditions: Returns -1 if the file could not be opened
+static int OpenForAppend(const string& fileName){
+#if JOURNAL_POSIX
+    return open(fileName.c_str(), O_WRONLY | O_CREAT | O_APPEND, 0644);
+#else
+    return _open(fileName.c_str(), _O_WRONLY | _O_CREAT | _O_APPEND | _O_BINARY,
+                 _S_IREAD | _S_IWRITE);
+#endif
+}
+
+// Name: SyncFile
+// Description: Flushes fd's data to disk
+// Preconditions: fd is open
+// Postconditions: Returns false if the sync failed
+static bool SyncFile(int fd){
+#if JOURNAL_POSIX && defined(__linux__)
+    return fdatasync(fd) == 0; //the size is data too, so appends are covered
+#elif JOURNAL_POSIX
+    return fsync(fd) == 0;
+#else
+    return _commit(fd) == 0;
+#endif
+}
+
+// Name: TruncateFile
+// Description: Cuts fd's file to size bytes
+// Preconditions: fd is open
+// Postconditions: Returns false if the file could not be cut
+static bool TruncateFile(int fd, size_t size){
+#if JOURNAL_POSIX
+    return ftruncate(fd, static_cast<off_t>(size)) == 0;
+#else
+    return _chsize_s(fd, static_cast<long long>(size)) == 0;
+#endif
+}
+
+// Name: CloseFile
+// Description: Closes fd
+// Preconditions: fd is open
+// Postconditions: None
+static void CloseFile(int fd){
+#if JOURNAL_POSIX
+    close(fd);
+#else
+    _close(fd);
+#endif
+}
+
+// Name: WriteAll
+// Description: Writes size bytes at data to fd
+// Preconditions: fd is open
+// Postconditions: Returns false if the write failed
+static bool WriteAll(int fd, const char* data, size_t size){
+    while (size > 0){ //write may stop short
+        size_t chunk = min(size, JOURNAL_MAX_WRITE);
+#if JOURNAL_POSIX
+        long long wrote = write(fd, data, chunk);
+#else
+        long long wrote = _write(fd, data, static_cast<unsigned>(chunk));
+#endif
+        if (wrote <= 0){
+            return false;
+        }
+        data += wrote;
+        size -= static_cast<size_t>(wrote);
+    }
+    return true;
+}
+
+// Name: GetFixed32
+// Description: Reads 4 little-endian bytes at data
+// Preconditions: data points to at least 4 bytes
+// Postconditions: None
+static uint32_t GetFixed32(const char* data){
+    uint32_t value = 0;
+    for (size_t i = 0; i < RECORD_CHECKSUM_BYTES; i++){
+        value |= static_cast<uint32_t>(static_cast<unsigned char>(data[i])) << (8 * i);
+    }
+    return value;
+}
+
+// Name: DecodeRecord
+// Description: Reads one record payload in [pos, end)
+// Preconditions: None
+// Postconditions: Returns false unless the payload is exactly one record
+static bool DecodeRecord(const char* pos, const char* end, JournalRecord& record){
+    if (pos == end){
+        return false;
+    }
+    unsigned char op = static_cast<unsigned char>(*pos++);
+    record.m_url = string_view();
+    record.m_timeStamp = 0;
+    record.m_steps = 0;
+    if (op == JOURNAL_VISIT){
+        uint64_t zigzag, length;
+        if (!GetVarint(pos, end, zigzag) || !GetVarint(pos, end, length) ||
+            length != static_cast<uint64_t>(end - pos)){
+            return false;
+        }
+        record.m_op = JOURNAL_VISIT;
+        record.m_timeStamp = static_cast<int64_t>((zigzag >> 1) ^ (0 - (zigzag & 1)));
+        record.m_url = string_view(pos, length);
+        return true;
+    }
+    if (op == JOURNAL_BACK || op == JOURNAL_FORWARD){
+        record.m_op = static_cast<JournalOp>(op);
+        return GetVarint(pos, end, record.m_steps) && pos == end;
+    }
+    return false; //unknown operation
+}
+
+// Name: DecodeJournal
+// Description: Reads a journal's header and every whole record after it.
+//              The URLs in records view [data, data + size).
+// Preconditions: None
+// Postconditions: Returns false if the header is malformed. Otherwise sets
+//                 base to the snapshot id and validSize to the bytes up to
+//                 the end of the last good record.
+bool DecodeJournal(const char* data, size_t size, uint64_t& base,
+                   vector<JournalRecord>& records, size_t& validSize){
+    records.clear();
+    base = 0;
+    validSize = 0;
+    if (size < sizeof(JOURNAL_MAGIC) || memcmp(data, JOURNAL_MAGIC, sizeof(JOURNAL_MAGIC)) != 0){
+        return false;
+    }
+    const char* pos = data + sizeof(JOURNAL_MAGIC);
+    const char* end = data + size;
+    uint64_t version;
+    if (!GetVarint(pos, end, version) || version != JOURNAL_VERSION ||
+        static_cast<size_t>(end - pos) < CHECKSUM_BYTES){
+        return false;
+    }
+    base = GetFixed64(pos);
+    pos += CHECKSUM_BYTES;
+    validSize = pos - data;
+    while (pos < end){ //stop at the first torn or damaged record
+        uint64_t length;
+        if (!GetVarint(pos, end, length) ||
+            length + RECORD_CHECKSUM_BYTES > static_cast<uint64_t>(end - pos)){
+            break;
+        }
+        const char* payloadEnd = pos + length;
+        JournalRecord record;
+        if (GetFixed32(payloadEnd) != static_cast<uint32_t>(Checksum(pos, length)) ||
+            !DecodeRecord(pos, payloadEnd, record)){
+            break;
+        }
+        records.push_back(record);
+        pos = payloadEnd + RECORD_CHECKSUM_BYTES;
+        validSize = pos - data;
+    }
+    return true;
+}
+
+// Name: ReplaceFile
+// Description: Writes data to fileName + ".tmp", syncs it to disk and
+//              renames it over fileName, so fileName always holds either
+//              the old or the new contents
+// Preconditions: None
+// Postconditions: Returns false if any step failed
+bool ReplaceFile(const string& fileName, const string& data){
+    string tempName = fileName + ".tmp";
+#if JOURNAL_POSIX
+    int fd = open(tempName.c_str(), O_WRONLY | O_CREAT | O_TRUNC, 0644);
+#else
+    int fd = _open(tempName.c_str(), _O_WRONLY | _O_CREAT | _O_TRUNC | _O_BINARY,
+                   _S_IREAD | _S_IWRITE);
+#endif
+    if (fd < 0){
+        return false;
+    }
+    bool good = WriteAll(fd, data.data(), data.size()) && SyncFile(fd);
+    CloseFile(fd);
+#if !JOURNAL_POSIX
+    if (good){
+        remove(fileName.c_str()); //rename does not replace a file here
+    }
+#endif
+    if (!good || rename(tempName.c_str(), fileName.c_str()) != 0){
+        remove(tempName.c_str());
+        return false;
+    }
+#if JOURNAL_POSIX
+    //the rename itself is only durable once the directory is synced
+    size_t slash = fileName.rfind('/');
+    string directory = (slash == string::npos) ? "." : fileName.substr(0, slash + 1);
+    int dirFd = open(directory.c_str(), O_RDONLY);
+    if (dirFd >= 0){
+        fsync(dirFd);
+        close(dirFd);
+    }
+#endif
+    return true;
+}
+
+// Name: Journal (Default constructor)
+// Description: Creates a Journal with no file open
+// Preconditions: None
+// Postconditions: IsOpen() is false
+Journal::Journal()
+    :m_fd(-1),m_pendingCount(0),m_pendingSince(0),m_groupRecords(JOURNAL_GROUP_RECORDS),
+     m_groupDelay(JOURNAL_GROUP_DELAY),m_recordCount(0),m_syncCount(0),m_committedSize(0),m_failed(false){}
+
+// Name: ~Journal (Destructor)
+// Description: Commits anything buffered and closes the file
+// Preconditions: None
+// Postconditions: Calls Close()
+Journal::~Journal(){Close();}
+
+// Name: Open
+// Description: Opens fileName for appending and keeps its first validSize
+//              bytes, which hold recordCount records, dropping any torn
+//              record after them. With validSize 0 the file is started
+//              over with a header naming snapshot base.
+// Preconditions: validSize and recordCount are 0 or came from
+//                DecodeJournal of fileName
+// Postconditions: Returns false if the file could not be opened
+bool Journal::Open(const string& fileName, uint64_t base, size_t validSize, size_t recordCount){
+    Close();
+    m_fd = OpenForAppend(fileName);
+    if (m_fd < 0){
+        return false;
+    }
+    m_failed = false;
+    if (validSize == 0){ //no usable header
+        return Reset(base);
+    }
+    if (!TruncateFile(m_fd, validSize)){ //appends go after the last good record
+        Close();
+        return false;
+    }
+    m_recordCount = recordCount;
+    m_committedSize = validSize;
+    return true;
+}
+
+// Name: Append
+// Description: Adds record to the current group
+// Preconditions: IsOpen() is true
+// Postconditions: Commits the group if it is full or has waited too long
+void Journal::Append(const JournalRecord& record){
+    m_record.clear();
+    m_record.push_back(static_cast<char>(record.m_op));
+    if (record.m_op == JOURNAL_VISIT){
+        uint64_t time = static_cast<uint64_t>(record.m_timeStamp);
+        PutVarint(m_record, (time << 1) ^ (0 - (time >> 63))); //zigzag
+        PutVarint(m_record, record.m_url.size());
+        m_record.append(record.m_url.data(), record.m_url.size());
+    } else{
+        PutVarint(m_record, record.m_steps);
+    }
+    PutVarint(m_pending, m_record.size());
+    m_pending.append(m_record);
+    uint32_t checksum = static_cast<uint32_t>(Checksum(m_record.data(), m_record.size()));
+    for (size_t i = 0; i < RECORD_CHECKSUM_BYTES; i++){
+        m_pending.push_back(static_cast<char>(checksum >> (8 * i)));
+    }
+    int64_t now = NowMs();
+    if (m_pendingCount == 0){ //first record of a new group
+        m_pendingSince = now;
+    }
+    m_pendingCount++;
+    m_recordCount++;
+    if (m_pendingCount >= m_groupRecords || now - m_pendingSince >= m_groupDelay){
+        Commit();
+    }
+}
+
+// Name: Commit
+// Description: Writes the buffered group and syncs the file. If that
+//              fails, cuts the file back to its last committed record and
+//              keeps the group buffered, so the next commit retries it.
+// Preconditions: None
+// Postconditions: Returns false if the buffered records are not durable
+bool Journal::Commit(){
+    if (m_fd < 0 || m_pendingCount == 0){ //nothing to make durable
+        return !m_failed;
+    }
+    //a failed write may have left part of a record, and reading stops at
+    //the first torn record, so nothing may be written after one
+    if (m_failed && !TruncateFile(m_fd, m_committedSize)){
+        return false;
+    }
+    if (!WriteAll(m_fd, m_pending.data(), m_pending.size()) || !SyncFile(m_fd)){
+        m_failed = true;
+        TruncateFile(m_fd, m_committedSize); //retried before the next write too
+        return false;
+    }
+    m_syncCount++;
+    m_committedSize += m_pending.size();
+    m_pending.clear();
+    m_pendingCount = 0;
+    m_failed = false;
+    return true;
+}
+
+// Name: Reset
+// Description: Empties the journal and writes a header naming snapshot
+//              base, after a checkpoint has saved everything in it
+// Preconditions: IsOpen() is true
+// Postconditions: Returns false if the file could not be rewritten
+bool Journal::Reset(uint64_t base){
+    m_pending.clear(); //the snapshot already holds these records
+    m_pendingCount = 0;
+    m_recordCount = 0;
+    string header(JOURNAL_MAGIC, sizeof(JOURNAL_MAGIC));
+    PutVarint(header, JOURNAL_VERSION);
+    PutFixed64(header, base);
+    if (!TruncateFile(m_fd, 0) || !WriteAll(m_fd, header.data(), header.size()) || !SyncFile(m_fd)){
+        m_failed = true;
+        return false;
+    }
+    m_syncCount++;
+    m_committedSize = header.size();
+    m_failed = false; //earlier failures were covered by the snapshot
+    return true;
+}
+
+// Name: Close
+// Description: Commits anything buffered and closes the file
+// Preconditions: None
+// Postconditions: IsOpen() is false
+void Journal::Close(){
+    if (m_fd < 0){
+        return;
+    }
+    Commit();
+    CloseFile(m_fd);
+    m_fd = -1;
+    m_recordCount = 0;
+}
+
+// Name: SetGroupCommit
+// Description: Commits every records records, or once the oldest
+//              buffered record has waited delay ms. 1 syncs every record.
+// Preconditions: records is greater than 0
+// Postconditions: None
+void Journal::SetGroupCommit(size_t records, int64_t delay){
+    m_groupRecords = (records == 0) ? 1 : records;
+    m_groupDelay = delay;
+}
+
+// Name: IsOpen
+// Description: Returns true if a journal file is open
+// Preconditions: None
+// Postconditions: None
+bool Journal::IsOpen() const{return m_fd >= 0;}
+
+// Name: GetRecordCount
+// Description: Returns the records in the journal since its header
+// Preconditions: None
+// Postconditions: None
+size_t Journal::GetRecordCount() const{return m_recordCount;}
+
+// Name: GetSyncCount
+// Description: Returns how many times the file has been synced
+// Preconditions: None
+// Postconditions: None
+size_t Journal::GetSyncCount() const{return m_syncCount;}
+
+// Name: HasFailed
+// Description: Returns true if the last commit or reset failed, so
+//              buffered records are not yet durable
+// Preconditions: None
+// Postconditions: None
+bool Journal::HasFailed() const{return m_failed;}
@@ -0,0 +1,165 @@
+/*Title: Journal.h
+  Author: Shariq Moghees
+  Date: 10/17/2026
+  Description: This class appends browser history operations to a
+               write-ahead journal that is replayed on top of a snapshot
+*/
+#ifndef JOURNAL_H //Header guards
+#define JOURNAL_H //Header guards
+
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <string_view>
+#include <vector>
+using namespace std;
+
+//Journal layout (integers are LEB128 varints unless noted):
+//  magic "BHJN" (4 bytes), version
+//  id of the snapshot the journal follows (8 bytes, little endian; 0 for
+//  no snapshot)
+//  per record: payload length, payload, low 32 bits of the payload's
+//              FNV-1a 64-bit checksum (4 bytes, little endian)
+//  payload: operation (1 byte), then
+//           visit: zigzag timestamp (milliseconds), URL length, URL bytes
+//           back or forward: steps moved
+//A crash can leave a torn record at the end. Reading stops at the first
+//record that is cut short or fails its checksum.
+
+//Constants
+const char JOURNAL_MAGIC[4] = {'B', 'H', 'J', 'N'};
+const uint64_t JOURNAL_VERSION = 1;
+const size_t JOURNAL_HEADER_SIZE = 13; //Magic, version (one varint byte) and snapshot id
+const size_t JOURNAL_GROUP_RECORDS = 64; //Records buffered before a commit
+const int64_t JOURNAL_GROUP_DELAY = 100; //Longest a record waits for a commit (ms)
+
+//What a journal record does to the history
+enum JournalOp {
+  JOURNAL_VISIT = 1, //Browser::Visit(m_url, m_timeStamp)
+  JOURNAL_BACK = 2, //Browser::Back(m_steps)
+  JOURNAL_FORWARD = 3 //Browser::Forward(m_steps)
+};
+
+//One operation read from or written to a journal
+struct JournalRecord {
+  JournalOp m_op; //Operation
+  string_view m_url; //URL visited (visit only)
+  int64_t m_timeStamp; //Milliseconds since the epoch (visit only)
+  uint64_t m_steps; //Steps moved (back and forward only)
+};
+
+// Name: DecodeJournal
+// Description: Reads a journal's header and every whole record after it.
+//              The URLs in records view [data, data + size).
+// Preconditions: None
+// Postconditions: Returns false if the header is malformed. Otherwise sets
+//                 base to the snapshot id and validSize to the bytes up to
+//                 the end of the last good record.
+bool DecodeJournal(const char* data, size_t size, uint64_t& base,
+                   vector<JournalRecord>& records, size_t& validSize);
+
+// Name: ReplaceFile
+// Description: Writes data to fileName + ".tmp", syncs it to disk and
+//              renames it over fileName, so fileName always holds either
+//              the old or the new contents
+// Preconditions: None
+// Postconditions: Returns false if any step failed
+bool ReplaceFile(const string& fileName, const string& data);
+
+//Appends records to a journal file with group commit: records collect in
+//a buffer and one write and one fsync make a whole group durable. A group
+//is committed once it holds JOURNAL_GROUP_RECORDS records or its oldest
+//record has waited JOURNAL_GROUP_DELAY ms when the next one arrives, and
+//on Commit, Reset and Close. A crash loses at most the uncommitted group.
+//The delay is only checked when a record arrives; a caller that must not
+//hold a lone record should commit every record (SetGroupCommit(1, 0)). A
+//failed commit keeps its group buffered and retries it on the next commit.
+class Journal {
+ public:
+  // Name: Journal (Default constructor)
+  // Description: Creates a Journal with no file open
+  // Preconditions: None
+  // Postconditions: IsOpen() is false
+  Journal();
+  // Name: ~Journal (Destructor)
+  // Description: Commits anything buffered and closes the file
+  // Preconditions: None
+  // Postconditions: Calls Close()
+  ~Journal();
+  // Name: Open
+  // Description: Opens fileName for appending and keeps its first validSize
+  //              bytes, which hold recordCount records, dropping any torn
+  //              record after them. With validSize 0 the file is started
+  //              over with a header naming snapshot base.
+  // Preconditions: validSize and recordCount are 0 or came from
+  //                DecodeJournal of fileName
+  // Postconditions: Returns false if the file could not be opened
+  bool Open(const string& fileName, uint64_t base, size_t validSize, size_t recordCount);
+  // Name: Append
+  // Description: Adds record to the current group
+  // Preconditions: IsOpen() is true
+  // Postconditions: Commits the group if it is full or has waited too long
+  void Append(const JournalRecord& record);
+  // Name: Commit
+  // Description: Writes the buffered group and syncs the file. If that
+  //              fails, cuts the file back to its last committed record and
+  //              keeps the group buffered, so the next commit retries it.
+  // Preconditions: None
+  // Postconditions: Returns false if the buffered records are not durable
+  bool Commit();
+  // Name: Reset
+  // Description: Empties the journal and writes a header naming snapshot
+  //              base, after a checkpoint has saved everything in it
+  // Preconditions: IsOpen() is true
+  // Postconditions: Returns false if the file could not be rewritten
+  bool Reset(uint64_t base);
+  // Name: Close
+  // Description: Commits anything buffered and closes the file
+  // Preconditions: None
+  // Postconditions: IsOpen() is false
+  void Close();
+  // Name: SetGroupCommit
+  // Description: Commits every records records, or once the oldest
+  //              buffered record has waited delay ms. 1 syncs every record.
+  // Preconditions: records is greater than 0
+  // Postconditions: None
+  void SetGroupCommit(size_t records, int64_t delay);
+  // Name: IsOpen
+  // Description: Returns true if a journal file is open
+  // Preconditions: None
+  // Postconditions: None
+  bool IsOpen() const;
+  // Name: GetRecordCount
+  // Description: Returns the records in the journal since its header
+  // Preconditions: None
+  // Postconditions: None
+  size_t GetRecordCount() const;
+  // Name: GetSyncCount
+  // Description: Returns how many times the file has been synced
+  // Preconditions: None
+  // Postconditions: None
+  size_t GetSyncCount() const;
+  // Name: HasFailed
+  // Description: Returns true if the last commit or reset failed, so
+  //              buffered records are not yet durable
+  // Preconditions: None
+  // Postconditions: None
+  bool HasFailed() const;
+
+  Journal(const Journal&) = delete; //Owns the file
+  Journal& operator=(const Journal&) = delete;
+ private:
+  int m_fd; //Journal file (-1 when closed)
+  string m_record; //Payload of the record being encoded, reused
+  string m_pending; //Encoded records not yet written
+  size_t m_pendingCount; //Records in m_pending
+  int64_t m_pendingSince; //Steady clock time (ms) the oldest pending record arrived
+  size_t m_groupRecords; //Records that fill a group
+  int64_t m_groupDelay; //Longest a record waits for a commit (ms)
+  size_t m_recordCount; //Records since the header, committed or not
+  size_t m_syncCount; //Syncs done
+  size_t m_committedSize; //Bytes of the file up to the end of the last committed record
+  bool m_failed; //A write or sync has failed
+};
+
+#endif
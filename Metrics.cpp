@@ -0,0 +1,236 @@
+/*Title: Metrics.cpp
+  Author: Shariq Moghees
+  Date: 10/17/2026
+  Description: Counters and latency histograms for the browser's hot paths,
+               kept per thread and summed into a snapshot on request
+*/
+#include "Metrics.h"
+#include <algorithm>
+#include <cmath>
+#include <mutex>
+#include <vector>
+
+//Names used by WriteMetrics, in enum order
+static const char* const TIMER_NAMES[METRIC_TIMER_COUNT] = {
+    "visit", "back", "forward", "load", "stack push (sampled)", "stack pop (sampled)"};
+
+#if USE_METRICS
+
+thread_local MetricsShard* t_metrics = nullptr;
+
+//Shards of running threads, and the sum of every exited thread's shard
+struct MetricsRegistry {
+  mutex m_lock; //Guards both members
+  vector<MetricsShard*> m_shards; //One per thread that has recorded
+  MetricsSnapshot m_retired; //Totals of threads that have exited
+};
+
+// Name: GetRegistry
+// Description: Returns the registry, built on first use so threads started
+//              during static initialization can record
+// Preconditions: None
+// Postconditions: None
+static MetricsRegistry& GetRegistry(){
+    static MetricsRegistry registry;
+    return registry;
+}
+
+// Name: AddShard
+// Description: Adds shard's values to snapshot
+// Preconditions: None
+// Postconditions: None
+static void AddShard(const MetricsShard& shard, MetricsSnapshot& snapshot){
+    for (size_t i = 0; i < METRIC_COUNTER_COUNT; i++){
+        snapshot.m_counters[i] += shard.m_counters[i].load(memory_order_relaxed);
+    }
+    for (size_t i = 0; i < METRIC_PEAK_COUNT; i++){
+        snapshot.m_peaks[i] = max(snapshot.m_peaks[i], shard.m_peaks[i].load(memory_order_relaxed));
+    }
+    for (size_t i = 0; i < METRIC_TIMER_COUNT; i++){
+        LatencyHistogram& timer = snapshot.m_timers[i];
+        timer.m_count += shard.m_timerCounts[i].load(memory_order_relaxed);
+        timer.m_total += shard.m_timerTotals[i].load(memory_order_relaxed);
+        timer.m_max = max(timer.m_max, shard.m_timerMax[i].load(memory_order_relaxed));
+        for (size_t j = 0; j < METRIC_BUCKETS; j++){
+            timer.m_buckets[j] += shard.m_buckets[i][j].load(memory_order_relaxed);
+        }
+    }
+}
+
+// Name: ClearShard
+// Description: Zeroes every value in shard
+// Preconditions: None
+// Postconditions: None
+static void ClearShard(MetricsShard& shard){
+    for (atomic<uint64_t>& value : shard.m_counters){
+        value.store(0, memory_order_relaxed);
+    }
+    for (atomic<uint64_t>& value : shard.m_peaks){
+        value.store(0, memory_order_relaxed);
+    }
+    for (size_t i = 0; i < METRIC_TIMER_COUNT; i++){
+        shard.m_timerCounts[i].store(0, memory_order_relaxed);
+        shard.m_timerTotals[i].store(0, memory_order_relaxed);
+        shard.m_timerMax[i].store(0, memory_order_relaxed);
+        for (atomic<uint64_t>& bucket : shard.m_buckets[i]){
+            bucket.store(0, memory_order_relaxed);
+        }
+    }
+}
+
+//Owns the calling thread's shard and retires it when the thread exits
+struct ShardOwner {
+  MetricsShard* m_shard; //Shard this thread records into
+
+  ShardOwner():m_shard(new MetricsShard()){ //value-initialized, so every count starts at 0
+      MetricsRegistry& registry = GetRegistry();
+      lock_guard<mutex> hold(registry.m_lock);
+      registry.m_shards.push_back(m_shard);
+  }
+
+  ~ShardOwner(){
+      MetricsRegistry& registry = GetRegistry();
+      {
+          lock_guard<mutex> hold(registry.m_lock);
+          AddShard(*m_shard, registry.m_retired);
+          registry.m_shards.erase(find(registry.m_shards.begin(), registry.m_shards.end(), m_shard));
+      }
+      t_metrics = nullptr;
+      delete m_shard;
+  }
+};
+
+// Name: AttachMetrics
+// Description: Gives the calling thread a shard that ReadMetrics can see
+// Preconditions: t_metrics is nullptr
+// Postconditions: Returns t_metrics. The shard is folded into the totals
+//                 when the thread exits.
+MetricsShard* AttachMetrics(){
+    GetRegistry(); //built before the owner, so destroyed after it
+    static thread_local ShardOwner owner;
+    t_metrics = owner.m_shard;
+    return t_metrics;
+}
+
+#endif
+
+// Name: ReadMetrics
+// Description: Sums every thread's metrics, including threads that have
+//              exited, into snapshot. Depths are left 0.
+// Preconditions: None
+// Postconditions: Operations in progress may be partly counted
+void ReadMetrics(MetricsSnapshot& snapshot){
+    snapshot = MetricsSnapshot();
+#if USE_METRICS
+    MetricsRegistry& registry = GetRegistry();
+    lock_guard<mutex> hold(registry.m_lock);
+    snapshot = registry.m_retired;
+    for (const MetricsShard* shard : registry.m_shards){
+        AddShard(*shard, snapshot);
+    }
+#endif
+}
+
+// Name: ResetMetrics
+// Description: Zeroes every metric
+// Preconditions: None
+// Postconditions: A value another thread records while this runs may
+//                 survive the reset
+void ResetMetrics(){
+#if USE_METRICS
+    MetricsRegistry& registry = GetRegistry();
+    lock_guard<mutex> hold(registry.m_lock);
+    registry.m_retired = MetricsSnapshot();
+    for (MetricsShard* shard : registry.m_shards){
+        ClearShard(*shard);
+    }
+#endif
+}
+
+// Name: GetBucketHigh
+// Description: Returns the highest latency bucket holds
+// Preconditions: bucket < METRIC_BUCKETS
+// Postconditions: None
+uint64_t GetBucketHigh(size_t bucket){
+    if (bucket < METRIC_SUB_BUCKETS){
+        return bucket;
+    }
+    if (bucket == METRIC_BUCKETS - 1){ //holds everything slower
+        return UINT64_MAX;
+    }
+    size_t top = bucket / METRIC_SUB_BUCKETS + 1; //highest set bit of its values
+    uint64_t next = METRIC_SUB_BUCKETS + bucket % METRIC_SUB_BUCKETS + 1;
+    return (next << (top - 2)) - 1;
+}
+
+// Name: GetPercentile
+// Description: Returns the highest latency in the bucket holding the
+//              operation slower than share of the others
+// Preconditions: 0 <= share <= 1
+// Postconditions: Returns 0 if nothing was timed
+uint64_t GetPercentile(const LatencyHistogram& histogram, double share){
+    uint64_t total = 0;
+    for (uint64_t count : histogram.m_buckets){ //m_count can be ahead mid-update
+        total += count;
+    }
+    if (total == 0){
+        return 0;
+    }
+    uint64_t rank = max<uint64_t>(static_cast<uint64_t>(ceil(share * static_cast<double>(total))), 1);
+    uint64_t seen = 0;
+    for (size_t i = 0; i < METRIC_BUCKETS; i++){
+        seen += histogram.m_buckets[i];
+        if (seen >= rank){
+            return min(GetBucketHigh(i), histogram.m_max); //no bucket is above the max
+        }
+    }
+    return histogram.m_max;
+}
+
+// Name: WriteMetrics
+// Description: Writes snapshot to out as text, one metric per line, with
+//              the mean, p50, p99 and max of each timer and the load
+//              throughput
+// Preconditions: None
+// Postconditions: None
+void WriteMetrics(const MetricsSnapshot& snapshot, ostream& out){
+    const uint64_t* counters = snapshot.m_counters;
+    out << "**Metrics**" << endl;
+#if !USE_METRICS
+    out << "(recording is compiled out; build with -DUSE_METRICS=1)" << endl;
+#endif
+    out << "visits: " << counters[METRIC_VISITS] << endl;
+    out << "back: " << counters[METRIC_BACKS] << " calls, "
+        << counters[METRIC_BACK_STEPS] << " pages" << endl;
+    out << "forward: " << counters[METRIC_FORWARDS] << " calls, "
+        << counters[METRIC_FORWARD_STEPS] << " pages" << endl;
+    out << "loads: " << counters[METRIC_LOADS] << " files, " << counters[METRIC_LOAD_RECORDS]
+        << " records, " << counters[METRIC_LOAD_BYTES] << " bytes, "
+        << counters[METRIC_LOAD_ERRORS] << " skipped" << endl;
+    const LatencyHistogram& load = snapshot.m_timers[METRIC_LOAD_TIME];
+    if (load.m_total > 0){ //bytes per nanosecond is GB/s, so * 1000 for MB/s
+        out << "load throughput: "
+            << static_cast<double>(counters[METRIC_LOAD_BYTES]) * 1000.0 / static_cast<double>(load.m_total)
+            << " MB/s" << endl;
+    }
+    out << "evictions: " << counters[METRIC_EVICTIONS] << endl;
+    out << "stack: " << counters[METRIC_PUSHES] << " pushes, " << counters[METRIC_POPS]
+        << " pops, deepest " << snapshot.m_peaks[METRIC_PEAK_STACK] << endl;
+    out << "pool: " << counters[METRIC_ALLOCATIONS] << " allocations, "
+        << counters[METRIC_BLOCKS] << " blocks" << endl;
+    out << "back depth: " << snapshot.m_backDepth << " (deepest "
+        << snapshot.m_peaks[METRIC_PEAK_BACK] << ")" << endl;
+    out << "forward depth: " << snapshot.m_forwardDepth << " (deepest "
+        << snapshot.m_peaks[METRIC_PEAK_FORWARD] << ")" << endl;
+    for (size_t i = 0; i < METRIC_TIMER_COUNT; i++){
+        const LatencyHistogram& timer = snapshot.m_timers[i];
+        out << TIMER_NAMES[i] << " latency: ";
+        if (timer.m_count == 0){
+            out << "none timed" << endl;
+            continue;
+        }
+        out << timer.m_count << " timed, mean " << timer.m_total / timer.m_count
+            << " ns, p50 " << GetPercentile(timer, 0.50) << " ns, p99 "
+            << GetPercentile(timer, 0.99) << " ns, max " << timer.m_max << " ns" << endl;
+    }
+}
@@ -0,0 +1,262 @@
+/*Title: Metrics.h
+  Author: Shariq Moghees
+  Date: 10/17/2026
+  Description: Counters and latency histograms for the browser's hot paths,
+               kept per thread and summed into a snapshot on request
+*/
+#ifndef METRICS_H //Header guards
+#define METRICS_H //Header guards
+
+#include <atomic>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <ostream>
+using namespace std;
+
+//Build with -DUSE_METRICS=0 to compile the recording calls out. Every
+//recording function is then an empty inline and MetricTimer reads no
+//clock, so instrumented code is the same as uninstrumented code. The
+//snapshot API stays, and reads all zeros.
+#ifndef USE_METRICS
+#define USE_METRICS 1
+#endif
+
+//Constants
+const size_t METRIC_SUB_BUCKETS = 4; //Histogram buckets per power of two
+const size_t METRIC_BUCKETS = 160; //Histogram buckets; the last holds everything over ~18 minutes
+const uint64_t METRIC_SAMPLE_EVERY = 64; //Stack pushes and pops timed: one in this many
+
+//Things counted. Totals are for the whole process.
+enum MetricCounter {
+  METRIC_VISITS, //Visits, one per record in a batch
+  METRIC_BACKS, //Back calls that moved
+  METRIC_BACK_STEPS, //Pages moved back
+  METRIC_FORWARDS, //Forward calls that moved
+  METRIC_FORWARD_STEPS, //Pages moved forward
+  METRIC_LOADS, //LoadFile calls that opened their file
+  METRIC_LOAD_RECORDS, //Records LoadFile visited
+  METRIC_LOAD_BYTES, //Bytes of history files loaded
+  METRIC_LOAD_ERRORS, //Malformed records LoadFile skipped
+  METRIC_EVICTIONS, //Entries dropped by the history limit
+  METRIC_PUSHES, //Stack pushes (any backend)
+  METRIC_POPS, //Stack pops (any backend)
+  METRIC_ALLOCATIONS, //Objects handed out by a Pool
+  METRIC_BLOCKS, //Blocks a Pool allocated from the heap
+  METRIC_COUNTER_COUNT //Number of counters
+};
+
+//Largest values seen
+enum MetricPeak {
+  METRIC_PEAK_BACK, //Deepest back history after a Visit or Forward
+  METRIC_PEAK_FORWARD, //Deepest forward history after a Back
+  METRIC_PEAK_STACK, //Deepest stack after a push (any backend)
+  METRIC_PEAK_COUNT //Number of peaks
+};
+
+//Operations timed
+enum MetricTimerId {
+  METRIC_VISIT_TIME, //Browser::Visit
+  METRIC_BACK_TIME, //Browser::Back
+  METRIC_FORWARD_TIME, //Browser::Forward
+  METRIC_LOAD_TIME, //Browser::LoadFile
+  METRIC_PUSH_TIME, //Stack push, sampled
+  METRIC_POP_TIME, //Stack pop, sampled
+  METRIC_TIMER_COUNT //Number of timers
+};
+
+//Latencies of one operation in nanoseconds. Bucket i holds the values
+//after GetBucketHigh(i - 1) up to GetBucketHigh(i), so a percentile is
+//known to within a quarter of its power of two.
+struct LatencyHistogram {
+  uint64_t m_count; //Operations timed
+  uint64_t m_total; //Sum of their latencies
+  uint64_t m_max; //Slowest one
+  uint64_t m_buckets[METRIC_BUCKETS]; //Operations per bucket
+};
+
+//Everything recorded, summed over every thread
+struct MetricsSnapshot {
+  uint64_t m_counters[METRIC_COUNTER_COUNT]; //Indexed by MetricCounter
+  uint64_t m_peaks[METRIC_PEAK_COUNT]; //Indexed by MetricPeak
+  LatencyHistogram m_timers[METRIC_TIMER_COUNT]; //Indexed by MetricTimerId
+  size_t m_backDepth; //Back history of the Browser that took the snapshot
+  size_t m_forwardDepth; //Forward history of the Browser that took the snapshot
+};
+
+//One thread's metrics. Only the owning thread writes, so updates are a
+//relaxed load and store with no read-modify-write, on a cache line no
+//other thread writes. Readers load the same atomics relaxed.
+struct alignas(64) MetricsShard {
+  atomic<uint64_t> m_counters[METRIC_COUNTER_COUNT];
+  atomic<uint64_t> m_peaks[METRIC_PEAK_COUNT];
+  atomic<uint64_t> m_timerCounts[METRIC_TIMER_COUNT];
+  atomic<uint64_t> m_timerTotals[METRIC_TIMER_COUNT];
+  atomic<uint64_t> m_timerMax[METRIC_TIMER_COUNT];
+  atomic<uint64_t> m_buckets[METRIC_TIMER_COUNT][METRIC_BUCKETS];
+  uint64_t m_samples; //Sampled timers started on this thread
+};
+
+// Name: ReadMetrics
+// Description: Sums every thread's metrics, including threads that have
+//              exited, into snapshot. Depths are left 0.
+// Preconditions: None
+// Postconditions: Operations in progress may be partly counted
+void ReadMetrics(MetricsSnapshot& snapshot);
+
+// Name: ResetMetrics
+// Description: Zeroes every metric
+// Preconditions: None
+// Postconditions: A value another thread records while this runs may
+//                 survive the reset
+void ResetMetrics();
+
+// Name: WriteMetrics
+// Description: Writes snapshot to out as text, one metric per line, with
+//              the mean, p50, p99 and max of each timer and the load
+//              throughput
+// Preconditions: None
+// Postconditions: None
+void WriteMetrics(const MetricsSnapshot& snapshot, ostream& out);
+
+// Name: GetPercentile
+// Description: Returns the highest latency in the bucket holding the
+//              operation slower than share of the others
+// Preconditions: 0 <= share <= 1
+// Postconditions: Returns 0 if nothing was timed
+uint64_t GetPercentile(const LatencyHistogram& histogram, double share);
+
+// Name: GetBucketHigh
+// Description: Returns the highest latency bucket holds
+// Preconditions: bucket < METRIC_BUCKETS
+// Postconditions: None
+uint64_t GetBucketHigh(size_t bucket);
+
+// Name: GetMetricBucket
+// Description: Returns the histogram bucket of a latency
+// Preconditions: None
+// Postconditions: Returns a value < METRIC_BUCKETS
+inline size_t GetMetricBucket(uint64_t nanoseconds){
+    if (nanoseconds < METRIC_SUB_BUCKETS){ //one bucket per value
+        return static_cast<size_t>(nanoseconds);
+    }
+#if defined(__GNUC__)
+    size_t top = 63 - __builtin_clzll(nanoseconds); //highest set bit
+#else
+    size_t top = 63;
+    while ((nanoseconds >> top) == 0){
+        top--;
+    }
+#endif
+    size_t bucket = (top - 1) * METRIC_SUB_BUCKETS + ((nanoseconds >> (top - 2)) & (METRIC_SUB_BUCKETS - 1));
+    return (bucket < METRIC_BUCKETS) ? bucket : METRIC_BUCKETS - 1;
+}
+
+#if USE_METRICS
+
+extern thread_local MetricsShard* t_metrics; //This thread's shard, nullptr until first used
+
+// Name: AttachMetrics
+// Description: Gives the calling thread a shard that ReadMetrics can see
+// Preconditions: t_metrics is nullptr
+// Postconditions: Returns t_metrics. The shard is folded into the totals
+//                 when the thread exits.
+MetricsShard* AttachMetrics();
+
+// Name: GetMetrics
+// Description: Returns the calling thread's shard
+// Preconditions: None
+// Postconditions: None
+inline MetricsShard& GetMetrics(){
+    MetricsShard* shard = t_metrics;
+    return *((shard != nullptr) ? shard : AttachMetrics());
+}
+
+// Name: CountMetric
+// Description: Adds amount to counter
+// Preconditions: None
+// Postconditions: None
+inline void CountMetric(MetricCounter counter, uint64_t amount = 1){
+    atomic<uint64_t>& value = GetMetrics().m_counters[counter];
+    value.store(value.load(memory_order_relaxed) + amount, memory_order_relaxed);
+}
+
+// Name: PeakMetric
+// Description: Raises peak to value if value is larger
+// Preconditions: None
+// Postconditions: None
+inline void PeakMetric(MetricPeak peak, uint64_t value){
+    atomic<uint64_t>& most = GetMetrics().m_peaks[peak];
+    if (value > most.load(memory_order_relaxed)){
+        most.store(value, memory_order_relaxed);
+    }
+}
+
+// Name: TimeMetric
+// Description: Adds one latency to timer's histogram
+// Preconditions: None
+// Postconditions: None
+inline void TimeMetric(MetricTimerId timer, uint64_t nanoseconds){
+    MetricsShard& shard = GetMetrics();
+    atomic<uint64_t>& bucket = shard.m_buckets[timer][GetMetricBucket(nanoseconds)];
+    bucket.store(bucket.load(memory_order_relaxed) + 1, memory_order_relaxed);
+    shard.m_timerCounts[timer].store(shard.m_timerCounts[timer].load(memory_order_relaxed) + 1,
+                                     memory_order_relaxed);
+    shard.m_timerTotals[timer].store(shard.m_timerTotals[timer].load(memory_order_relaxed) + nanoseconds,
+                                     memory_order_relaxed);
+    if (nanoseconds > shard.m_timerMax[timer].load(memory_order_relaxed)){
+        shard.m_timerMax[timer].store(nanoseconds, memory_order_relaxed);
+    }
+}
+
+//Times the scope it is declared in. With sampleEvery above 1 only one
+//scope in sampleEvery per thread reads the clock, for operations that
+//take about as long as a clock read.
+class MetricTimer {
+ public:
+  // Name: MetricTimer (Overloaded constructor)
+  // Description: Starts timing unless this scope is skipped by sampling
+  // Preconditions: sampleEvery is greater than 0
+  // Postconditions: None
+  MetricTimer(MetricTimerId timer, uint64_t sampleEvery = 1)
+    :m_timer(timer),m_timed(sampleEvery == 1 || ++GetMetrics().m_samples % sampleEvery == 0){
+      if (m_timed){
+          m_start = chrono::steady_clock::now();
+      }
+  }
+  // Name: ~MetricTimer (Destructor)
+  // Description: Records the time since the constructor
+  // Preconditions: None
+  // Postconditions: None
+  ~MetricTimer(){
+      if (m_timed){
+          chrono::steady_clock::duration spent = chrono::steady_clock::now() - m_start;
+          TimeMetric(m_timer, static_cast<uint64_t>(chrono::duration_cast<chrono::nanoseconds>(spent).count()));
+      }
+  }
+
+  MetricTimer(const MetricTimer&) = delete; //Times one scope
+  MetricTimer& operator=(const MetricTimer&) = delete;
+ private:
+  MetricTimerId m_timer; //Histogram the time goes to
+  bool m_timed; //False when sampling skips this scope
+  chrono::steady_clock::time_point m_start; //When the scope started
+};
+
+#else
+
+inline void CountMetric(MetricCounter, uint64_t = 1){}
+inline void PeakMetric(MetricPeak, uint64_t){}
+inline void TimeMetric(MetricTimerId, uint64_t){}
+
+//Compiled out: holds nothing and reads no clock
+class MetricTimer {
+ public:
+  MetricTimer(MetricTimerId, uint64_t = 1){}
+  MetricTimer(const MetricTimer&) = delete;
+  MetricTimer& operator=(const MetricTimer&) = delete;
+};
+
+#endif
+
+#endif
@@ -13,38 +13,74 @@
 // Postconditions: Creates a new NavigationEntry object
 NavigationEntry::NavigationEntry(){
     m_url = ""; //empty string
+    m_urlLength = 0;
+    m_urlId = 0;
     m_timeStamp = 0;
 }
 
 // Name: NavigationEntry (Overloaded constructor)
-// Description: Creates a new NavigationEntry with a string and an int timestamp
-// Preconditions: None
+// Description: Creates a new NavigationEntry with an interned URL and a
+//              timestamp in milliseconds since the epoch
+// Preconditions: url is owned by a UrlTable (or other storage) that
+//                outlives the entry
 // Postconditions: Creates a new NavigationEntry object
-NavigationEntry::NavigationEntry(const string& url, const int& timestamp)
-    :m_url(url),m_timeStamp(timestamp){}
+NavigationEntry::NavigationEntry(string_view url, UrlId urlId, const int64_t& timestamp)
+    :m_url(url.data()),m_urlLength(static_cast<uint32_t>(url.size())),m_urlId(urlId),
+     m_timeStamp(timestamp){}
 
 // GETTERS
 
-string NavigationEntry::GetURL() const{return m_url;} //Returns the m_url
-int NavigationEntry::GetTimeStamp() const{return m_timeStamp;} //Returns m_timeStamp
+string NavigationEntry::GetURL() const{return string(m_url, m_urlLength);} //Returns a copy of m_url
+//Returns m_url without copying
+string_view NavigationEntry::GetURLView() const{return string_view(m_url, m_urlLength);}
+UrlId NavigationEntry::GetURLId() const{return m_urlId;} //Returns m_urlId
+int64_t NavigationEntry::GetTimeStamp() const{return m_timeStamp;} //Returns m_timeStamp
 
 // SETTERS
   
-void NavigationEntry::SetURL(const string& url){m_url = url;} //Used to set m_url
-void NavigationEntry::SetTimeStamp(const int& time){m_timeStamp = time;} //Used to set m_timeStamp
+//Used to set m_url and m_urlId
+void NavigationEntry::SetURL(string_view url, UrlId urlId){
+    m_url = url.data();
+    m_urlLength = static_cast<uint32_t>(url.size());
+    m_urlId = urlId;
+}
+void NavigationEntry::SetTimeStamp(const int64_t& time){m_timeStamp = time;} //Used to set m_timeStamp
 
 // Name: IsEmpty
 // Description: Returns true if m_url is empty
 // Preconditions: None
 // Postconditions: Returns true if m_url is empty else false
-bool NavigationEntry::IsEmpty() const{return m_url == "";}
+bool NavigationEntry::IsEmpty() const{return m_urlLength == 0;}
+
+// Name: DisplayTimeStamp (Provided)
+// Description: Converts
+// Preconditions: Pass it a timestamp in milliseconds (up to 64 bits)
+// Postconditions: Returns the string equivalent of the date/time
+string NavigationEntry::DisplayTimeStamp(int64_t timestamp) const{
+    char buffer[TIME_TEXT_LENGTH + 1];
+    return string(buffer, DisplayTimeStamp(timestamp, buffer));
+}
+
+// Name: DisplayTimeStamp (buffer)
+// Description: Writes the date/time text of timestamp into buffer without
+//              allocating. Safe to call from several threads at once.
+// Preconditions: buffer has room for TIME_TEXT_LENGTH + 1 characters
+// Postconditions: buffer holds the null terminated text; returns its length
+size_t NavigationEntry::DisplayTimeStamp(int64_t timestamp, char* buffer) const{
+    static thread_local TimeFormatter formatter; //keeps each thread's day and minute cache
+    formatter.Format(timestamp, buffer);
+    buffer[TIME_TEXT_LENGTH] = '\0';
+    return TIME_TEXT_LENGTH;
+}
 
 // Name: Overloaded <<
 // Description: Prints the details of a navigation entry
 // Preconditions: None
 // Postconditions: Returns an ostream with output of a navigation entry
 // Sample output: URL:http://daler.org/ Visited On: 2018-03-02 16:48:00
-ostream& operator<<(ostream& out, NavigationEntry& entry){
-    out << "URL:" << entry.GetURL() << " Visited On: " << entry.DisplayTimeStamp(entry.GetTimeStamp()) << endl;
+ostream& operator<<(ostream& out, const NavigationEntry& entry){
+    char time[TIME_TEXT_LENGTH + 1];
+    size_t length = entry.DisplayTimeStamp(entry.GetTimeStamp(), time);
+    out << "URL:" << entry.GetURLView() << " Visited On: " << string_view(time, length) << endl;
     return out; 
-} 
\ No newline at end of file
+}
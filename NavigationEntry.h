@@ -6,8 +6,12 @@
 #ifndef NAVIGATION_ENTRY_H //Header guards
 #define NAVIGATION_ENTRY_H //Header guards
 
+#include <iostream>
 #include <string>
+#include <string_view>
 #include <chrono>  // for timestamps
+#include "UrlTable.h"
+#include "TimeFormatter.h"
 using namespace std;
 
 //Constants
@@ -17,19 +21,22 @@ class NavigationEntry {
   // Constructors
   NavigationEntry();
   // Name: NavigationEntry (Overloaded constructor)
-  // Description: Creates a new NavigationEntry with a string and an int tim\
-estamp
-  // Preconditions: None
+  // Description: Creates a new NavigationEntry with an interned URL and a
+  //              timestamp in milliseconds since the epoch
+  // Preconditions: url is owned by a UrlTable (or other storage) that
+  //                outlives the entry
   // Postconditions: Creates a new NavigationEntry object
-  NavigationEntry(const string& url, const int& timestamp);
+  NavigationEntry(string_view url, UrlId urlId, const int64_t& timestamp);
 
   // Accessors (Getters)
-  string GetURL() const; //Returns the m_url
-  int GetTimeStamp() const; //Returns m_timeStamp
+  string GetURL() const; //Returns a copy of m_url
+  string_view GetURLView() const; //Returns m_url without copying
+  UrlId GetURLId() const; //Returns m_urlId
+  int64_t GetTimeStamp() const; //Returns m_timeStamp
 
   // Mutators (Setters)
-  void SetURL(const string& url); //Used to set m_url
-  void SetTimeStamp(const int& time); //Used to set m_timeStamp
+  void SetURL(string_view url, UrlId urlId); //Used to set m_url and m_urlId
+  void SetTimeStamp(const int64_t& time); //Used to set m_timeStamp
 
   // Name: IsEmpty
   // Description: Returns true if m_url is empty
@@ -38,28 +45,27 @@ estamp
   bool IsEmpty() const;
  // Name: DisplayTimeStamp (Provided)
   // Description: Converts
-  // Preconditions: Pass it an integer (up to 64 bits)
+  // Preconditions: Pass it a timestamp in milliseconds (up to 64 bits)
   // Postconditions: Returns the string equivalent of the date/time
-  string DisplayTimeStamp(int64_t timestamp){
-    // Convert integer timestamp to time_t
-    time_t time = static_cast<time_t>(timestamp);
-    // Convert time_t to tm structure for local time
-    tm* localTime = localtime(&time);
-    char buffer[80];
-    // Format the date and time
-    strftime(buffer, sizeof(buffer), "%Y-%m-%d %H:%M:%S", localTime);
-    // Cast formatted output as string and return
-    return string(buffer);
-  }
+  string DisplayTimeStamp(int64_t timestamp) const;
+  // Name: DisplayTimeStamp (buffer)
+  // Description: Writes the date/time text of timestamp into buffer without
+  //              allocating. Safe to call from several threads at once.
+  // Preconditions: buffer has room for TIME_TEXT_LENGTH + 1 characters
+  // Postconditions: buffer holds the null terminated text; returns its length
+  size_t DisplayTimeStamp(int64_t timestamp, char* buffer) const;
   // Name: Overloaded <<
   // Description: Prints the details of a navigation entry
   // Preconditions: None
   // Postconditions: Returns an ostream with output of a navigation entry
   // Sample output: URL:http://daler.org/ Visited On: 2018-03-02 16:48:00
-  friend ostream& operator<<(ostream&, NavigationEntry&);
+  friend ostream& operator<<(ostream&, const NavigationEntry&);
  private:
-  string m_url;    // URL of the visited website
-  int m_timeStamp; // Timestamp of the visit
+  //m_url is split into pointer and length so the entry stays 24 bytes
+  const char* m_url;     // URL of the visited website (owned by a UrlTable)
+  uint32_t m_urlLength;  // Length of m_url
+  UrlId m_urlId;         // ID of m_url in its UrlTable
+  int64_t m_timeStamp;   // Timestamp of the visit in milliseconds
 };
 
 #endif // NAVIGATION_ENTRY_H
@@ -0,0 +1,362 @@
+/*Title: PersistentStack.cpp
+  Author: Shariq Moghees
+  Date: 10/17/2026
+  Description: This class defines a templated persistent stack. Nodes are
+               immutable and reference counted, so copying a stack takes
+               constant time and the copies share every node. Pushing or
+               popping on one copy never changes another.
+*/
+#ifndef PERSISTENT_STACK_CPP //Header guards
+#define PERSISTENT_STACK_CPP //Header guards
+
+#include <atomic>
+#include <cstdint>
+#include <stdexcept>
+#include <utility>
+#include "Metrics.h"
+using namespace std;
+
+//**********PersistentStack Class Declaration***********
+template <typename T> //Indicates persistent stack is templated
+class PersistentStack {
+public:
+  // Name: PersistentStack (Default constructor)
+  // Description: Creates a new empty PersistentStack object
+  // Preconditions: None
+  // Postconditions: Creates a new PersistentStack object
+  PersistentStack();
+  // Name: ~PersistentStack
+  // Description: PersistentStack destructor - drops this stack's reference
+  //              to its top node. Nodes no other stack holds are deleted.
+  // Preconditions: None
+  // Postconditions: Size is 0. No memory leaks.
+  ~PersistentStack();
+  // Name: PersistentStack (Copy constructor)
+  // Description: Creates a stack that shares every node of source in
+  //              constant time
+  // Preconditions: None
+  // Postconditions: Both stacks hold the same items
+  PersistentStack(const PersistentStack& source);
+  // Name: PersistentStack (Move constructor)
+  // Description: Takes the nodes of source without touching reference counts
+  // Preconditions: None
+  // Postconditions: source is empty
+  PersistentStack(PersistentStack&& source);
+  // Name: PersistentStack<T>& operator= (Assignment operator)
+  // Description: Drops this stack's nodes and shares other's in constant
+  //              time (apart from deleting nodes nothing else holds)
+  // Preconditions: None
+  // Postconditions: Both stacks hold the same items
+  PersistentStack<T>& operator=(const PersistentStack& other);
+  // Name: PersistentStack<T>& operator= (Move assignment operator)
+  // Description: Drops this stack's nodes and takes other's
+  // Preconditions: None
+  // Postconditions: other is empty
+  PersistentStack<T>& operator=(PersistentStack&& other);
+  // Name: Push
+  // Description: Adds a new node on top of this stack. The nodes below are
+  //              shared, not copied.
+  // Preconditions: None
+  // Postconditions: Adds a new node to the top of this stack only
+  void Push(const T& value);
+  // Name: Push (move)
+  // Description: Same as Push but moves value into the new node
+  // Preconditions: None
+  // Postconditions: Adds a new node to the top of this stack only
+  void Push(T&& value);
+  // Name: Pop
+  // Description: If stack is empty, throw runtime_error("Stack is empty");
+  //              Moves this stack down one node and returns a copy of the
+  //              data that was on top. Other stacks sharing the node keep it.
+  // Preconditions: Stack has at least one node
+  // Postconditions: See description
+  T Pop();
+  // Name: Drop
+  // Description: Moves this stack down count nodes without copying them
+  // Preconditions: count is at most GetSize()
+  // Postconditions: Size is count less
+  void Drop(size_t count);
+  // Name: Peek
+  // Description: If stack is empty, throw runtime_error("Stack is empty");
+  //              Returns the top node's data. The reference stays valid
+  //              until this stack is changed or destroyed.
+  // Preconditions: Stack has at least one node
+  // Postconditions: See description
+  const T& Peek() const;
+  // Name: At
+  // Description: If stack is empty, throw runtime_error("Stack is empty")
+  //              Returns the data num nodes below the top. At(3) would
+  //              return the data from the fourth node.
+  // Preconditions: Stack has more than num nodes
+  // Postconditions: Returns data from number of node starting at the top
+  const T& At(size_t num) const;
+  // Name: IsEmpty
+  // Description: Returns if the stack has any nodes.
+  // Preconditions: None
+  // Postconditions: If stack has no nodes, returns true. Else false.
+  bool IsEmpty() const;
+  // Name: ForEach
+  // Description: Calls visit with the data of the top count nodes (every
+  //              node by default), starting at the top
+  // Preconditions: None
+  // Postconditions: Stack is unchanged
+  template <typename F>
+  void ForEach(F visit, size_t count = SIZE_MAX) const;
+  // Name: GetSize
+  // Description: Returns the number of nodes in the stack in constant time
+  // Preconditions: None
+  // Postconditions: Returns the number of nodes in the stack.
+  size_t GetSize() const;
+private:
+  //Immutable once pushed. m_refs counts the stacks and nodes pointing here.
+  struct Node {
+    T m_data; //Item stored in the node
+    Node* m_next; //Node below (this node holds one reference to it)
+    size_t m_size; //Nodes from here to the bottom
+    atomic<size_t> m_refs; //References to this node
+
+    // Name: Node (Overloaded constructor)
+    // Description: Creates a node holding data on top of next
+    // Preconditions: This node takes over a reference to next
+    // Postconditions: m_refs is 1
+    template <typename U>
+    Node(U&& data, Node* next)
+      :m_data(std::forward<U>(data)),m_next(next),m_size((next == nullptr) ? 1 : next->m_size + 1),m_refs(1){}
+  };
+
+  // Name: Acquire
+  // Description: Adds a reference to node
+  // Preconditions: None
+  // Postconditions: None
+  static void Acquire(Node* node);
+  // Name: Release
+  // Description: Drops a reference to node. A node left without references
+  //              is deleted and drops its reference to the node below, in a
+  //              loop so a long chain does not recurse.
+  // Preconditions: The caller held a reference to node (or node is nullptr)
+  // Postconditions: None
+  static void Release(Node* node);
+
+  Node* m_top; //Top node of this stack (holds one reference)
+};
+
+//*********************PERSISTENTSTACK FUNCTIONS IMPLEMENTED HERE******************
+
+// Name: PersistentStack (Default constructor)
+// Description: Creates a new empty PersistentStack object
+// Preconditions: None
+// Postconditions: Creates a new PersistentStack object
+template <typename T>
+PersistentStack<T>::PersistentStack()
+  :m_top(nullptr){}
+
+// Name: ~PersistentStack
+// Description: PersistentStack destructor - drops this stack's reference
+//              to its top node. Nodes no other stack holds are deleted.
+// Preconditions: None
+// Postconditions: Size is 0. No memory leaks.
+template <typename T>
+PersistentStack<T>::~PersistentStack(){
+  Release(m_top);
+  m_top = nullptr;
+}
+
+// Name: PersistentStack (Copy constructor)
+// Description: Creates a stack that shares every node of source in
+//              constant time
+// Preconditions: None
+// Postconditions: Both stacks hold the same items
+template <typename T>
+PersistentStack<T>::PersistentStack(const PersistentStack& source)
+  :m_top(source.m_top){
+  Acquire(m_top);
+}
+
+// Name: PersistentStack (Move constructor)
+// Description: Takes the nodes of source without touching reference counts
+// Preconditions: None
+// Postconditions: source is empty
+template <typename T>
+PersistentStack<T>::PersistentStack(PersistentStack&& source)
+  :m_top(source.m_top){
+  source.m_top = nullptr;
+}
+
+// Name: PersistentStack<T>& operator= (Assignment operator)
+// Description: Drops this stack's nodes and shares other's in constant
+//              time (apart from deleting nodes nothing else holds)
+// Preconditions: None
+// Postconditions: Both stacks hold the same items
+template <typename T>
+PersistentStack<T>& PersistentStack<T>::operator=(const PersistentStack& other){
+  Acquire(other.m_top); //first, in case other's nodes are only held through this stack
+  Release(m_top);
+  m_top = other.m_top;
+  return *this;
+}
+
+// Name: PersistentStack<T>& operator= (Move assignment operator)
+// Description: Drops this stack's nodes and takes other's
+// Preconditions: None
+// Postconditions: other is empty
+template <typename T>
+PersistentStack<T>& PersistentStack<T>::operator=(PersistentStack&& other){
+  if (this != &other){
+    Release(m_top);
+    m_top = other.m_top;
+    other.m_top = nullptr;
+  }
+  return *this;
+}
+
+// Name: Push
+// Description: Adds a new node on top of this stack. The nodes below are
+//              shared, not copied.
+// Preconditions: None
+// Postconditions: Adds a new node to the top of this stack only
+template <typename T>
+void PersistentStack<T>::Push(const T& value){
+  MetricTimer timer(METRIC_PUSH_TIME, METRIC_SAMPLE_EVERY);
+  m_top = new Node(value, m_top); //the new node takes over this stack's reference
+  CountMetric(METRIC_PUSHES);
+  PeakMetric(METRIC_PEAK_STACK, m_top->m_size);
+}
+
+// Name: Push (move)
+// Description: Same as Push but moves value into the new node
+// Preconditions: None
+// Postconditions: Adds a new node to the top of this stack only
+template <typename T>
+void PersistentStack<T>::Push(T&& value){
+  MetricTimer timer(METRIC_PUSH_TIME, METRIC_SAMPLE_EVERY);
+  m_top = new Node(std::move(value), m_top);
+  CountMetric(METRIC_PUSHES);
+  PeakMetric(METRIC_PEAK_STACK, m_top->m_size);
+}
+
+// Name: Pop
+// Description: If stack is empty, throw runtime_error("Stack is empty");
+//              Moves this stack down one node and returns a copy of the
+//              data that was on top. Other stacks sharing the node keep it.
+// Preconditions: Stack has at least one node
+// Postconditions: See description
+template <typename T>
+T PersistentStack<T>::Pop(){
+  MetricTimer timer(METRIC_POP_TIME, METRIC_SAMPLE_EVERY);
+  if (m_top == nullptr){ //If empty error
+    throw runtime_error("Stack is empty.");
+  }
+  T data = m_top->m_data;
+  Drop(1);
+  CountMetric(METRIC_POPS);
+  return data;
+}
+
+// Name: Drop
+// Description: Moves this stack down count nodes without copying them
+// Preconditions: count is at most GetSize()
+// Postconditions: Size is count less
+template <typename T>
+void PersistentStack<T>::Drop(size_t count){
+  if (count == 0){
+    return;
+  }
+  Node* below = m_top;
+  for (size_t i = 0; i < count; i++){ //walk down without touching the counts
+    below = below->m_next;
+  }
+  Acquire(below); //before the release, which may delete the nodes above it
+  Release(m_top);
+  m_top = below;
+}
+
+// Name: Peek
+// Description: If stack is empty, throw runtime_error("Stack is empty");
+//              Returns the top node's data. The reference stays valid
+//              until this stack is changed or destroyed.
+// Preconditions: Stack has at least one node
+// Postconditions: See description
+template <typename T>
+const T& PersistentStack<T>::Peek() const{
+  if (m_top == nullptr){
+    throw runtime_error("Stack is empty");
+  }
+  return m_top->m_data;
+}
+
+// Name: At
+// Description: If stack is empty, throw runtime_error("Stack is empty")
+//              Returns the data num nodes below the top. At(3) would
+//              return the data from the fourth node.
+// Preconditions: Stack has more than num nodes
+// Postconditions: Returns data from number of node starting at the top
+template <typename T>
+const T& PersistentStack<T>::At(size_t num) const{
+  if (m_top == nullptr){ //if empty
+    throw runtime_error("Stack is empty");
+  }
+  Node* curr = m_top;
+  for (size_t i = 0; i < num; i++){ //iterate until we get to index num
+    curr = curr->m_next;
+  }
+  return curr->m_data;
+}
+
+// Name: IsEmpty
+// Description: Returns if the stack has any nodes.
+// Preconditions: None
+// Postconditions: If stack has no nodes, returns true. Else false.
+template <typename T>
+bool PersistentStack<T>::IsEmpty() const{return m_top == nullptr;}
+
+// Name: ForEach
+// Description: Calls visit with the data of the top count nodes (every
+//              node by default), starting at the top
+// Preconditions: None
+// Postconditions: Stack is unchanged
+template <typename T>
+template <typename F>
+void PersistentStack<T>::ForEach(F visit, size_t count) const{
+  for (Node* curr = m_top; curr != nullptr && count > 0; curr = curr->m_next){
+    visit(curr->m_data);
+    count--;
+  }
+}
+
+// Name: GetSize
+// Description: Returns the number of nodes in the stack in constant time
+// Preconditions: None
+// Postconditions: Returns the number of nodes in the stack.
+template <typename T>
+size_t PersistentStack<T>::GetSize() const{
+  return (m_top == nullptr) ? 0 : m_top->m_size;
+}
+
+// Name: Acquire
+// Description: Adds a reference to node
+// Preconditions: None
+// Postconditions: None
+template <typename T>
+void PersistentStack<T>::Acquire(Node* node){
+  if (node != nullptr){
+    node->m_refs.fetch_add(1, memory_order_relaxed); //the caller already holds one
+  }
+}
+
+// Name: Release
+// Description: Drops a reference to node. A node left without references
+//              is deleted and drops its reference to the node below, in a
+//              loop so a long chain does not recurse.
+// Preconditions: The caller held a reference to node (or node is nullptr)
+// Postconditions: None
+template <typename T>
+void PersistentStack<T>::Release(Node* node){
+  //acq_rel so every fork's reads of a node finish before it is deleted
+  while (node != nullptr && node->m_refs.fetch_sub(1, memory_order_acq_rel) == 1){
+    Node* next = node->m_next;
+    delete node;
+    node = next;
+  }
+}
+
+#endif
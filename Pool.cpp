@@ -0,0 +1,174 @@
+/*Title: Pool.cpp
+  Author: Shariq Moghees
+  Date: 10/17/2026
+  Description: This class defines a templated slab allocator. Objects are
+               carved out of large blocks and released objects go on a free
+               list so their slots are reused by the next allocation.
+*/
+#ifndef POOL_CPP //Header guards
+#define POOL_CPP //Header guards
+
+#include <new>
+#include <utility>
+#include <vector>
+#include "Metrics.h"
+using namespace std;
+
+//Constants
+const size_t POOL_BLOCK_SIZE = 1024; //Default number of objects per block
+
+//Build with -DUSE_POOL=0 to make Allocate and Release plain new and delete,
+//the baseline the pools are benchmarked against. Nothing is freed in blocks
+//then, so the owner must release every object before the pool goes away
+#ifndef USE_POOL
+#define USE_POOL 1
+#endif
+
+//**********Pool Class Declaration***********
+template <typename T> //Indicates pool is templated
+class Pool {
+public:
+  // Name: Pool (Overloaded constructor)
+  // Description: Creates an empty pool that allocates blockSize objects at a time
+  // Preconditions: blockSize is greater than 0
+  // Postconditions: Creates a new Pool with no blocks allocated
+  Pool(size_t blockSize = POOL_BLOCK_SIZE);
+  // Name: ~Pool
+  // Description: Releases every block at once. Objects still allocated are
+  //              not destructed, so release them first unless T is trivially
+  //              destructible.
+  // Preconditions: None
+  // Postconditions: All blocks are deallocated
+  ~Pool();
+  // Name: Allocate
+  // Description: Constructs a T from args in a free slot, taking a slot from
+  //              the free list first and starting a new block when needed
+  // Preconditions: None
+  // Postconditions: Returns a pointer to the new object
+  template <typename... Args>
+  T* Allocate(Args&&... args);
+  // Name: Release
+  // Description: Destructs the object and puts its slot on the free list
+  // Preconditions: item was returned by Allocate on this pool (or nullptr)
+  // Postconditions: Slot is available for the next Allocate
+  void Release(T* item);
+  // Name: GetLiveCount
+  // Description: Returns the number of objects currently allocated
+  // Preconditions: None
+  // Postconditions: None
+  size_t GetLiveCount() const;
+  // Name: GetBlockCount
+  // Description: Returns the number of blocks the pool has allocated
+  // Preconditions: None
+  // Postconditions: None
+  size_t GetBlockCount() const;
+private:
+  //One object-sized slot. Holds the free list link while the slot is unused
+  union Slot {
+    Slot* m_next;
+    alignas(T) unsigned char m_storage[sizeof(T)];
+  };
+
+  Pool(const Pool&) = delete; //Pools own their blocks and are never copied
+  Pool& operator=(const Pool&) = delete;
+
+  vector<Slot*> m_blocks; //Every block allocated by this pool
+  Slot* m_freeList; //Released slots waiting to be reused
+  size_t m_blockSize; //Number of slots in each block
+  size_t m_blockUsed; //Slots handed out from the newest block
+  size_t m_live; //Objects currently allocated
+};
+
+//*********************POOL FUNCTIONS IMPLEMENTED HERE******************
+
+// Name: Pool (Overloaded constructor)
+// Description: Creates an empty pool that allocates blockSize objects at a time
+// Preconditions: blockSize is greater than 0
+// Postconditions: Creates a new Pool with no blocks allocated
+template <typename T>
+Pool<T>::Pool(size_t blockSize)
+  :m_freeList(nullptr),m_blockSize(blockSize),m_blockUsed(blockSize),m_live(0){}
+
+// Name: ~Pool
+// Description: Releases every block at once. Objects still allocated are
+//              not destructed, so release them first unless T is trivially
+//              destructible.
+// Preconditions: None
+// Postconditions: All blocks are deallocated
+template <typename T>
+Pool<T>::~Pool(){
+  for (size_t i = 0; i < m_blocks.size(); i++){
+    delete[] m_blocks[i];
+  }
+  m_blocks.clear();
+  m_freeList = nullptr;
+  m_live = 0;
+}
+
+// Name: Allocate
+// Description: Constructs a T from args in a free slot, taking a slot from
+//              the free list first and starting a new block when needed
+// Preconditions: None
+// Postconditions: Returns a pointer to the new object
+template <typename T>
+template <typename... Args>
+T* Pool<T>::Allocate(Args&&... args){
+#if USE_POOL
+  Slot* slot;
+  if (m_freeList != nullptr){ //reuse a released slot
+    slot = m_freeList;
+    m_freeList = slot->m_next;
+  }
+  else{
+    if (m_blockUsed == m_blockSize){ //newest block is full
+      m_blocks.push_back(new Slot[m_blockSize]);
+      m_blockUsed = 0;
+      CountMetric(METRIC_BLOCKS);
+    }
+    slot = &m_blocks.back()[m_blockUsed];
+    m_blockUsed++;
+  }
+  T* item = new (slot->m_storage) T(std::forward<Args>(args)...);
+#else
+  T* item = new T(std::forward<Args>(args)...);
+#endif
+  m_live++;
+  CountMetric(METRIC_ALLOCATIONS);
+  return item;
+}
+
+// Name: Release
+// Description: Destructs the object and puts its slot on the free list
+// Preconditions: item was returned by Allocate on this pool (or nullptr)
+// Postconditions: Slot is available for the next Allocate
+template <typename T>
+void Pool<T>::Release(T* item){
+  if (item == nullptr){ //same as delete nullptr
+    return;
+  }
+#if USE_POOL
+  item->~T();
+  Slot* slot = reinterpret_cast<Slot*>(item);
+  slot->m_next = m_freeList;
+  m_freeList = slot;
+#else
+  delete item;
+#endif
+  m_live--;
+}
+
+// Name: GetLiveCount
+// Description: Returns the number of objects currently allocated
+// Preconditions: None
+// Postconditions: None
+template <typename T>
+size_t Pool<T>::GetLiveCount() const{return m_live;}
+
+// Name: GetBlockCount
+// Description: Returns the number of blocks the pool has allocated
+// Preconditions: None
+// Postconditions: None
+template <typename T>
+size_t Pool<T>::GetBlockCount() const{return m_blocks.size();}
+
+#endif
@@ -0,0 +1,404 @@
+/*Title: RingStack.cpp
+  Author: Shariq Moghees
+  Date: 10/17/2026
+  Description: This class defines a templated stack using a growable circular
+               array. It has the same interface as Stack but does not allocate
+               per push, and At and RemoveBottom run in constant time.
+*/
+#ifndef RING_STACK_CPP //Header guards
+#define RING_STACK_CPP //Header guards
+
+#include <iostream>
+#include <stdexcept>
+#include <utility>
+#include "Metrics.h"
+using namespace std;
+
+//Constants
+const size_t RING_STACK_MIN_CAPACITY = 16; //Starting number of slots (power of 2)
+
+//**********RingStack Class Declaration***********
+template <typename T> //Indicates ring stack is templated
+class RingStack {
+public:
+  // Name: RingStack (Default constructor)
+  // Description: Creates a new RingStack object
+  // Preconditions: None
+  // Postconditions: Creates a new RingStack object with no slots allocated
+  RingStack();
+  // Name: ~RingStack
+  // Description: RingStack destructor - deallocates the slot array
+  // Preconditions: None
+  // Postconditions: Slot array is deleted. Size is 0. No memory leaks.
+  ~RingStack();
+  // Name: RingStack (Copy constructor)
+  // Description: Creates a new RingStack object based on existing stack
+  // Preconditions: None
+  // Postconditions: Creates a new RingStack object from existing stack
+  //                 in separate memory space
+  RingStack(const RingStack& source);
+  // Name: RingStack<T>& operator= (Assignment operator)
+  // Description: Makes two stacks identical based on source.
+  // Preconditions: None
+  // Postconditions: Two stacks with same number of items and same values
+  //                 in a separate memory space
+  RingStack<T>& operator=(const RingStack& other);
+  // Name: Push
+  // Description: Adds a new item to the top of the stack. Doubles the slot
+  //              array when it is full (amortized constant time)
+  // Preconditions: None
+  // Postconditions: Adds a new item to the top of the stack
+  void Push(const T& value);
+  // Name: Push (move)
+  // Description: Same as Push but moves value into its slot
+  // Preconditions: None
+  // Postconditions: Adds a new item to the top of the stack
+  void Push(T&& value);
+  // Name: Emplace
+  // Description: Adds a new item built from args to the top of the stack.
+  //              Slots always hold a T, so the item is moved into its slot.
+  // Preconditions: None
+  // Postconditions: Adds a new item to the top of the stack
+  template <typename... Args>
+  void Emplace(Args&&... args);
+  // Name: Pop
+  // Description: If stack is empty, throw runtime_error("Stack is empty");
+  //              Removes the item at the top of the stack and moves it out.
+  // Preconditions: Stack has at least one item
+  // Postconditions: See description
+  T Pop();
+  // Name: Peek
+  // Description: If stack is empty, throw runtime_error("Stack is empty");
+  //              Returns the item at the top of the stack. The reference
+  //              stays valid until the next Push, Pop or Reserve.
+  // Preconditions: Stack has at least one item
+  // Postconditions: See description
+  const T& Peek() const;
+  // Name: At
+  // Description: If stack is empty, throw runtime_error("Stack is empty")
+  //              Returns the item num places below the top in constant time.
+  //              At(3) would return the fourth item.
+  // Preconditions: Stack has more than num items
+  // Postconditions: Returns data from number of item starting at the top
+  T At(int num) const;
+  // Name: IsEmpty
+  // Description: Returns if the stack has any items.
+  // Preconditions: None
+  // Postconditions: If stack has no items, returns true. Else false.
+  bool IsEmpty() const;
+  // Name: RemoveBottom
+  // Description: If stack is empty, throw runtime_error("Stack is empty")
+  //              Removes the item at the bottom of the stack in constant time
+  //              and moves it out. Similar to Pop but opposite end of stack
+  // Preconditions: Stack has at least one item
+  // Postconditions: Removes item from bottom of stack and returns data
+  T RemoveBottom();
+  // Name: Display
+  // Description: If stack is empty, outputs that the stack is empty
+  //              Otherwise, iterates from the top and displays each item
+  // Preconditions: None
+  // Postconditions: Displays data from each item in stack
+  void Display();
+  // Name: ForEach
+  // Description: Calls visit with the data of each item, starting at the top
+  // Preconditions: None
+  // Postconditions: Stack is unchanged
+  template <typename F>
+  void ForEach(F visit) const;
+  // Name: GetSize
+  // Description: Returns the number of items in the stack
+  // Preconditions: None
+  // Postconditions: Returns the number of items in the stack.
+  size_t GetSize() const;
+  // Name: Reserve
+  // Description: Grows the slot array so count items fit without another
+  //              reallocation
+  // Preconditions: None
+  // Postconditions: m_capacity is at least count
+  void Reserve(size_t count);
+private:
+  // Name: Store
+  // Description: Assigns value to the slot above the top, growing first
+  //              if the slot array is full
+  // Preconditions: None
+  // Postconditions: Adds value to the top of the stack
+  template <typename U>
+  void Store(U&& value);
+  // Name: Grow
+  // Description: Moves the items into a slot array of newCapacity slots and
+  //              unwraps them so the bottom of the stack sits in slot 0
+  // Preconditions: newCapacity is a power of 2 and at least m_size
+  // Postconditions: m_capacity is newCapacity, m_bottom is 0
+  void Grow(size_t newCapacity);
+  // Name: CopyFrom
+  // Description: Copies the items of source into this (empty) stack
+  // Preconditions: This stack has no slot array allocated
+  // Postconditions: Same items in the same order in separate memory space
+  void CopyFrom(const RingStack& source);
+
+  T* m_data; //Slot array (capacity is always a power of 2)
+  size_t m_capacity; //Number of slots in m_data
+  size_t m_bottom; //Slot holding the bottom item of the stack
+  size_t m_size; //Number of items in stack
+};
+
+//*********************RINGSTACK FUNCTIONS IMPLEMENTED HERE******************
+
+// Name: RingStack (Default constructor)
+// Description: Creates a new RingStack object
+// Preconditions: None
+// Postconditions: Creates a new RingStack object with no slots allocated
+template <typename T>
+RingStack<T>::RingStack()
+  :m_data(nullptr),m_capacity(0),m_bottom(0),m_size(0){}
+
+// Name: ~RingStack
+// Description: RingStack destructor - deallocates the slot array
+// Preconditions: None
+// Postconditions: Slot array is deleted. Size is 0. No memory leaks.
+template <typename T>
+RingStack<T>::~RingStack(){
+  delete[] m_data;
+  m_data = nullptr;
+  m_capacity = 0;
+  m_bottom = 0;
+  m_size = 0;
+}
+
+// Name: RingStack (Copy constructor)
+// Description: Creates a new RingStack object based on existing stack
+// Preconditions: None
+// Postconditions: Creates a new RingStack object from existing stack
+//                 in separate memory space
+template <typename T>
+RingStack<T>::RingStack(const RingStack& source)
+  :m_data(nullptr),m_capacity(0),m_bottom(0),m_size(0){
+  CopyFrom(source);
+}
+
+// Name: RingStack<T>& operator= (Assignment operator)
+// Description: Makes two stacks identical based on source.
+// Preconditions: None
+// Postconditions: Two stacks with same number of items and same values
+//                 in a separate memory space
+template <typename T>
+RingStack<T>& RingStack<T>::operator=(const RingStack& other){
+  if (this == &other){ //compare memory addresses
+    return *this;
+  }
+  delete[] m_data; //clear current stack
+  m_data = nullptr;
+  m_capacity = 0;
+  m_bottom = 0;
+  m_size = 0;
+  CopyFrom(other);
+  return *this;
+}
+
+// Name: Push
+// Description: Adds a new item to the top of the stack. Doubles the slot
+//              array when it is full (amortized constant time)
+// Preconditions: None
+// Postconditions: Adds a new item to the top of the stack
+template <typename T>
+void RingStack<T>::Push(const T& value){
+  Store(value);
+}
+
+// Name: Push (move)
+// Description: Same as Push but moves value into its slot
+// Preconditions: None
+// Postconditions: Adds a new item to the top of the stack
+template <typename T>
+void RingStack<T>::Push(T&& value){
+  Store(std::move(value));
+}
+
+// Name: Emplace
+// Description: Adds a new item built from args to the top of the stack.
+//              Slots always hold a T, so the item is moved into its slot.
+// Preconditions: None
+// Postconditions: Adds a new item to the top of the stack
+template <typename T>
+template <typename... Args>
+void RingStack<T>::Emplace(Args&&... args){
+  Store(T(std::forward<Args>(args)...));
+}
+
+// Name: Pop
+// Description: If stack is empty, throw runtime_error("Stack is empty");
+//              Removes the item at the top of the stack and moves it out.
+// Preconditions: Stack has at least one item
+// Postconditions: See description
+template <typename T>
+T RingStack<T>::Pop(){
+  MetricTimer timer(METRIC_POP_TIME, METRIC_SAMPLE_EVERY);
+  if (m_size == 0){
+    throw runtime_error("Stack is empty.");
+  }
+  CountMetric(METRIC_POPS);
+  m_size--; //top slot is now free
+  return std::move(m_data[(m_bottom + m_size) & (m_capacity - 1)]);
+}
+
+// Name: Peek
+// Description: If stack is empty, throw runtime_error("Stack is empty");
+//              Returns the item at the top of the stack. The reference
+//              stays valid until the next Push, Pop or Reserve.
+// Preconditions: Stack has at least one item
+// Postconditions: See description
+template <typename T>
+const T& RingStack<T>::Peek() const{
+  if (m_size == 0){
+    throw runtime_error("Stack is empty");
+  }
+  return m_data[(m_bottom + m_size - 1) & (m_capacity - 1)];
+}
+
+// Name: At
+// Description: If stack is empty, throw runtime_error("Stack is empty")
+//              Returns the item num places below the top in constant time.
+//              At(3) would return the fourth item.
+// Preconditions: Stack has more than num items
+// Postconditions: Returns data from number of item starting at the top
+template <typename T>
+T RingStack<T>::At(int num) const{
+  if (m_size == 0){ //if empty
+    throw runtime_error("Stack is empty");
+  }
+  if (num < 0 || static_cast<size_t>(num) >= m_size){ //past the bottom
+    throw out_of_range("Stack index out of range");
+  }
+  return m_data[(m_bottom + m_size - 1 - num) & (m_capacity - 1)];
+}
+
+// Name: IsEmpty
+// Description: Returns if the stack has any items.
+// Preconditions: None
+// Postconditions: If stack has no items, returns true. Else false.
+template <typename T>
+bool RingStack<T>::IsEmpty() const{return m_size == 0;}
+
+// Name: RemoveBottom
+// Description: If stack is empty, throw runtime_error("Stack is empty")
+//              Removes the item at the bottom of the stack in constant time
+//              and moves it out. Similar to Pop but opposite end of stack
+// Preconditions: Stack has at least one item
+// Postconditions: Removes item from bottom of stack and returns data
+template <typename T>
+T RingStack<T>::RemoveBottom(){
+  if (m_size == 0){ //if empty
+    throw runtime_error("Stack is empty");
+  }
+  T data = std::move(m_data[m_bottom]);
+  m_bottom = (m_bottom + 1) & (m_capacity - 1); //next slot is the new bottom
+  m_size--;
+  return data;
+}
+
+// Name: Display
+// Description: If stack is empty, outputs that the stack is empty
+//              Otherwise, iterates from the top and displays each item
+// Preconditions: None
+// Postconditions: Displays data from each item in stack
+template <typename T>
+void RingStack<T>::Display(){
+  if (IsEmpty()) //if the stack is empty
+    cout << "the stack is empty" << endl;
+  else{
+    for (size_t i = 0; i < m_size; i++){ //top of the stack first
+      cout << i + 1 << ". " << m_data[(m_bottom + m_size - 1 - i) & (m_capacity - 1)] << endl;
+    }
+  }
+}
+
+// Name: GetSize
+// Description: Returns the number of items in the stack
+// Preconditions: None
+// Postconditions: Returns the number of items in the stack.
+template <typename T>
+size_t RingStack<T>::GetSize() const{return m_size;}
+
+// Name: ForEach
+// Description: Calls visit with the data of each item, starting at the top
+// Preconditions: None
+// Postconditions: Stack is unchanged
+template <typename T>
+template <typename F>
+void RingStack<T>::ForEach(F visit) const{
+  for (size_t i = 0; i < m_size; i++){
+    visit(m_data[(m_bottom + m_size - 1 - i) & (m_capacity - 1)]);
+  }
+}
+
+// Name: Reserve
+// Description: Grows the slot array so count items fit without another
+//              reallocation
+// Preconditions: None
+// Postconditions: m_capacity is at least count
+template <typename T>
+void RingStack<T>::Reserve(size_t count){
+  if (count <= m_capacity){ //already fits
+    return;
+  }
+  size_t newCapacity = RING_STACK_MIN_CAPACITY;
+  while (newCapacity < count){ //keep the capacity a power of 2
+    newCapacity *= 2;
+  }
+  Grow(newCapacity);
+}
+
+// Name: Store
+// Description: Assigns value to the slot above the top, growing first
+//              if the slot array is full
+// Preconditions: None
+// Postconditions: Adds value to the top of the stack
+template <typename T>
+template <typename U>
+void RingStack<T>::Store(U&& value){
+  MetricTimer timer(METRIC_PUSH_TIME, METRIC_SAMPLE_EVERY);
+  if (m_size == m_capacity){ //no free slot left
+    Grow((m_capacity == 0) ? RING_STACK_MIN_CAPACITY : m_capacity * 2);
+  }
+  m_data[(m_bottom + m_size) & (m_capacity - 1)] = std::forward<U>(value); //slot above the top
+  m_size++;
+  CountMetric(METRIC_PUSHES);
+  PeakMetric(METRIC_PEAK_STACK, m_size);
+}
+
+// Name: Grow
+// Description: Moves the items into a slot array of newCapacity slots and
+//              unwraps them so the bottom of the stack sits in slot 0
+// Preconditions: newCapacity is a power of 2 and at least m_size
+// Postconditions: m_capacity is newCapacity, m_bottom is 0
+template <typename T>
+void RingStack<T>::Grow(size_t newCapacity){
+  T* newData = new T[newCapacity];
+  for (size_t i = 0; i < m_size; i++){ //move bottom to top
+    newData[i] = std::move(m_data[(m_bottom + i) & (m_capacity - 1)]);
+  }
+  delete[] m_data;
+  m_data = newData;
+  m_capacity = newCapacity;
+  m_bottom = 0;
+}
+
+// Name: CopyFrom
+// Description: Copies the items of source into this (empty) stack
+// Preconditions: This stack has no slot array allocated
+// Postconditions: Same items in the same order in separate memory space
+template <typename T>
+void RingStack<T>::CopyFrom(const RingStack& source){
+  if (source.m_size == 0){ //nothing to copy
+    return;
+  }
+  m_capacity = source.m_capacity;
+  m_data = new T[m_capacity];
+  for (size_t i = 0; i < source.m_size; i++){ //copy bottom to top
+    m_data[i] = source.m_data[(source.m_bottom + i) & (source.m_capacity - 1)];
+  }
+  m_bottom = 0;
+  m_size = source.m_size;
+}
+
+#endif
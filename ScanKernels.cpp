@@ -0,0 +1,304 @@
+/*Title: ScanKernels.cpp
+  Author: Shariq Moghees
+  Date: 10/17/2026
+  Description: These functions scan flat arrays of history timestamps and
+               URL ids with SIMD instructions picked at run time
+*/
+#include "ScanKernels.h"
+#include <atomic>
+#include <climits>
+
+//x86 builds compile every path and pick one with cpuid at run time, so the
+//binary does not need -mavx2. Other targets only have the scalar loops.
+#if (defined(__x86_64__) || defined(__i386__)) && defined(__GNUC__)
+#define SCAN_X86 1
+#include <immintrin.h>
+#else
+#define SCAN_X86 0
+#endif
+
+const int64_t MS_PER_DAY = MS_PER_HOUR * static_cast<int64_t>(HOURS_PER_DAY);
+const int64_t DELTA_DAYS = (INT32_MAX / MS_PER_DAY + 1) * MS_PER_DAY; //Whole days past any int32 delta
+
+static atomic<int> g_scanLevel(-1); //ScanLevel in use, -1 until detected
+
+// Name: IsSupported
+// Description: Returns true if the CPU can run level
+// Preconditions: None
+// Postconditions: None
+static bool IsSupported(ScanLevel level){
+#if SCAN_X86
+    if (level == SCAN_AVX2){
+        return __builtin_cpu_supports("avx2");
+    }
+    if (level == SCAN_SSE4){
+        return __builtin_cpu_supports("sse4.1");
+    }
+#endif
+    return level == SCAN_SCALAR;
+}
+
+// Name: GetScanLevel
+// Description: Returns the instruction set the kernels use. The first call
+//              picks the best one the CPU supports.
+// Preconditions: None
+// Postconditions: None
+ScanLevel GetScanLevel(){
+    int level = g_scanLevel.load(memory_order_relaxed);
+    if (level < 0){ //racing first calls all pick the same level
+        level = IsSupported(SCAN_AVX2) ? SCAN_AVX2 : IsSupported(SCAN_SSE4) ? SCAN_SSE4 : SCAN_SCALAR;
+        g_scanLevel.store(level, memory_order_relaxed);
+    }
+    return static_cast<ScanLevel>(level);
+}
+
+// Name: SetScanLevel
+// Description: Makes the kernels use level, for tests and benchmarks
+// Preconditions: None
+// Postconditions: Returns false and changes nothing if the CPU lacks level
+bool SetScanLevel(ScanLevel level){
+    if (!IsSupported(level)){
+        return false;
+    }
+    g_scanLevel.store(level, memory_order_relaxed);
+    return true;
+}
+
+// Name: GetScanLevelName
+// Description: Returns "scalar", "sse4.1" or "avx2"
+// Preconditions: None
+// Postconditions: None
+const char* GetScanLevelName(ScanLevel level){
+    return (level == SCAN_AVX2) ? "avx2" : (level == SCAN_SSE4) ? "sse4.1" : "scalar";
+}
+
+//**********Scalar kernels (also finish the tail of the SIMD kernels)**********
+
+static size_t CountInRangeScalar(const int32_t* values, size_t count, int32_t low, int32_t high){
+    size_t found = 0;
+    for (size_t i = 0; i < count; i++){
+        found += (values[i] >= low) & (values[i] <= high);
+    }
+    return found;
+}
+
+static size_t CollectInRangeScalar(const int32_t* values, size_t count, int32_t low,
+                                   int32_t high, uint32_t first, uint32_t* out){
+    size_t found = 0;
+    for (size_t i = 0; i < count; i++){
+        out[found] = static_cast<uint32_t>(first + i);
+        found += (values[i] >= low) & (values[i] <= high); //keep the write only on a match
+    }
+    return found;
+}
+
+static size_t CollectEqualScalar(const uint32_t* values, size_t count, uint32_t match,
+                                 uint32_t first, uint32_t* out){
+    size_t found = 0;
+    for (size_t i = 0; i < count; i++){
+        out[found] = static_cast<uint32_t>(first + i);
+        found += (values[i] == match);
+    }
+    return found;
+}
+
+// Name: GetDayStart
+// Description: Returns base less a whole number of days, in [0, MS_PER_DAY)
+// Preconditions: None
+// Postconditions: base + delta keeps its hour of the day after the shift
+static int64_t GetDayStart(int64_t base){
+    int64_t offset = base % MS_PER_DAY;
+    return (offset < 0) ? offset + MS_PER_DAY : offset;
+}
+
+static void AddHourCountsScalar(const int32_t* deltas, size_t count, int64_t dayOffset,
+                                size_t* hours){
+    for (size_t i = 0; i < count; i++){
+        int64_t time = dayOffset + deltas[i] + DELTA_DAYS; //never negative for an int32 delta
+        hours[(time / MS_PER_HOUR) % HOURS_PER_DAY]++;
+    }
+}
+
+#if SCAN_X86
+//**********SSE4.1 kernels**********
+
+// Name: InRangeMaskSse4
+// Description: Returns a bit per lane of the 4 values at values that are in
+//              [low, high]: clamping a value into the range leaves it equal
+// Preconditions: None
+// Postconditions: None
+__attribute__((target("sse4.1")))
+static inline int InRangeMaskSse4(const int32_t* values, __m128i low, __m128i high){
+    __m128i x = _mm_loadu_si128(reinterpret_cast<const __m128i*>(values));
+    __m128i clamped = _mm_min_epi32(_mm_max_epi32(x, low), high);
+    return _mm_movemask_ps(_mm_castsi128_ps(_mm_cmpeq_epi32(x, clamped)));
+}
+
+__attribute__((target("sse4.1,popcnt")))
+static size_t CountInRangeSse4(const int32_t* values, size_t count, int32_t low, int32_t high){
+    __m128i lowVector = _mm_set1_epi32(low);
+    __m128i highVector = _mm_set1_epi32(high);
+    size_t found = 0;
+    size_t i = 0;
+    for (; i + 4 <= count; i += 4){
+        found += __builtin_popcount(InRangeMaskSse4(values + i, lowVector, highVector));
+    }
+    return found + CountInRangeScalar(values + i, count - i, low, high);
+}
+
+__attribute__((target("sse4.1")))
+static size_t CollectInRangeSse4(const int32_t* values, size_t count, int32_t low,
+                                 int32_t high, uint32_t* out){
+    __m128i lowVector = _mm_set1_epi32(low);
+    __m128i highVector = _mm_set1_epi32(high);
+    size_t found = 0;
+    size_t i = 0;
+    for (; i + 4 <= count; i += 4){
+        for (int mask = InRangeMaskSse4(values + i, lowVector, highVector); mask != 0;
+             mask &= mask - 1){ //one lane per set bit, lowest first
+            out[found++] = static_cast<uint32_t>(i + __builtin_ctz(mask));
+        }
+    }
+    return found + CollectInRangeScalar(values + i, count - i, low, high,
+                                        static_cast<uint32_t>(i), out + found);
+}
+
+__attribute__((target("sse4.1")))
+static size_t CollectEqualSse4(const uint32_t* values, size_t count, uint32_t match,
+                               uint32_t* out){
+    __m128i matchVector = _mm_set1_epi32(static_cast<int32_t>(match));
+    size_t found = 0;
+    size_t i = 0;
+    for (; i + 4 <= count; i += 4){
+        __m128i x = _mm_loadu_si128(reinterpret_cast<const __m128i*>(values + i));
+        int mask = _mm_movemask_ps(_mm_castsi128_ps(_mm_cmpeq_epi32(x, matchVector)));
+        for (; mask != 0; mask &= mask - 1){
+            out[found++] = static_cast<uint32_t>(i + __builtin_ctz(mask));
+        }
+    }
+    return found + CollectEqualScalar(values + i, count - i, match, static_cast<uint32_t>(i),
+                                      out + found);
+}
+
+//**********AVX2 kernels**********
+
+// Name: InRangeMaskAvx2
+// Description: Returns a bit per lane of the 8 values at values that are
+//              in [low, high]
+// Preconditions: None
+// Postconditions: None
+__attribute__((target("avx2")))
+static inline int InRangeMaskAvx2(const int32_t* values, __m256i low, __m256i high){
+    __m256i x = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(values));
+    __m256i outside = _mm256_or_si256(_mm256_cmpgt_epi32(low, x), _mm256_cmpgt_epi32(x, high));
+    return ~_mm256_movemask_ps(_mm256_castsi256_ps(outside)) & 0xFF;
+}
+
+__attribute__((target("avx2,popcnt")))
+static size_t CountInRangeAvx2(const int32_t* values, size_t count, int32_t low, int32_t high){
+    __m256i lowVector = _mm256_set1_epi32(low);
+    __m256i highVector = _mm256_set1_epi32(high);
+    size_t found = 0;
+    size_t i = 0;
+    for (; i + 8 <= count; i += 8){
+        found += __builtin_popcount(InRangeMaskAvx2(values + i, lowVector, highVector));
+    }
+    return found + CountInRangeScalar(values + i, count - i, low, high);
+}
+
+__attribute__((target("avx2")))
+static size_t CollectInRangeAvx2(const int32_t* values, size_t count, int32_t low,
+                                 int32_t high, uint32_t* out){
+    __m256i lowVector = _mm256_set1_epi32(low);
+    __m256i highVector = _mm256_set1_epi32(high);
+    size_t found = 0;
+    size_t i = 0;
+    for (; i + 8 <= count; i += 8){
+        for (int mask = InRangeMaskAvx2(values + i, lowVector, highVector); mask != 0;
+             mask &= mask - 1){
+            out[found++] = static_cast<uint32_t>(i + __builtin_ctz(mask));
+        }
+    }
+    return found + CollectInRangeScalar(values + i, count - i, low, high,
+                                        static_cast<uint32_t>(i), out + found);
+}
+
+__attribute__((target("avx2")))
+static size_t CollectEqualAvx2(const uint32_t* values, size_t count, uint32_t match,
+                               uint32_t* out){
+    __m256i matchVector = _mm256_set1_epi32(static_cast<int32_t>(match));
+    size_t found = 0;
+    size_t i = 0;
+    for (; i + 8 <= count; i += 8){
+        __m256i x = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(values + i));
+        int mask = _mm256_movemask_ps(_mm256_castsi256_ps(_mm256_cmpeq_epi32(x, matchVector)));
+        for (; mask != 0; mask &= mask - 1){
+            out[found++] = static_cast<uint32_t>(i + __builtin_ctz(mask));
+        }
+    }
+    return found + CollectEqualScalar(values + i, count - i, match, static_cast<uint32_t>(i),
+                                      out + found);
+}
+#endif
+
+//**********Dispatch**********
+
+// Name: CountInRange
+// Description: Counts the values with low <= value <= high
+// Preconditions: values points to count values
+// Postconditions: None
+size_t CountInRange(const int32_t* values, size_t count, int32_t low, int32_t high){
+#if SCAN_X86
+    switch (GetScanLevel()){
+    case SCAN_AVX2: return CountInRangeAvx2(values, count, low, high);
+    case SCAN_SSE4: return CountInRangeSse4(values, count, low, high);
+    default: break;
+    }
+#endif
+    return CountInRangeScalar(values, count, low, high);
+}
+
+// Name: CollectInRange
+// Description: Writes the index of each value with low <= value <= high
+//              to out, in order
+// Preconditions: values points to count values; out has room for count
+// Postconditions: Returns how many indexes were written
+size_t CollectInRange(const int32_t* values, size_t count, int32_t low, int32_t high,
+                      uint32_t* out){
+#if SCAN_X86
+    switch (GetScanLevel()){
+    case SCAN_AVX2: return CollectInRangeAvx2(values, count, low, high, out);
+    case SCAN_SSE4: return CollectInRangeSse4(values, count, low, high, out);
+    default: break;
+    }
+#endif
+    return CollectInRangeScalar(values, count, low, high, 0, out);
+}
+
+// Name: CollectEqual
+// Description: Writes the index of each value equal to match to out, in order
+// Preconditions: values points to count values; out has room for count
+// Postconditions: Returns how many indexes were written
+size_t CollectEqual(const uint32_t* values, size_t count, uint32_t match, uint32_t* out){
+#if SCAN_X86
+    switch (GetScanLevel()){
+    case SCAN_AVX2: return CollectEqualAvx2(values, count, match, out);
+    case SCAN_SSE4: return CollectEqualSse4(values, count, match, out);
+    default: break;
+    }
+#endif
+    return CollectEqualScalar(values, count, match, 0, out);
+}
+
+// Name: AddHourCounts
+// Description: Adds one to hours[h] for each timestamp base + delta, where h
+//              is its hour of the day counted from a midnight of base's clock
+// Preconditions: deltas points to count deltas; hours has HOURS_PER_DAY
+//                counters
+// Postconditions: None
+void AddHourCounts(const int32_t* deltas, size_t count, int64_t base, size_t* hours){
+    //The histogram stays scalar: SIMD lanes still have to bump the counters
+    //one at a time, and those increments, not the division, set the pace
+    int64_t dayOffset = GetDayStart(base);
+    AddHourCountsScalar(deltas, count, dayOffset, hours);
+}
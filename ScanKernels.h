@@ -0,0 +1,73 @@
+/*Title: ScanKernels.h
+  Author: Shariq Moghees
+  Date: 10/17/2026
+  Description: These functions scan flat arrays of history timestamps and
+               URL ids with SIMD instructions picked at run time
+*/
+#ifndef SCAN_KERNELS_H //Header guards
+#define SCAN_KERNELS_H //Header guards
+
+#include <cstddef>
+#include <cstdint>
+using namespace std;
+
+//Constants
+const size_t HOURS_PER_DAY = 24; //Buckets in an hour-of-day histogram
+const int64_t MS_PER_HOUR = 60 * 60 * 1000; //Milliseconds in an hour
+
+//Instruction sets the kernels can use, slowest first
+enum ScanLevel {
+  SCAN_SCALAR, //Plain loops, used on every target
+  SCAN_SSE4, //SSE4.1, 4 ids or timestamps per step
+  SCAN_AVX2 //AVX2, 8 ids or timestamps per step
+};
+
+// Name: GetScanLevel
+// Description: Returns the instruction set the kernels use. The first call
+//              picks the best one the CPU supports.
+// Preconditions: None
+// Postconditions: None
+ScanLevel GetScanLevel();
+
+// Name: SetScanLevel
+// Description: Makes the kernels use level, for tests and benchmarks
+// Preconditions: None
+// Postconditions: Returns false and changes nothing if the CPU lacks level
+bool SetScanLevel(ScanLevel level);
+
+// Name: GetScanLevelName
+// Description: Returns "scalar", "sse4.1" or "avx2"
+// Preconditions: None
+// Postconditions: None
+const char* GetScanLevelName(ScanLevel level);
+
+// Name: CountInRange
+// Description: Counts the values with low <= value <= high
+// Preconditions: values points to count values
+// Postconditions: None
+size_t CountInRange(const int32_t* values, size_t count, int32_t low, int32_t high);
+
+// Name: CollectInRange
+// Description: Writes the index of each value with low <= value <= high
+//              to out, in order
+// Preconditions: values points to count values; out has room for count
+// Postconditions: Returns how many indexes were written
+size_t CollectInRange(const int32_t* values, size_t count, int32_t low, int32_t high,
+                      uint32_t* out);
+
+// Name: CollectEqual
+// Description: Writes the index of each value equal to match to out, in order
+// Preconditions: values points to count values; out has room for count
+// Postconditions: Returns how many indexes were written
+size_t CollectEqual(const uint32_t* values, size_t count, uint32_t match, uint32_t* out);
+
+// Name: AddHourCounts
+// Description: Adds one to hours[h] for each timestamp base + delta, where h
+//              is its hour of the day counted from a midnight of base's clock.
+//              Runs the scalar loop at every level.
+// Preconditions: deltas points to count deltas; hours has HOURS_PER_DAY
+//                counters
+// Postconditions: None
+void AddHourCounts(const int32_t* deltas, size_t count, int64_t base, size_t* hours);
+
+#endif
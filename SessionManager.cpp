@@ -0,0 +1,203 @@
+/*Title: SessionManager.cpp
+  Author: Shariq Moghees
+  Date: 10/17/2026
+  Description: This class hosts many independent browser histories in one
+               process and lets worker threads navigate them concurrently
+*/
+#include "SessionManager.h"
+
+// Name: SessionManager (Overloaded constructor)
+// Description: Creates a manager with shardCount session map shards
+// Preconditions: shardCount is greater than 0
+// Postconditions: Creates a new SessionManager with no sessions
+SessionManager::SessionManager(size_t shardCount)
+    :m_shards(shardCount),m_nextId(0),m_count(0){}
+
+// Name: OpenSession
+// Description: Creates an empty browser history
+// Preconditions: None
+// Postconditions: Returns the id of the new session
+SessionId SessionManager::OpenSession(){
+    SessionId id = m_nextId.fetch_add(1, memory_order_relaxed);
+    unique_ptr<Session> session(new Session()); //built outside the shard lock
+    Shard& shard = GetShard(id);
+    {
+        unique_lock<shared_mutex> lock(shard.m_lock);
+        shard.m_sessions.emplace(id, move(session));
+    }
+    m_count.fetch_add(1, memory_order_relaxed);
+    return id;
+}
+
+// Name: CloseSession
+// Description: Deletes a session and its history. Pages read from it
+//              must not be used afterwards.
+// Preconditions: No other thread is still using the session
+// Postconditions: Returns false if id is not an open session
+bool SessionManager::CloseSession(SessionId id){
+    unique_ptr<Session> session;
+    Shard& shard = GetShard(id);
+    {
+        unique_lock<shared_mutex> lock(shard.m_lock);
+        auto found = shard.m_sessions.find(id);
+        if (found == shard.m_sessions.end()){
+            return false;
+        }
+        session = move(found->second);
+        shard.m_sessions.erase(found);
+    }
+    m_count.fetch_sub(1, memory_order_relaxed);
+    return true; //history is freed here, outside the shard lock
+}
+
+// Name: Visit
+// Description: Calls Browser::Visit on the session
+// Preconditions: None
+// Postconditions: Returns false if id is not an open session
+bool SessionManager::Visit(SessionId id, string_view url, int64_t timestamp){
+    const Shard& shard = GetShard(id);
+    shared_lock<shared_mutex> mapLock(shard.m_lock);
+    Session* session = Find(shard, id);
+    if (session == nullptr){
+        return false;
+    }
+    lock_guard<mutex> lock(session->m_lock);
+    session->m_browser.Visit(url, timestamp);
+    session->Publish();
+    return true;
+}
+
+// Name: Back
+// Description: Calls Browser::Back on the session and copies the new
+//              current page into page
+// Preconditions: None
+// Postconditions: Returns false if id is not an open session or has no
+//                 current page
+bool SessionManager::Back(SessionId id, int steps, NavigationEntry& page){
+    const Shard& shard = GetShard(id);
+    shared_lock<shared_mutex> mapLock(shard.m_lock);
+    Session* session = Find(shard, id);
+    if (session == nullptr){
+        return false;
+    }
+    lock_guard<mutex> lock(session->m_lock);
+    if (session->m_url.load(memory_order_relaxed) == nullptr){ //Back needs a current page
+        return false;
+    }
+    page = session->m_browser.Back(steps);
+    session->Publish();
+    return true;
+}
+
+// Name: Forward
+// Description: Calls Browser::Forward on the session and copies the new
+//              current page into page
+// Preconditions: None
+// Postconditions: Returns false if id is not an open session or has no
+//                 current page
+bool SessionManager::Forward(SessionId id, int steps, NavigationEntry& page){
+    const Shard& shard = GetShard(id);
+    shared_lock<shared_mutex> mapLock(shard.m_lock);
+    Session* session = Find(shard, id);
+    if (session == nullptr){
+        return false;
+    }
+    lock_guard<mutex> lock(session->m_lock);
+    if (session->m_url.load(memory_order_relaxed) == nullptr){ //Forward needs a current page
+        return false;
+    }
+    page = session->m_browser.Forward(steps);
+    session->Publish();
+    return true;
+}
+
+// Name: GetCurrentPage
+// Description: Copies the session's current page into page without
+//              taking the session's lock. The URL stays valid until the
+//              session is closed.
+// Preconditions: None
+// Postconditions: Returns false if id is not an open session or has no
+//                 current page
+bool SessionManager::GetCurrentPage(SessionId id, NavigationEntry& page) const{
+    const Shard& shard = GetShard(id);
+    shared_lock<shared_mutex> mapLock(shard.m_lock); //only waits on open/close
+    Session* session = Find(shard, id);
+    return session != nullptr && session->Read(page);
+}
+
+// Name: GetSessionCount
+// Description: Returns the number of open sessions
+// Preconditions: None
+// Postconditions: None
+size_t SessionManager::GetSessionCount() const{return m_count.load(memory_order_relaxed);}
+
+// Name: GetShard
+// Description: Returns the shard that holds id
+// Preconditions: None
+// Postconditions: None
+SessionManager::Shard& SessionManager::GetShard(SessionId id){
+    return m_shards[id % m_shards.size()];
+}
+const SessionManager::Shard& SessionManager::GetShard(SessionId id) const{
+    return m_shards[id % m_shards.size()];
+}
+
+// Name: Find
+// Description: Returns the session with id in shard, or nullptr
+// Preconditions: shard.m_lock is held (shared is enough)
+// Postconditions: None
+SessionManager::Session* SessionManager::Find(const Shard& shard, SessionId id){
+    auto found = shard.m_sessions.find(id);
+    return (found == shard.m_sessions.end()) ? nullptr : found->second.get();
+}
+
+// Name: Session (Default constructor)
+// Description: Creates an empty history with nothing published
+// Preconditions: None
+// Postconditions: m_url is nullptr
+SessionManager::Session::Session()
+    :m_browser(""),m_sequence(0),m_url(nullptr),m_urlLength(0),m_urlId(0),m_timeStamp(0){}
+
+// Name: Publish
+// Description: Stores the browser's current page for lock-free readers
+// Preconditions: m_lock is held
+// Postconditions: m_sequence is even and ahead of any earlier value
+void SessionManager::Session::Publish(){
+    const NavigationEntry& page = m_browser.GetCurrentPage();
+    uint64_t sequence = m_sequence.load(memory_order_relaxed);
+    m_sequence.store(sequence + 1, memory_order_relaxed); //odd: readers retry
+    atomic_thread_fence(memory_order_release);
+    m_url.store(page.GetURLView().data(), memory_order_relaxed);
+    m_urlLength.store(page.GetURLView().length(), memory_order_relaxed);
+    m_urlId.store(page.GetURLId(), memory_order_relaxed);
+    m_timeStamp.store(page.GetTimeStamp(), memory_order_relaxed);
+    m_sequence.store(sequence + 2, memory_order_release);
+}
+
+// Name: Read
+// Description: Copies the published page into page
+// Preconditions: None
+// Postconditions: Returns false if nothing is published
+bool SessionManager::Session::Read(NavigationEntry& page) const{
+    const char* url;
+    size_t length;
+    UrlId urlId;
+    int64_t timestamp;
+    uint64_t before;
+    uint64_t after;
+    do{
+        before = m_sequence.load(memory_order_acquire);
+        url = m_url.load(memory_order_relaxed);
+        length = m_urlLength.load(memory_order_relaxed);
+        urlId = m_urlId.load(memory_order_relaxed);
+        timestamp = m_timeStamp.load(memory_order_relaxed);
+        atomic_thread_fence(memory_order_acquire);
+        after = m_sequence.load(memory_order_relaxed);
+    } while ((before & 1) != 0 || before != after); //a writer was mid-publish
+    if (url == nullptr){
+        return false;
+    }
+    //URL text lives in the session's UrlTable, which never moves or frees it
+    page = NavigationEntry(string_view(url, length), urlId, timestamp);
+    return true;
+}
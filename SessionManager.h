@@ -0,0 +1,133 @@
+/*Title: SessionManager.h
+  Author: Shariq Moghees
+  Date: 10/17/2026
+  Description: This class hosts many independent browser histories in one
+               process and lets worker threads navigate them concurrently
+*/
+#ifndef SESSION_MANAGER_H //Header guards
+#define SESSION_MANAGER_H //Header guards
+
+#include <atomic>
+#include <cstdint>
+#include <memory>
+#include <mutex>
+#include <shared_mutex>
+#include <string_view>
+#include <unordered_map>
+#include <vector>
+#include "Browser.h"
+using namespace std;
+
+//Constants
+const size_t SESSION_SHARDS = 64; //Default number of session map shards
+const size_t CACHE_LINE = 64; //Bytes per cache line, to keep shards apart
+
+typedef uint64_t SessionId; //Handle for one browser history
+
+//Owns one Browser per session. Sessions are spread over shards by id, and
+//each shard's lock only guards its session map, so it is held exclusively
+//only to open or close a session. Visit, Back and Forward lock just their
+//own session. Each session publishes its current page through a sequence
+//counter, so GetCurrentPage never waits for a writer; it only retries if
+//it overlaps the few stores that publish a new page.
+class SessionManager {
+ public:
+  // Name: SessionManager (Overloaded constructor)
+  // Description: Creates a manager with shardCount session map shards
+  // Preconditions: shardCount is greater than 0
+  // Postconditions: Creates a new SessionManager with no sessions
+  SessionManager(size_t shardCount = SESSION_SHARDS);
+  // Name: OpenSession
+  // Description: Creates an empty browser history
+  // Preconditions: None
+  // Postconditions: Returns the id of the new session
+  SessionId OpenSession();
+  // Name: CloseSession
+  // Description: Deletes a session and its history. Pages read from it
+  //              must not be used afterwards.
+  // Preconditions: No other thread is still using the session
+  // Postconditions: Returns false if id is not an open session
+  bool CloseSession(SessionId id);
+  // Name: Visit
+  // Description: Calls Browser::Visit on the session
+  // Preconditions: None
+  // Postconditions: Returns false if id is not an open session
+  bool Visit(SessionId id, string_view url, int64_t timestamp);
+  // Name: Back
+  // Description: Calls Browser::Back on the session and copies the new
+  //              current page into page
+  // Preconditions: None
+  // Postconditions: Returns false if id is not an open session or has no
+  //                 current page
+  bool Back(SessionId id, int steps, NavigationEntry& page);
+  // Name: Forward
+  // Description: Calls Browser::Forward on the session and copies the new
+  //              current page into page
+  // Preconditions: None
+  // Postconditions: Returns false if id is not an open session or has no
+  //                 current page
+  bool Forward(SessionId id, int steps, NavigationEntry& page);
+  // Name: GetCurrentPage
+  // Description: Copies the session's current page into page without
+  //              taking the session's lock. The URL stays valid until the
+  //              session is closed.
+  // Preconditions: None
+  // Postconditions: Returns false if id is not an open session or has no
+  //                 current page
+  bool GetCurrentPage(SessionId id, NavigationEntry& page) const;
+  // Name: GetSessionCount
+  // Description: Returns the number of open sessions
+  // Preconditions: None
+  // Postconditions: None
+  size_t GetSessionCount() const;
+ private:
+  //One browser history and the current page it last published
+  struct Session {
+    // Name: Session (Default constructor)
+    // Description: Creates an empty history with nothing published
+    // Preconditions: None
+    // Postconditions: m_url is nullptr
+    Session();
+    // Name: Publish
+    // Description: Stores the browser's current page for lock-free readers
+    // Preconditions: m_lock is held
+    // Postconditions: m_sequence is even and ahead of any earlier value
+    void Publish();
+    // Name: Read
+    // Description: Copies the published page into page
+    // Preconditions: None
+    // Postconditions: Returns false if nothing is published
+    bool Read(NavigationEntry& page) const;
+
+    mutex m_lock; //Serializes writers of m_browser
+    Browser m_browser; //History of the session
+    atomic<uint64_t> m_sequence; //Odd while a page is being published
+    atomic<const char*> m_url; //Published URL text (owned by m_browser)
+    atomic<size_t> m_urlLength; //Published URL length
+    atomic<UrlId> m_urlId; //Published URL id
+    atomic<int64_t> m_timeStamp; //Published timestamp
+  };
+  //A share of the sessions, padded so shards do not share a cache line
+  struct alignas(CACHE_LINE) Shard {
+    mutable shared_mutex m_lock; //Exclusive only to open or close a session
+    unordered_map<SessionId, unique_ptr<Session> > m_sessions; //Sessions by id
+  };
+
+  // Name: GetShard
+  // Description: Returns the shard that holds id
+  // Preconditions: None
+  // Postconditions: None
+  Shard& GetShard(SessionId id);
+  const Shard& GetShard(SessionId id) const;
+  // Name: Find
+  // Description: Returns the session with id in shard, or nullptr
+  // Preconditions: shard.m_lock is held (shared is enough)
+  // Postconditions: None
+  static Session* Find(const Shard& shard, SessionId id);
+
+  vector<Shard> m_shards; //Sessions spread by id
+  atomic<SessionId> m_nextId; //Id for the next OpenSession
+  atomic<size_t> m_count; //Open sessions
+};
+
+#endif
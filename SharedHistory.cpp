@@ -0,0 +1,137 @@
+/*Title: SharedHistory.cpp
+  Author: Shariq Moghees
+  Date: 10/17/2026
+  Description: This class keeps a browser history that can be forked in
+               constant time, for duplicated tabs and what-if replays
+*/
+#include "SharedHistory.h"
+
+// Name: SharedHistory (Default constructor)
+// Description: Creates an empty history
+// Preconditions: None
+// Postconditions: HasCurrentPage() is false
+SharedHistory::SharedHistory(){}
+
+// Name: Visit
+// Description: Makes a new page the current page and discards the forward
+//              history of this fork
+// Preconditions: None
+// Postconditions: The old current page is the newest back page
+void SharedHistory::Visit(string_view url, int64_t timestamp){
+    m_current.Push(SharedPage{string(url), timestamp});
+    m_ahead = PersistentStack<PersistentStack<SharedPage>>(); //other forks keep theirs
+}
+
+// Name: Back
+// Description: Moves back steps pages, stopping at the oldest. Takes time
+//              in proportion to the pages moved.
+// Preconditions: None
+// Postconditions: Returns how many pages it moved
+size_t SharedHistory::Back(int steps){
+    size_t back = GetBackSize();
+    size_t moved = (steps < 0) ? 0 : static_cast<size_t>(steps);
+    if (moved > back){ //stop at the oldest
+        moved = back;
+    }
+    for (size_t i = 0; i < moved; i++){ //remember where Forward comes back to
+        m_ahead.Push(m_current);
+        m_current.Drop(1);
+    }
+    return moved;
+}
+
+// Name: Forward
+// Description: Moves forward steps pages, stopping at the newest. Takes
+//              time in proportion to the pages moved.
+// Preconditions: None
+// Postconditions: Returns how many pages it moved
+size_t SharedHistory::Forward(int steps){
+    size_t moved = (steps < 0) ? 0 : static_cast<size_t>(steps);
+    if (moved > m_ahead.GetSize()){ //stop at the newest
+        moved = m_ahead.GetSize();
+    }
+    if (moved > 0){
+        m_ahead.Drop(moved - 1);
+        m_current = m_ahead.Peek();
+        m_ahead.Drop(1);
+    }
+    return moved;
+}
+
+// Name: GetCurrentPage
+// Description: Returns the current page. The URL views this history's
+//              page and stays valid until the history changes. Pages
+//              have no UrlTable, so the URL id is 0.
+// Preconditions: None
+// Postconditions: Returns an empty entry if nothing has been visited
+NavigationEntry SharedHistory::GetCurrentPage() const{
+    if (m_current.IsEmpty()){
+        return NavigationEntry();
+    }
+    const SharedPage& page = m_current.Peek();
+    return NavigationEntry(page.m_url, 0, page.m_timeStamp);
+}
+
+// Name: HasCurrentPage
+// Description: Returns true if a page has been visited
+// Preconditions: None
+// Postconditions: None
+bool SharedHistory::HasCurrentPage() const{return !m_current.IsEmpty();}
+
+// Name: GetBackSize
+// Description: Returns the number of pages before the current page
+// Preconditions: None
+// Postconditions: None
+size_t SharedHistory::GetBackSize() const{
+    return m_current.IsEmpty() ? 0 : m_current.GetSize() - 1;
+}
+
+// Name: GetForwardSize
+// Description: Returns the number of pages after the current page
+// Preconditions: None
+// Postconditions: None
+size_t SharedHistory::GetForwardSize() const{return m_ahead.GetSize();}
+
+// Name: Display
+// Description: Adds the same text as Browser::Display to out without
+//              flushing it
+// Preconditions: None
+// Postconditions: None
+void SharedHistory::Display(HistoryWriter& out) const{
+    size_t number = 0;
+    auto line = [&out, &number](const SharedPage& page){
+        out.WriteNumber(++number);
+        out.Write(". ");
+        out.WriteEntry(NavigationEntry(page.m_url, 0, page.m_timeStamp));
+    };
+    //Back Stack Display
+    out.Write("**Back Stack**\n");
+    size_t skipped = 0;
+    m_current.ForEach([&line, &skipped](const SharedPage& page){
+        if (skipped++ > 0){ //the top of m_current is the current page
+            line(page);
+        }
+    });
+    if (number == 0){
+        out.Write("the stack is empty\n");
+    }
+    out.Write("\n");
+    //Forward Stack Display
+    out.Write("**Forward Stack**\n");
+    number = 0;
+    m_ahead.ForEach([&line](const PersistentStack<SharedPage>& pages){ //next page first
+        line(pages.Peek());
+    });
+    if (number == 0){
+        out.Write("the stack is empty\n");
+    }
+    out.Write("\n");
+    //Current Website
+    if (m_current.IsEmpty()){
+        out.Write("No current page\n");
+    }
+    else{
+        out.WriteEntry(GetCurrentPage());
+    }
+    out.Write("\n");
+}
@@ -0,0 +1,92 @@
+/*Title: SharedHistory.h
+  Author: Shariq Moghees
+  Date: 10/17/2026
+  Description: This class keeps a browser history that can be forked in
+               constant time, for duplicated tabs and what-if replays
+*/
+#ifndef SHARED_HISTORY_H //Header guards
+#define SHARED_HISTORY_H //Header guards
+
+#include <cstdint>
+#include <string>
+#include <string_view>
+#include "PersistentStack.cpp"
+#include "NavigationEntry.h"
+#include "HistoryWriter.h"
+using namespace std;
+
+//One page of a SharedHistory. The page owns its URL text, so a fork stays
+//valid after the Browser it was taken from is gone.
+struct SharedPage {
+  string m_url; //URL of the visited website
+  int64_t m_timeStamp; //Timestamp of the visit in milliseconds
+};
+
+//m_current is a PersistentStack with the current page on top and the back
+//pages below it. Each forward page is kept as the m_current it restores, in
+//a second PersistentStack (m_ahead) with the next page on top, so Back and
+//Forward take time in proportion to the pages moved. Copying a
+//SharedHistory forks it in constant time: the copy shares every page, and
+//Visit and Back only push onto the fork's own stacks, so no fork ever sees
+//another's changes. A page is freed when the last fork holding it lets it
+//go. Pages are never copied between stacks; Back allocates one small node
+//per page moved and Forward does not allocate.
+class SharedHistory {
+ public:
+  // Name: SharedHistory (Default constructor)
+  // Description: Creates an empty history
+  // Preconditions: None
+  // Postconditions: HasCurrentPage() is false
+  SharedHistory();
+  // Name: Visit
+  // Description: Makes a new page the current page and discards the forward
+  //              history of this fork
+  // Preconditions: None
+  // Postconditions: The old current page is the newest back page
+  void Visit(string_view url, int64_t timestamp);
+  // Name: Back
+  // Description: Moves back steps pages, stopping at the oldest. Takes time
+  //              in proportion to the pages moved.
+  // Preconditions: None
+  // Postconditions: Returns how many pages it moved
+  size_t Back(int steps);
+  // Name: Forward
+  // Description: Moves forward steps pages, stopping at the newest. Takes
+  //              time in proportion to the pages moved.
+  // Preconditions: None
+  // Postconditions: Returns how many pages it moved
+  size_t Forward(int steps);
+  // Name: GetCurrentPage
+  // Description: Returns the current page. The URL views this history's
+  //              page and stays valid until the history changes. Pages
+  //              have no UrlTable, so the URL id is 0.
+  // Preconditions: None
+  // Postconditions: Returns an empty entry if nothing has been visited
+  NavigationEntry GetCurrentPage() const;
+  // Name: HasCurrentPage
+  // Description: Returns true if a page has been visited
+  // Preconditions: None
+  // Postconditions: None
+  bool HasCurrentPage() const;
+  // Name: GetBackSize
+  // Description: Returns the number of pages before the current page
+  // Preconditions: None
+  // Postconditions: None
+  size_t GetBackSize() const;
+  // Name: GetForwardSize
+  // Description: Returns the number of pages after the current page
+  // Preconditions: None
+  // Postconditions: None
+  size_t GetForwardSize() const;
+  // Name: Display
+  // Description: Adds the same text as Browser::Display to out without
+  //              flushing it
+  // Preconditions: None
+  // Postconditions: None
+  void Display(HistoryWriter& out) const;
+ private:
+  PersistentStack<SharedPage> m_current; //Current page on top of the back pages
+  PersistentStack<PersistentStack<SharedPage>> m_ahead; //m_current at each forward page, next page on top
+};
+
+#endif
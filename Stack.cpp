@@ -5,13 +5,17 @@
 */
 #include <iostream>
 #include <stdexcept>
+#include <utility>
+#include "Pool.cpp"
+#include "Metrics.h"
 using namespace std;
 
 //Templated node class used in templated linked list
 template <class T>
 class Node {
 public:
-  Node( const T& data ); //Constructor
+  template <typename... Args>
+  Node( Args&&... args ); //Constructs m_data from args in place
   T& GetData(); //Gets data from node
   void SetData( const T& data ); //Sets data in node
   Node<T>* GetNext(); //Gets next pointer
@@ -21,12 +25,12 @@ private:
   Node<T>* m_next;
 };
 
-//Overloaded constructor for Node
+//Overloaded constructor for Node. Builds m_data straight from args instead
+//of default constructing it and then assigning.
 template <class T>
-Node<T>::Node( const T& data ) {
-  m_data = data;
-  m_next = NULL;
-}
+template <typename... Args>
+Node<T>::Node( Args&&... args )
+  :m_data(std::forward<Args>(args)...),m_next(NULL){}
 
 //Returns the data from a Node
 template <class T>
@@ -63,6 +67,7 @@ public:
   Stack();
   // Name: ~Stack
   // Description: Stack destructor - deallocates all nodes in linked list
+  //              (m_nodes then frees its blocks)
   // Preconditions: None
   // Postconditions: All nodes are deleted. Size is 0. No memory leaks.
   ~Stack();
@@ -83,19 +88,32 @@ public:
   // Preconditions: None
   // Postconditions: Adds a new node to the top of the stack
   void Push(const T& value);
+  // Name: Push (move)
+  // Description: Same as Push but moves value into the new node
+  // Preconditions: None
+  // Postconditions: Adds a new node to the top of the stack
+  void Push(T&& value);
+  // Name: Emplace
+  // Description: Adds a new node to the top of the stack whose data is
+  //              constructed in place from args
+  // Preconditions: None
+  // Postconditions: Adds a new node to the top of the stack
+  template <typename... Args>
+  void Emplace(Args&&... args);
   // Name: Pop
   // Description: If stack is empty, throw runtime_error("Stack is empty");
-  //              Temporarily stores data from node at the top of the stack.
-  //              Removes the node from the top of the stack. Returns the stored data.
+  //              Moves the data out of the node at the top of the stack.
+  //              Removes the node from the top of the stack. Returns the moved data.
   // Preconditions: Stack has at least one node
   // Postconditions: See description
   T Pop();
   // Name: Peek
   // Description: If stack is empty, throw runtime_error("Stack is empty");
-  //              Returns the stored data from top node.
+  //              Returns the stored data from top node. The reference stays
+  //              valid until the node is popped.
   // Preconditions: Stack has at least one node
   // Postconditions: See description
- T Peek() const;
+ const T& Peek() const;
   // Name: At
   // Description: If stack is empty, throw runtime_error("Stack is empty")
   //              Returns stored data from number of the node passed to function.
@@ -110,9 +128,8 @@ public:
   bool IsEmpty() const;
   // Name: RemoveBottom
   // Description: If stack is empty, throw runtime_error("Stack is empty")
-  //              Temporarily stores data from node at the bottom of the sta\
-ck.
-  //              Removes node from bottom of the stack. Returns the stored data.
+  //              Moves the data out of the node at the bottom of the stack.
+  //              Removes node from bottom of the stack. Returns the moved data.
   //              Similar to Pop but opposite end of stack
   // Preconditions: Stack has at least one node
   // Postconditions: Removes node from bottom of stack and returns data
@@ -123,12 +140,25 @@ ck.
   // Preconditions: Stack has at least one node
   // Postconditions: Displays data from each node in stack
   void Display();
+  // Name: ForEach
+  // Description: Calls visit with the data of each node, starting at the top
+  // Preconditions: None
+  // Postconditions: Stack is unchanged
+  template <typename F>
+  void ForEach(F visit) const;
   // Name: GetSize
   // Description: Returns the number of nodes in the stack
   // Preconditions: None
   // Postconditions: Returns the number of nodes in the stack.
   size_t GetSize() const;
+  // Name: Reserve
+  // Description: Matches RingStack::Reserve. Nodes come from m_nodes a block
+  //              at a time, so there is nothing to reserve.
+  // Preconditions: None
+  // Postconditions: None
+  void Reserve(size_t count);
 private:
+  Pool<Node<T> > m_nodes; //Allocates the nodes and reuses popped ones
   Node<T>* m_top; //Top node in stack
   size_t m_size; //Number of nodes in stack
 };
@@ -155,7 +185,7 @@ Stack<T>::~Stack(){
   while(curr != nullptr){ //loop trough entire stack
     Node<T>* temp = curr; 
     curr = curr->GetNext();
-    delete temp; //delete the previous node
+    m_nodes.Release(temp); //delete the previous node
   }
   m_top = nullptr; //free m_top ptr
   m_size = 0; //reset size
@@ -175,14 +205,14 @@ Stack<T>::Stack(const Stack& source){
   if(source.m_top != nullptr){ //first make sure the original isn't empty also
 
     //First node copy
-    m_top = new Node<T>(source.m_top->GetData()); //creates the first node in the copy stack
+    m_top = m_nodes.Allocate(source.m_top->GetData()); //creates the first node in the copy stack
     m_size++; //increment size to 1
 
     //Every node that follows
     Node<T>* curr = m_top;
     Node<T>* sourceCurr = source.m_top->GetNext();
     while (sourceCurr != nullptr){
-      Node<T>* newNode = new Node<T>(sourceCurr->GetData()); //mkae a new node
+      Node<T>* newNode = m_nodes.Allocate(sourceCurr->GetData()); //mkae a new node
       curr->SetNext(newNode); //insert the node into the copy stack
       //traverse one node over in both stacks
       curr = newNode;
@@ -210,21 +240,25 @@ Stack<T>& Stack<T>::operator=(const Stack& other){
     while(curr != nullptr){ //loop trough entire stack
       Node<T>* temp = curr; 
       curr = curr->GetNext();
-      delete temp; //delete the previous node
+      m_nodes.Release(temp); //delete the previous node
     }
     m_top = nullptr; //free m_top ptr
     m_size = 0; //reset size
 
+    if (other.m_top == nullptr){ //an empty source leaves this stack empty
+      return *this;
+    }
+
     //Copy the current stack from other (reference the copy constructor)
     //First node copy
-    m_top = new Node<T>(other.m_top->GetData()); //creates the first node in the copy stack
+    m_top = m_nodes.Allocate(other.m_top->GetData()); //creates the first node in the copy stack
     m_size++; //increment size to 1
 
     //Every node that follows
     curr = m_top;
     Node<T>* otherCurr = other.m_top->GetNext();
     while (otherCurr != nullptr){
-      Node<T>* newNode = new Node<T>(otherCurr->GetData()); //mkae a new node
+      Node<T>* newNode = m_nodes.Allocate(otherCurr->GetData()); //mkae a new node
       curr->SetNext(newNode); //insert the node into the copy stack
       //traverse one node over in both stacks
       curr = newNode;
@@ -242,41 +276,64 @@ Stack<T>& Stack<T>::operator=(const Stack& other){
 // Postconditions: Adds a new node to the top of the stack
 template <typename T>
 void Stack<T>::Push(const T& value){
-  Node<T>* newNode = new Node<T>(value); //create new node
+  Emplace(value);
+}
+
+// Name: Push (move)
+// Description: Same as Push but moves value into the new node
+// Preconditions: None
+// Postconditions: Adds a new node to the top of the stack
+template <typename T>
+void Stack<T>::Push(T&& value){
+  Emplace(std::move(value));
+}
+
+// Name: Emplace
+// Description: Adds a new node to the top of the stack whose data is
+//              constructed in place from args
+// Preconditions: None
+// Postconditions: Adds a new node to the top of the stack
+template <typename T>
+template <typename... Args>
+void Stack<T>::Emplace(Args&&... args){
+  MetricTimer timer(METRIC_PUSH_TIME, METRIC_SAMPLE_EVERY);
+  Node<T>* newNode = m_nodes.Allocate(std::forward<Args>(args)...); //create new node
   newNode->SetNext(m_top); //insert it at the top
   m_top = newNode; //reassign the new top of the stack
   m_size++; //increment size
+  CountMetric(METRIC_PUSHES);
+  PeakMetric(METRIC_PEAK_STACK, m_size);
 }
 
 // Name: Pop
 // Description: If stack is empty, throw runtime_error("Stack is empty");
-//              Temporarily stores data from node at the top of the stack.
-//              Removes the node from the top of the stack. Returns the stored data.
+//              Moves the data out of the node at the top of the stack.
+//              Removes the node from the top of the stack. Returns the moved data.
 // Preconditions: Stack has at least one node
 // Postconditions: See description
 template <typename T>
 T Stack<T>::Pop(){
-  T data;
+  MetricTimer timer(METRIC_POP_TIME, METRIC_SAMPLE_EVERY);
   if (m_top == nullptr){ //If empty error
     throw runtime_error("Stack is empty.");
   }
-  else{
-    Node<T>* temp = m_top;
-    data = temp->GetData(); //store data at the top of the stack
-    m_top = m_top->GetNext(); //move top ptr down one (which will be the top node after deletion)
-    delete temp; //delete the top node
-    temp = nullptr; //free temp
-  }
+  Node<T>* temp = m_top;
+  T data = std::move(temp->GetData()); //move data out of the top of the stack
+  m_top = m_top->GetNext(); //move top ptr down one (which will be the top node after deletion)
+  m_nodes.Release(temp); //delete the top node
+  m_size--; //decrement size
+  CountMetric(METRIC_POPS);
   return data;
 }
 
 // Name: Peek
 // Description: If stack is empty, throw runtime_error("Stack is empty");
-//              Returns the stored data from top node.
+//              Returns the stored data from top node. The reference stays
+//              valid until the node is popped.
 // Preconditions: Stack has at least one node
 // Postconditions: See description
 template <typename T>
-T Stack<T>::Peek() const{
+const T& Stack<T>::Peek() const{
   if (m_top == nullptr){
     throw runtime_error("Stack is empty");
   }
@@ -310,20 +367,19 @@ bool Stack<T>::IsEmpty() const{return m_top == nullptr;}
 
 // Name: RemoveBottom
 // Description: If stack is empty, throw runtime_error("Stack is empty")
-//              Temporarily stores data from node at the bottom of the stack.
-//              Removes node from bottom of the stack. Returns the stored data.
+//              Moves the data out of the node at the bottom of the stack.
+//              Removes node from bottom of the stack. Returns the moved data.
 //              Similar to Pop but opposite end of stack
 // Preconditions: Stack has at least one node
 // Postconditions: Removes node from bottom of stack and returns data
 template <typename T>
 T Stack<T>::RemoveBottom(){
-  T data; //varaible to store deleted data
   if (m_top == nullptr){ //if empty
     throw runtime_error("Stack is empty");
   }
   else if(m_top->GetNext() == nullptr){ //if theres only 1 node in the stack
-    data = m_top->GetData();
-    delete m_top; //delete the only node in the stack
+    T data = std::move(m_top->GetData());
+    m_nodes.Release(m_top); //delete the only node in the stack
     m_top = nullptr;
     m_size = 0; //size will be 0 as the stack is empty now
     return data;
@@ -334,8 +390,8 @@ T Stack<T>::RemoveBottom(){
     prev = temp;
     temp = temp->GetNext();
   }
-  data = temp->GetData(); //store last node data
-  delete temp; //delete the last node
+  T data = std::move(temp->GetData()); //move last node data
+  m_nodes.Release(temp); //delete the last node
   prev->SetNext(nullptr); //set the second-to-last (new bottm node) ptr to nullptr
   m_size--; //decrement size
   return data;
@@ -367,3 +423,23 @@ void Stack<T>::Display(){
 // Postconditions: Returns the number of nodes in the stack.
 template <typename T>
 size_t Stack<T>::GetSize() const{return m_size;}
+
+// Name: ForEach
+// Description: Calls visit with the data of each node, starting at the top
+// Preconditions: None
+// Postconditions: Stack is unchanged
+template <typename T>
+template <typename F>
+void Stack<T>::ForEach(F visit) const{
+  for (Node<T>* curr = m_top; curr != nullptr; curr = curr->GetNext()){
+    visit(curr->GetData());
+  }
+}
+
+// Name: Reserve
+// Description: Matches RingStack::Reserve. Nodes come from m_nodes a block
+//              at a time, so there is nothing to reserve.
+// Preconditions: None
+// Postconditions: None
+template <typename T>
+void Stack<T>::Reserve(size_t){}
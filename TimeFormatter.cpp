@@ -0,0 +1,98 @@
+/*Title: TimeFormatter.cpp
+  Author: Shariq Moghees
+  Date: 10/17/2026
+  Description: This class formats timestamps as local date and time text
+               without calling localtime for every timestamp
+*/
+#include "TimeFormatter.h"
+#include <cstring>
+
+// Name: WriteTwo
+// Description: Writes value as two digits
+// Preconditions: 0 <= value < 100
+// Postconditions: None
+static void WriteTwo(char* out, int value){
+    out[0] = static_cast<char>('0' + value / 10);
+    out[1] = static_cast<char>('0' + value % 10);
+}
+
+// Name: TimeFormatter (Default constructor)
+// Description: Creates a formatter with nothing cached
+// Preconditions: None
+// Postconditions: Creates a new TimeFormatter
+TimeFormatter::TimeFormatter()
+    :m_dayStart(0),m_dayEnd(0),m_minuteStart(0),m_minuteEnd(0){
+    memset(m_text, 0, sizeof(m_text));
+}
+
+// Name: Format
+// Description: Writes a millisecond timestamp as local date and time
+//              text to out
+// Preconditions: out has room for TIME_TEXT_LENGTH characters
+// Postconditions: out holds the text (not null terminated)
+void TimeFormatter::Format(int64_t timestamp, char* out){
+    timestamp = timestamp / MS_PER_SECOND - (timestamp % MS_PER_SECOND < 0); //round down
+    if (timestamp < m_minuteStart || timestamp >= m_minuteEnd){
+        if (timestamp < m_dayStart || timestamp >= m_dayEnd){
+            tm local;
+            CacheDay(timestamp, local);
+            if (timestamp < m_dayStart || timestamp >= m_dayEnd){ //clock change day
+                char text[TIME_TEXT_LENGTH + 1];
+                strftime(text, sizeof(text), "%Y-%m-%d %H:%M:%S", &local);
+                memcpy(out, text, TIME_TEXT_LENGTH);
+                return;
+            }
+        }
+        //same day, so the hour and minute are plain arithmetic
+        int minutes = static_cast<int>((timestamp - m_dayStart) / 60);
+        WriteTwo(m_text + 11, minutes / 60);
+        WriteTwo(m_text + 14, minutes % 60);
+        m_minuteStart = m_dayStart + minutes * 60;
+        m_minuteEnd = m_minuteStart + 60;
+    }
+    memcpy(out, m_text, TIME_MINUTE_LENGTH);
+    WriteTwo(out + TIME_MINUTE_LENGTH, static_cast<int>(timestamp - m_minuteStart));
+}
+
+// Name: CacheDay
+// Description: Converts timestamp with the reentrant localtime and caches
+//              its day if the day has no clock change
+// Preconditions: None
+// Postconditions: Sets local to the local time of timestamp
+void TimeFormatter::CacheDay(int64_t timestamp, tm& local){
+    m_dayEnd = m_dayStart; //empty until the day checks out
+    m_minuteEnd = m_minuteStart;
+    if (!ToLocal(timestamp, local)){
+        memset(&local, 0, sizeof(local));
+        return;
+    }
+    int64_t start = timestamp - (local.tm_hour * 3600 + local.tm_min * 60 + local.tm_sec);
+    //the day is only cacheable if it runs from 00:00:00 to 23:59:59 of the
+    //same date, which a clock change that day would break
+    tm first;
+    tm last;
+    if (!ToLocal(start, first) || first.tm_mday != local.tm_mday ||
+        first.tm_hour != 0 || first.tm_min != 0 || first.tm_sec != 0 ||
+        !ToLocal(start + SECONDS_PER_DAY - 1, last) || last.tm_mday != local.tm_mday ||
+        last.tm_hour != 23 || last.tm_min != 59 || last.tm_sec != 59){
+        return;
+    }
+    strftime(m_text, sizeof(m_text), "%Y-%m-%d ", &local);
+    m_text[13] = ':';
+    m_text[16] = ':';
+    m_dayStart = start;
+    m_dayEnd = start + SECONDS_PER_DAY;
+}
+
+// Name: ToLocal
+// Description: Converts timestamp to local time without shared state
+// Preconditions: None
+// Postconditions: Returns false if the timestamp cannot be converted
+bool TimeFormatter::ToLocal(int64_t timestamp, tm& local){
+    time_t time = static_cast<time_t>(timestamp);
+#if defined(_WIN32)
+    return localtime_s(&local, &time) == 0;
+#else
+    return localtime_r(&time, &local) != nullptr;
+#endif
+}
@@ -0,0 +1,62 @@
+/*Title: TimeFormatter.h
+  Author: Shariq Moghees
+  Date: 10/17/2026
+  Description: This class formats timestamps as local date and time text
+               without calling localtime for every timestamp
+*/
+#ifndef TIME_FORMATTER_H //Header guards
+#define TIME_FORMATTER_H //Header guards
+
+#include <cstddef>
+#include <cstdint>
+#include <ctime>
+using namespace std;
+
+//Constants
+const size_t TIME_TEXT_LENGTH = 19; //Characters in "YYYY-MM-DD HH:MM:SS"
+const size_t TIME_MINUTE_LENGTH = 17; //Characters in "YYYY-MM-DD HH:MM:"
+const int64_t SECONDS_PER_DAY = 24 * 60 * 60; //Seconds in a day without a clock change
+const int64_t MS_PER_SECOND = 1000; //History timestamps are milliseconds since the epoch
+
+//Formats millisecond timestamps as "YYYY-MM-DD HH:MM:SS" in local time
+//(milliseconds are not shown), the same text
+//NavigationEntry::DisplayTimeStamp builds. The date and local midnight of
+//the last day seen are cached, so timestamps from the same day only need
+//arithmetic, and the text up to the minute is kept so the same minute only
+//needs its seconds. A day with a clock change is formatted one call at a
+//time. Conversions use localtime_r, so separate formatters can be used from
+//separate threads; one formatter is not shared between threads.
+class TimeFormatter {
+ public:
+  // Name: TimeFormatter (Default constructor)
+  // Description: Creates a formatter with nothing cached
+  // Preconditions: None
+  // Postconditions: Creates a new TimeFormatter
+  TimeFormatter();
+  // Name: Format
+  // Description: Writes a millisecond timestamp as local date and time
+  //              text to out
+  // Preconditions: out has room for TIME_TEXT_LENGTH characters
+  // Postconditions: out holds the text (not null terminated)
+  void Format(int64_t timestamp, char* out);
+ private:
+  // Name: CacheDay
+  // Description: Converts timestamp with the reentrant localtime and caches
+  //              its day if the day has no clock change
+  // Preconditions: None
+  // Postconditions: Sets local to the local time of timestamp
+  void CacheDay(int64_t timestamp, tm& local);
+  // Name: ToLocal
+  // Description: Converts timestamp to local time without shared state
+  // Preconditions: None
+  // Postconditions: Returns false if the timestamp cannot be converted
+  static bool ToLocal(int64_t timestamp, tm& local);
+
+  int64_t m_dayStart; //Local midnight of the cached day
+  int64_t m_dayEnd; //Next local midnight (equal to m_dayStart when unset)
+  int64_t m_minuteStart; //First second of the cached minute
+  int64_t m_minuteEnd; //First second after it (equal to m_minuteStart when unset)
+  char m_text[TIME_TEXT_LENGTH]; //"YYYY-MM-DD HH:MM:" of the cached minute
+};
+
+#endif
@@ -0,0 +1,372 @@
+/*Title: TimeIndex.cpp
+  Author: Shariq Moghees
+  Date: 10/17/2026
+  Description: These classes index browser history by timestamp so visits in
+               a time range are found without walking the stacks
+*/
+#include "TimeIndex.h"
+#include <algorithm>
+#include <climits>
+
+// Name: TimeIndex (Overloaded constructor)
+// Description: Creates an empty index over URLs interned in urls
+// Preconditions: urls outlives the index
+// Postconditions: Creates a new TimeIndex with no entries
+TimeIndex::TimeIndex(const UrlTable& urls)
+    :m_urls(urls),m_size(0),m_removed(0),m_sorted(true){}
+
+// Name: Append
+// Description: Adds a visit after the newest position
+// Preconditions: None
+// Postconditions: GetSize() grows by one
+void TimeIndex::Append(UrlId id, int64_t timestamp){
+    if (m_sorted && m_size > 0){ //one step down and queries fall back to bounds
+        const Block& newest = m_blocks.back();
+        m_sorted = (newest.m_base + newest.m_deltas[newest.m_end - 1] <= timestamp);
+    }
+    if (m_blocks.empty() || m_blocks.back().m_end == TIME_BLOCK_SIZE ||
+        timestamp - m_blocks.back().m_base < TIME_DELTA_MIN ||
+        timestamp - m_blocks.back().m_base > TIME_DELTA_MAX){ //start a block
+        m_blocks.emplace_back();
+        Block& block = m_blocks.back();
+        block.m_base = timestamp;
+        block.m_min = INT64_MAX;
+        block.m_max = INT64_MIN;
+        block.m_serial = m_removed + m_size;
+        block.m_start = 0;
+        block.m_end = 0;
+    }
+    Block& block = m_blocks.back();
+    block.m_deltas[block.m_end] = static_cast<int32_t>(timestamp - block.m_base);
+    block.m_ids[block.m_end] = id;
+    block.m_end++;
+    block.m_min = min(block.m_min, timestamp);
+    block.m_max = max(block.m_max, timestamp);
+    m_size++;
+}
+
+// Name: RemoveOldest
+// Description: Drops the oldest position
+// Preconditions: GetSize() is greater than 0
+// Postconditions: GetSize() shrinks by one
+void TimeIndex::RemoveOldest(){
+    Block& block = m_blocks.front();
+    block.m_start++;
+    if (block.m_start == block.m_end){
+        m_blocks.pop_front();
+    }
+    m_size--;
+    m_removed++;
+}
+
+// Name: Truncate
+// Description: Drops the newest positions until size are left
+// Preconditions: None
+// Postconditions: GetSize() is at most size
+void TimeIndex::Truncate(size_t size){
+    while (m_size > size){
+        Block& block = m_blocks.back();
+        size_t drop = min(m_size - size, static_cast<size_t>(block.m_end - block.m_start));
+        block.m_end -= static_cast<uint32_t>(drop);
+        m_size -= drop;
+        if (block.m_start == block.m_end){ //whole block dropped at once
+            m_blocks.pop_back();
+        }
+    }
+}
+
+// Name: Clear
+// Description: Removes every position
+// Preconditions: None
+// Postconditions: GetSize() is 0
+void TimeIndex::Clear(){
+    m_blocks.clear();
+    m_size = 0;
+    m_removed = 0;
+    m_sorted = true;
+}
+
+// Name: Between
+// Description: Starts a query for the visits with from <= timestamp <= to,
+//              oldest first
+// Preconditions: None
+// Postconditions: The query is valid until the index changes
+TimeQuery TimeIndex::Between(int64_t from, int64_t to) const{
+    if (m_blocks.empty() || from > to){ //nothing can match
+        return TimeQuery(*this, from, to, 0, false, m_blocks.size(), 0);
+    }
+    if (!m_sorted){ //bounds will skip blocks as the query walks
+        return TimeQuery(*this, from, to, SIZE_MAX, false, 0, m_blocks.front().m_start);
+    }
+    //first block that reaches from, then the first position in it
+    size_t low = 0;
+    size_t high = m_blocks.size();
+    while (low < high){
+        size_t mid = low + (high - low) / 2;
+        if (GetMax(m_blocks[mid]) < from){
+            low = mid + 1;
+        } else{
+            high = mid;
+        }
+    }
+    if (low == m_blocks.size()){ //every visit is earlier
+        return TimeQuery(*this, from, to, 0, false, m_blocks.size(), 0);
+    }
+    const Block& block = m_blocks[low];
+    const int32_t* first = lower_bound(block.m_deltas + block.m_start, block.m_deltas + block.m_end,
+                                       ToDelta(from, block.m_base));
+    return TimeQuery(*this, from, to, SIZE_MAX, false, low, first - block.m_deltas);
+}
+
+// Name: Before
+// Description: Starts a query for the newest count visits with a
+//              timestamp earlier than before, newest first
+// Preconditions: None
+// Postconditions: The query is valid until the index changes
+TimeQuery TimeIndex::Before(int64_t before, size_t count) const{
+    if (m_blocks.empty() || before == INT64_MIN || count == 0){ //nothing can match
+        return TimeQuery(*this, INT64_MIN, INT64_MIN, 0, true, m_blocks.size(), 0);
+    }
+    int64_t to = before - 1;
+    if (!m_sorted){ //bounds will skip blocks as the query walks
+        return TimeQuery(*this, INT64_MIN, to, count, true, m_blocks.size() - 1,
+                         m_blocks.back().m_end);
+    }
+    //last block that starts at or before to, then one past its last match
+    size_t low = 0;
+    size_t high = m_blocks.size();
+    while (low < high){
+        size_t mid = low + (high - low) / 2;
+        if (GetMin(m_blocks[mid]) <= to){
+            low = mid + 1;
+        } else{
+            high = mid;
+        }
+    }
+    if (low == 0){ //every visit is later
+        return TimeQuery(*this, INT64_MIN, to, 0, true, m_blocks.size(), 0);
+    }
+    const Block& block = m_blocks[low - 1];
+    const int32_t* last = upper_bound(block.m_deltas + block.m_start, block.m_deltas + block.m_end,
+                                      ToDelta(to, block.m_base));
+    return TimeQuery(*this, INT64_MIN, to, count, true, low - 1, last - block.m_deltas);
+}
+
+// Name: CountBetween
+// Description: Counts the visits with from <= timestamp <= to
+// Preconditions: None
+// Postconditions: None
+size_t TimeIndex::CountBetween(int64_t from, int64_t to) const{
+    size_t count = 0;
+    if (from > to){
+        return 0;
+    }
+    for (const Block& block : m_blocks){
+        int64_t low = GetMin(block);
+        int64_t high = GetMax(block);
+        if (m_sorted && low > to){ //sorted, so no later block can match
+            break;
+        }
+        if (high < from || low > to){ //bounds miss the range
+            continue;
+        }
+        size_t live = block.m_end - block.m_start;
+        if (low >= from && high <= to){ //every live visit is in range
+            count += live;
+        } else{
+            count += CountInRange(block.m_deltas + block.m_start, live,
+                                  ToDelta(from, block.m_base), ToDelta(to, block.m_base));
+        }
+    }
+    return count;
+}
+
+// Name: CollectBetween
+// Description: Adds the position of each visit with from <= timestamp <= to
+//              to positions, oldest first
+// Preconditions: None
+// Postconditions: None
+void TimeIndex::CollectBetween(int64_t from, int64_t to, vector<size_t>& positions) const{
+    if (from > to){
+        return;
+    }
+    uint32_t found[TIME_BLOCK_SIZE]; //slots matched in one block
+    for (const Block& block : m_blocks){
+        int64_t low = GetMin(block);
+        int64_t high = GetMax(block);
+        if (m_sorted && low > to){
+            break;
+        }
+        if (high < from || low > to){
+            continue;
+        }
+        size_t first = static_cast<size_t>(block.m_serial - m_removed) + block.m_start; //position of m_start
+        size_t live = block.m_end - block.m_start;
+        if (low >= from && high <= to){
+            for (size_t i = 0; i < live; i++){
+                positions.push_back(first + i);
+            }
+            continue;
+        }
+        size_t count = CollectInRange(block.m_deltas + block.m_start, live,
+                                      ToDelta(from, block.m_base), ToDelta(to, block.m_base), found);
+        for (size_t i = 0; i < count; i++){
+            positions.push_back(first + found[i]);
+        }
+    }
+}
+
+// Name: FindPositions
+// Description: Adds the position of each visit to URL id to positions,
+//              oldest first
+// Preconditions: None
+// Postconditions: None
+void TimeIndex::FindPositions(UrlId id, vector<size_t>& positions) const{
+    uint32_t found[TIME_BLOCK_SIZE];
+    for (const Block& block : m_blocks){ //no bounds on ids, so every block is scanned
+        size_t first = static_cast<size_t>(block.m_serial - m_removed) + block.m_start;
+        size_t count = CollectEqual(block.m_ids + block.m_start, block.m_end - block.m_start, id,
+                                    found);
+        for (size_t i = 0; i < count; i++){
+            positions.push_back(first + found[i]);
+        }
+    }
+}
+
+// Name: CountByHour
+// Description: Sets hours to HOURS_PER_DAY counts of the visits in each
+//              hour of the day, on a clock utcOffset milliseconds ahead
+//              of UTC
+// Preconditions: None
+// Postconditions: None
+void TimeIndex::CountByHour(int64_t utcOffset, vector<size_t>& hours) const{
+    hours.assign(HOURS_PER_DAY, 0);
+    for (const Block& block : m_blocks){
+        AddHourCounts(block.m_deltas + block.m_start, block.m_end - block.m_start,
+                      block.m_base + utcOffset, hours.data());
+    }
+}
+
+// Name: GetTimeStamp
+// Description: Returns the timestamp of a position, 0 being the oldest
+// Preconditions: position < GetSize()
+// Postconditions: None
+int64_t TimeIndex::GetTimeStamp(size_t position) const{
+    uint64_t serial = m_removed + position;
+    //blocks are full unless a timestamp split them, so guess before searching
+    size_t guess = static_cast<size_t>((serial - m_blocks.front().m_serial) / TIME_BLOCK_SIZE);
+    if (guess >= m_blocks.size() || m_blocks[guess].m_serial > serial ||
+        serial - m_blocks[guess].m_serial >= m_blocks[guess].m_end){
+        size_t low = 0;
+        size_t high = m_blocks.size();
+        while (high - low > 1){ //last block whose first serial is at most serial
+            size_t mid = low + (high - low) / 2;
+            if (m_blocks[mid].m_serial <= serial){
+                low = mid;
+            } else{
+                high = mid;
+            }
+        }
+        guess = low;
+    }
+    const Block& block = m_blocks[guess];
+    return block.m_base + block.m_deltas[serial - block.m_serial];
+}
+
+// Name: GetSize
+// Description: Returns the number of positions indexed
+// Preconditions: None
+// Postconditions: None
+size_t TimeIndex::GetSize() const{return m_size;}
+
+// Name: IsSorted
+// Description: Returns true if the timestamps never go down, oldest first
+// Preconditions: None
+// Postconditions: None
+bool TimeIndex::IsSorted() const{return m_sorted;}
+
+// Name: GetMin
+// Description: Returns a lower bound on the live timestamps of a block
+// Preconditions: block is not empty
+// Postconditions: None
+int64_t TimeIndex::GetMin(const Block& block) const{
+    return m_sorted ? block.m_base + block.m_deltas[block.m_start] : block.m_min; //exact when sorted
+}
+
+// Name: GetMax
+// Description: Returns an upper bound on the live timestamps of a block
+// Preconditions: block is not empty
+// Postconditions: None
+int64_t TimeIndex::GetMax(const Block& block) const{
+    return m_sorted ? block.m_base + block.m_deltas[block.m_end - 1] : block.m_max; //exact when sorted
+}
+
+// Name: ToDelta
+// Description: Returns timestamp less base, clamped to just outside the
+//              deltas a block stores so searches still order correctly
+// Preconditions: None
+// Postconditions: None
+int32_t TimeIndex::ToDelta(int64_t timestamp, int64_t base){
+    if (timestamp < base + TIME_DELTA_MIN){ //base is within range of any timestamp stored
+        return INT32_MIN;
+    }
+    if (timestamp > base + TIME_DELTA_MAX){
+        return INT32_MAX;
+    }
+    return static_cast<int32_t>(timestamp - base);
+}
+
+// Name: TimeQuery (Overloaded constructor)
+// Description: Creates a query starting at position slot of block
+// Preconditions: None
+// Postconditions: Next() reads from block, slot
+TimeQuery::TimeQuery(const TimeIndex& index, int64_t from, int64_t to, size_t limit, bool backward,
+                     size_t block, size_t slot)
+    :m_index(&index),m_from(from),m_to(to),m_left(limit),m_backward(backward),
+     m_block(block),m_slot(slot){}
+
+// Name: Next
+// Description: Reads the next visit in the query
+// Preconditions: The index has not changed since the query started
+// Postconditions: Returns false once every visit has been read
+bool TimeQuery::Next(string_view& url, int64_t& timestamp){
+    const deque<TimeIndex::Block>& blocks = m_index->m_blocks;
+    size_t done = blocks.size();
+    while (m_left > 0 && m_block < done){
+        const TimeIndex::Block& block = blocks[m_block];
+        //backward queries keep m_slot one past the next position
+        if (m_backward ? m_slot > block.m_start : m_slot < block.m_end){
+            size_t slot = m_backward ? --m_slot : m_slot++;
+            int64_t time = block.m_base + block.m_deltas[slot];
+            if (time >= m_from && time <= m_to){
+                url = m_index->m_urls.Get(block.m_ids[slot]);
+                timestamp = time;
+                m_left--;
+                return true;
+            }
+            if (m_index->m_sorted && (m_backward ? time < m_from : time > m_to)){
+                m_block = done; //sorted, so nothing further can match
+            }
+            continue;
+        }
+        //block finished: move to the next block whose bounds meet the range
+        while (true){
+            if (m_backward ? m_block == 0 : m_block + 1 == done){
+                m_block = done;
+                break;
+            }
+            m_block = m_backward ? m_block - 1 : m_block + 1;
+            const TimeIndex::Block& next = blocks[m_block];
+            if (m_index->m_sorted && (m_backward ? m_index->GetMax(next) < m_from
+                                                 : m_index->GetMin(next) > m_to)){
+                m_block = done; //sorted, so no later block can match
+                break;
+            }
+            if (m_index->GetMax(next) >= m_from && m_index->GetMin(next) <= m_to){
+                m_slot = m_backward ? next.m_end : next.m_start;
+                break;
+            }
+        }
+    }
+    return false;
+}
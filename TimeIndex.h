@@ -0,0 +1,183 @@
+/*Title: TimeIndex.h
+  Author: Shariq Moghees
+  Date: 10/17/2026
+  Description: These classes index browser history by timestamp so visits in
+               a time range are found without walking the stacks
+*/
+#ifndef TIME_INDEX_H //Header guards
+#define TIME_INDEX_H //Header guards
+
+#include <cstdint>
+#include <climits>
+#include <deque>
+#include <string_view>
+#include <vector>
+#include "ScanKernels.h"
+#include "UrlTable.h"
+using namespace std;
+
+//Constants
+const size_t TIME_BLOCK_SIZE = 256; //History positions per timestamp block
+const int64_t TIME_DELTA_MIN = INT32_MIN + 1; //Smallest delta a block stores
+const int64_t TIME_DELTA_MAX = INT32_MAX - 1; //Largest delta a block stores
+
+class TimeQuery;
+
+//Timestamp and URL of every history position (oldest first), kept in fixed
+//blocks with the smallest and largest timestamp of each block. Each block
+//stores its timestamps as 32-bit deltas from the block's first timestamp,
+//about 24 days either way at millisecond resolution; a timestamp further
+//out starts a new block. While the timestamps never go down, a query binary
+//searches for its first block and stops at the first timestamp past the
+//range, so it costs O(log n + k). Otherwise it skips every block whose
+//bounds miss the range. The count and collect scans take a block whole
+//when its bounds sit inside the range and hand the rest of the deltas to
+//the SIMD kernels in ScanKernels.h.
+class TimeIndex {
+ public:
+  // Name: TimeIndex (Overloaded constructor)
+  // Description: Creates an empty index over URLs interned in urls
+  // Preconditions: urls outlives the index
+  // Postconditions: Creates a new TimeIndex with no entries
+  TimeIndex(const UrlTable& urls);
+  // Name: Append
+  // Description: Adds a visit after the newest position
+  // Preconditions: None
+  // Postconditions: GetSize() grows by one
+  void Append(UrlId id, int64_t timestamp);
+  // Name: RemoveOldest
+  // Description: Drops the oldest position
+  // Preconditions: GetSize() is greater than 0
+  // Postconditions: GetSize() shrinks by one
+  void RemoveOldest();
+  // Name: Truncate
+  // Description: Drops the newest positions until size are left
+  // Preconditions: None
+  // Postconditions: GetSize() is at most size
+  void Truncate(size_t size);
+  // Name: Clear
+  // Description: Removes every position
+  // Preconditions: None
+  // Postconditions: GetSize() is 0
+  void Clear();
+  // Name: Between
+  // Description: Starts a query for the visits with from <= timestamp <= to,
+  //              oldest first
+  // Preconditions: None
+  // Postconditions: The query is valid until the index changes
+  TimeQuery Between(int64_t from, int64_t to) const;
+  // Name: Before
+  // Description: Starts a query for the newest count visits with a
+  //              timestamp earlier than before, newest first
+  // Preconditions: None
+  // Postconditions: The query is valid until the index changes
+  TimeQuery Before(int64_t before, size_t count) const;
+  // Name: CountBetween
+  // Description: Counts the visits with from <= timestamp <= to
+  // Preconditions: None
+  // Postconditions: None
+  size_t CountBetween(int64_t from, int64_t to) const;
+  // Name: CollectBetween
+  // Description: Adds the position of each visit with from <= timestamp <= to
+  //              to positions, oldest first
+  // Preconditions: None
+  // Postconditions: None
+  void CollectBetween(int64_t from, int64_t to, vector<size_t>& positions) const;
+  // Name: FindPositions
+  // Description: Adds the position of each visit to URL id to positions,
+  //              oldest first
+  // Preconditions: None
+  // Postconditions: None
+  void FindPositions(UrlId id, vector<size_t>& positions) const;
+  // Name: CountByHour
+  // Description: Sets hours to HOURS_PER_DAY counts of the visits in each
+  //              hour of the day, on a clock utcOffset milliseconds ahead
+  //              of UTC
+  // Preconditions: None
+  // Postconditions: None
+  void CountByHour(int64_t utcOffset, vector<size_t>& hours) const;
+  // Name: GetTimeStamp
+  // Description: Returns the timestamp of a position, 0 being the oldest
+  // Preconditions: position < GetSize()
+  // Postconditions: None
+  int64_t GetTimeStamp(size_t position) const;
+  // Name: GetSize
+  // Description: Returns the number of positions indexed
+  // Preconditions: None
+  // Postconditions: None
+  size_t GetSize() const;
+  // Name: IsSorted
+  // Description: Returns true if the timestamps never go down, oldest first
+  // Preconditions: None
+  // Postconditions: None
+  bool IsSorted() const;
+ private:
+  friend class TimeQuery;
+
+  //Up to TIME_BLOCK_SIZE positions. Only [m_start, m_end) is in the history.
+  //m_min and m_max cover every timestamp ever stored in the block, so they
+  //can be looser than the live range but never tighter.
+  struct Block {
+    int64_t m_base; //Timestamp the deltas are measured from
+    int64_t m_min; //Smallest timestamp stored
+    int64_t m_max; //Largest timestamp stored
+    uint64_t m_serial; //Serial of position 0 of the block
+    uint32_t m_start; //First live position
+    uint32_t m_end; //One past the last live position
+    int32_t m_deltas[TIME_BLOCK_SIZE]; //Timestamp of each position less m_base
+    UrlId m_ids[TIME_BLOCK_SIZE]; //URL of each position
+  };
+
+  // Name: GetMin
+  // Description: Returns a lower bound on the live timestamps of a block
+  // Preconditions: block is not empty
+  // Postconditions: None
+  int64_t GetMin(const Block& block) const;
+  // Name: GetMax
+  // Description: Returns an upper bound on the live timestamps of a block
+  // Preconditions: block is not empty
+  // Postconditions: None
+  int64_t GetMax(const Block& block) const;
+  // Name: ToDelta
+  // Description: Returns timestamp less base, clamped to just outside the
+  //              deltas a block stores so searches still order correctly
+  // Preconditions: None
+  // Postconditions: None
+  static int32_t ToDelta(int64_t timestamp, int64_t base);
+
+  const UrlTable& m_urls; //Text of the indexed URLs
+  deque<Block> m_blocks; //Positions oldest first, no block is empty
+  size_t m_size; //Live positions across all blocks
+  uint64_t m_removed; //Positions ever dropped from the oldest end
+  bool m_sorted; //True while no timestamp is less than the one before it
+};
+
+//Walks the results of a TimeIndex query one visit at a time without
+//allocating. Any change to the history invalidates the query.
+class TimeQuery {
+ public:
+  // Name: Next
+  // Description: Reads the next visit in the query
+  // Preconditions: The index has not changed since the query started
+  // Postconditions: Returns false once every visit has been read
+  bool Next(string_view& url, int64_t& timestamp);
+ private:
+  friend class TimeIndex;
+
+  // Name: TimeQuery (Overloaded constructor)
+  // Description: Creates a query starting at position slot of block
+  // Preconditions: None
+  // Postconditions: Next() reads from block, slot
+  TimeQuery(const TimeIndex& index, int64_t from, int64_t to, size_t limit, bool backward,
+            size_t block, size_t slot);
+
+  const TimeIndex* m_index; //Index being queried
+  int64_t m_from; //Smallest timestamp returned
+  int64_t m_to; //Largest timestamp returned
+  size_t m_left; //Visits still allowed to be returned
+  bool m_backward; //True to walk newest first
+  size_t m_block; //Block of the next position (m_blocks.size() when done)
+  size_t m_slot; //Position within m_block
+};
+
+#endif
@@ -0,0 +1,142 @@
+/*Title: Timeline.cpp
+  Author: Shariq Moghees
+  Date: 10/17/2026
+  Description: This class keeps browser history as one array of entries with
+               a cursor on the current page
+*/
+#include "Timeline.h"
+
+// Name: Timeline (Default constructor)
+// Description: Creates an empty timeline
+// Preconditions: None
+// Postconditions: GetCurrent() is nullptr
+Timeline::Timeline()
+    :m_start(0),m_cursor(0),m_removedBytes(0){}
+
+// Name: Push
+// Description: Appends entry and makes it the current page
+// Preconditions: GetForwardSize() is 0 (call TruncateForward first)
+// Postconditions: The old current page is the newest back entry
+void Timeline::Push(NavigationEntry* entry){
+    uint64_t total = m_urlBytes.empty() ? m_removedBytes : m_urlBytes.back();
+    m_entries.push_back(entry);
+    m_urlBytes.push_back(total + entry->GetURLView().length());
+    m_cursor = m_entries.size() - 1;
+}
+
+// Name: TruncateForward
+// Description: Drops every entry after the cursor in one step
+// Preconditions: None
+// Postconditions: GetForwardSize() is 0
+void Timeline::TruncateForward(){
+    if (GetSize() > 0){
+        m_entries.resize(m_cursor + 1);
+        m_urlBytes.resize(m_cursor + 1);
+    }
+}
+
+// Name: Reserve
+// Description: Makes room for count more entries without reallocating
+// Preconditions: None
+// Postconditions: None
+void Timeline::Reserve(size_t count){
+    m_entries.reserve(m_entries.size() + count);
+    m_urlBytes.reserve(m_urlBytes.size() + count);
+}
+
+// Name: Back
+// Description: Moves the cursor back steps entries, clamped to the oldest
+// Preconditions: None
+// Postconditions: Returns how many entries the cursor moved
+size_t Timeline::Back(size_t steps){
+    size_t moved = (steps < GetBackSize()) ? steps : GetBackSize();
+    m_cursor -= moved;
+    return moved;
+}
+
+// Name: Forward
+// Description: Moves the cursor forward steps entries, clamped to the newest
+// Preconditions: None
+// Postconditions: Returns how many entries the cursor moved
+size_t Timeline::Forward(size_t steps){
+    size_t moved = (steps < GetForwardSize()) ? steps : GetForwardSize();
+    m_cursor += moved;
+    return moved;
+}
+
+// Name: RemoveOldest
+// Description: Removes the oldest back entry in amortized constant time
+// Preconditions: GetBackSize() is greater than 0
+// Postconditions: Returns the removed entry
+NavigationEntry* Timeline::RemoveOldest(){
+    NavigationEntry* oldest = m_entries[m_start];
+    m_start++;
+    //once most of the array is dead slots, slide the live entries down
+    if (m_start >= TIMELINE_COMPACT_MIN && m_start * 2 >= m_entries.size()){
+        m_removedBytes = m_urlBytes[m_start - 1]; //the running totals still count them
+        m_entries.erase(m_entries.begin(), m_entries.begin() + m_start);
+        m_urlBytes.erase(m_urlBytes.begin(), m_urlBytes.begin() + m_start);
+        m_cursor -= m_start;
+        m_start = 0;
+    }
+    return oldest;
+}
+
+// Name: Clear
+// Description: Removes every entry
+// Preconditions: None
+// Postconditions: GetSize() is 0
+void Timeline::Clear(){
+    m_entries.clear();
+    m_urlBytes.clear();
+    m_start = 0;
+    m_cursor = 0;
+    m_removedBytes = 0;
+}
+
+// Name: GetCurrent
+// Description: Returns the entry at the cursor, or nullptr if empty
+// Preconditions: None
+// Postconditions: None
+NavigationEntry* Timeline::GetCurrent() const{
+    return (GetSize() == 0) ? nullptr : m_entries[m_cursor];
+}
+
+// Name: At
+// Description: Returns the entry index places after the oldest
+// Preconditions: index < GetSize()
+// Postconditions: None
+NavigationEntry* Timeline::At(size_t index) const{return m_entries[m_start + index];}
+
+// Name: GetSize
+// Description: Returns the number of entries, including the current page
+// Preconditions: None
+// Postconditions: None
+size_t Timeline::GetSize() const{return m_entries.size() - m_start;}
+
+// Name: GetBackSize
+// Description: Returns the number of entries before the cursor
+// Preconditions: None
+// Postconditions: None
+size_t Timeline::GetBackSize() const{return (GetSize() == 0) ? 0 : m_cursor - m_start;}
+
+// Name: GetForwardSize
+// Description: Returns the number of entries after the cursor
+// Preconditions: None
+// Postconditions: None
+size_t Timeline::GetForwardSize() const{
+    return (GetSize() == 0) ? 0 : m_entries.size() - m_cursor - 1;
+}
+
+// Name: GetBackBytes
+// Description: Returns the URL bytes of the entries before the cursor
+// Preconditions: None
+// Postconditions: None
+size_t Timeline::GetBackBytes() const{
+    if (GetBackSize() == 0){
+        return 0;
+    }
+    //running totals make any prefix sum a subtraction
+    uint64_t removed = (m_start == 0) ? m_removedBytes : m_urlBytes[m_start - 1];
+    return static_cast<size_t>(m_urlBytes[m_cursor - 1] - removed);
+}
@@ -0,0 +1,101 @@
+/*Title: Timeline.h
+  Author: Shariq Moghees
+  Date: 10/17/2026
+  Description: This class keeps browser history as one array of entries with
+               a cursor on the current page
+*/
+#ifndef TIMELINE_H //Header guards
+#define TIMELINE_H //Header guards
+
+#include <cstdint>
+#include <vector>
+#include "NavigationEntry.h"
+using namespace std;
+
+//Constants
+const size_t TIMELINE_COMPACT_MIN = 1024; //Evicted slots before compacting
+
+//Every entry oldest first. Entries before the cursor are the back history
+//and entries after it are the forward history, so moving back or forward
+//any number of pages only moves the cursor. Does not own the entries.
+class Timeline {
+ public:
+  // Name: Timeline (Default constructor)
+  // Description: Creates an empty timeline
+  // Preconditions: None
+  // Postconditions: GetCurrent() is nullptr
+  Timeline();
+  // Name: Push
+  // Description: Appends entry and makes it the current page
+  // Preconditions: GetForwardSize() is 0 (call TruncateForward first)
+  // Postconditions: The old current page is the newest back entry
+  void Push(NavigationEntry* entry);
+  // Name: TruncateForward
+  // Description: Drops every entry after the cursor in one step
+  // Preconditions: None
+  // Postconditions: GetForwardSize() is 0
+  void TruncateForward();
+  // Name: Reserve
+  // Description: Makes room for count more entries without reallocating
+  // Preconditions: None
+  // Postconditions: None
+  void Reserve(size_t count);
+  // Name: Back
+  // Description: Moves the cursor back steps entries, clamped to the oldest
+  // Preconditions: None
+  // Postconditions: Returns how many entries the cursor moved
+  size_t Back(size_t steps);
+  // Name: Forward
+  // Description: Moves the cursor forward steps entries, clamped to the newest
+  // Preconditions: None
+  // Postconditions: Returns how many entries the cursor moved
+  size_t Forward(size_t steps);
+  // Name: RemoveOldest
+  // Description: Removes the oldest back entry in amortized constant time
+  // Preconditions: GetBackSize() is greater than 0
+  // Postconditions: Returns the removed entry
+  NavigationEntry* RemoveOldest();
+  // Name: Clear
+  // Description: Removes every entry
+  // Preconditions: None
+  // Postconditions: GetSize() is 0
+  void Clear();
+  // Name: GetCurrent
+  // Description: Returns the entry at the cursor, or nullptr if empty
+  // Preconditions: None
+  // Postconditions: None
+  NavigationEntry* GetCurrent() const;
+  // Name: At
+  // Description: Returns the entry index places after the oldest
+  // Preconditions: index < GetSize()
+  // Postconditions: None
+  NavigationEntry* At(size_t index) const;
+  // Name: GetSize
+  // Description: Returns the number of entries, including the current page
+  // Preconditions: None
+  // Postconditions: None
+  size_t GetSize() const;
+  // Name: GetBackSize
+  // Description: Returns the number of entries before the cursor
+  // Preconditions: None
+  // Postconditions: None
+  size_t GetBackSize() const;
+  // Name: GetForwardSize
+  // Description: Returns the number of entries after the cursor
+  // Preconditions: None
+  // Postconditions: None
+  size_t GetForwardSize() const;
+  // Name: GetBackBytes
+  // Description: Returns the URL bytes of the entries before the cursor
+  // Preconditions: None
+  // Postconditions: None
+  size_t GetBackBytes() const;
+ private:
+  vector<NavigationEntry*> m_entries; //Entries oldest first (from m_start)
+  vector<uint64_t> m_urlBytes; //Running total of URL bytes through each entry
+  size_t m_start; //Index of the oldest entry not yet removed
+  size_t m_cursor; //Index of the current page
+  uint64_t m_removedBytes; //URL bytes of the entries compacted away, still in m_urlBytes
+};
+
+#endif
@@ -0,0 +1,271 @@
+/*Title: UrlSearch.cpp
+  Author: Shariq Moghees
+  Date: 10/17/2026
+  Description: This class finds the history URLs that start with typed text
+               for autocomplete
+*/
+#include "UrlSearch.h"
+#include <algorithm>
+
+// Name: UrlSearch (Overloaded constructor)
+// Description: Creates an empty search over URLs interned in urls
+// Preconditions: urls outlives the search
+// Postconditions: Creates a new UrlSearch with no keys
+UrlSearch::UrlSearch(const UrlTable& urls)
+    :m_urls(urls),m_merged(0){}
+
+// Name: Add
+// Description: Adds the keys of the URLs interned as first up to (not
+//              including) end, merging at most once. Their score bounds
+//              start from what visits holds for them.
+// Preconditions: None of the ids has been added before
+// Postconditions: Later searches can find the ids
+void UrlSearch::Add(UrlId first, UrlId end, const VisitIndex& visits){
+    for (UrlId id = first; id < end; id++){
+        VisitInfo info;
+        Bound bound = {0, INT64_MIN}; //interned but not in the history
+        if (visits.Find(id, info)){
+            bound = {info.m_count, info.m_lastTimeStamp};
+        }
+        AddKeys(id, bound);
+    }
+    if (m_recent.size() > max(SEARCH_MERGE_MIN, m_keys.size() / SEARCH_MERGE_RATIO)){
+        Merge();
+    }
+}
+
+// Name: Touch
+// Description: Raises the score bounds of id's keys to what visits now
+//              holds for it. Call after every visit to id.
+// Preconditions: None
+// Postconditions: Does nothing if id has not been added yet
+void UrlSearch::Touch(UrlId id, const VisitIndex& visits){
+    VisitInfo info;
+    if (id >= m_idBounds.size() || !visits.Find(id, info)){ //Add reads new ids itself
+        return;
+    }
+    Bound bound = {info.m_count, info.m_lastTimeStamp};
+    Raise(m_idBounds[id], bound);
+    if (id < m_merged){
+        for (uint32_t i = m_idStart[id]; i < m_idStart[id + 1]; i++){
+            size_t block = m_idKeys[i] / SEARCH_BLOCK;
+            Raise(m_blocks[block], bound);
+            Raise(m_supers[block / SEARCH_SUPER_BLOCKS], bound);
+        }
+    } else{ //an id's recent keys sit together, up to the next id's
+        size_t index = id - m_merged;
+        size_t end = (index + 1 < m_recentStart.size()) ? m_recentStart[index + 1] : m_recent.size();
+        for (size_t i = m_recentStart[index]; i < end; i++){
+            Raise(m_recentBlocks[i / SEARCH_BLOCK], bound);
+        }
+    }
+}
+
+// Name: AddKeys
+// Description: Appends the keys of one URL to m_recent and raises the
+//              bounds of their blocks to bound
+// Preconditions: id has not been added before
+// Postconditions: None
+void UrlSearch::AddKeys(UrlId id, const Bound& bound){
+    while (m_merged + m_recentStart.size() <= id){ //ids never added get no keys
+        m_recentStart.push_back(static_cast<uint32_t>(m_recent.size()));
+    }
+    if (m_idBounds.size() <= id){
+        m_idBounds.resize(id + 1, {0, INT64_MIN});
+    }
+    m_idBounds[id] = bound;
+    size_t first = m_recent.size();
+    string_view url = m_urls.Get(id);
+    if (url.empty()){
+        return;
+    }
+    m_recent.push_back({url, id});
+    //the host starts after "scheme://", or at the front without a scheme
+    size_t host = url.find("://");
+    host = (host == string_view::npos) ? 0 : host + 3;
+    size_t hostEnd = url.find_first_of("/?#", host);
+    hostEnd = (hostEnd == string_view::npos) ? url.size() : hostEnd;
+    //one key per host label except the last (the top-level domain)
+    size_t label = host;
+    size_t dot = url.find('.', label);
+    while (dot != string_view::npos && dot < hostEnd){
+        if (label > 0){ //the full URL is already a key
+            m_recent.push_back({url.substr(label), id});
+        }
+        label = dot + 1;
+        dot = url.find('.', label);
+    }
+    m_recentBlocks.resize((m_recent.size() + SEARCH_BLOCK - 1) / SEARCH_BLOCK, {0, INT64_MIN});
+    for (size_t i = first; i < m_recent.size(); i++){
+        Raise(m_recentBlocks[i / SEARCH_BLOCK], bound);
+    }
+}
+
+// Name: Search
+// Description: Finds the best count URLs in visits with a key starting
+//              with prefix, best first. A URL scores its visit count times
+//              a weight for how long before now it was last visited.
+// Preconditions: None
+// Postconditions: results holds at most count suggestions
+void UrlSearch::Search(string_view prefix, const VisitIndex& visits, int64_t now, size_t count,
+                       vector<SearchResult>& results) const{
+    results.clear();
+    if (count == 0){
+        return;
+    }
+    //sorted keys: every match sits in one run [lo, hi)
+    size_t lo = lower_bound(m_keys.begin(), m_keys.end(), prefix,
+                            [](const Key& key, string_view text){ return key.m_text < text; }) - m_keys.begin();
+    size_t hi = upper_bound(m_keys.begin() + lo, m_keys.end(), prefix,
+                            [](string_view text, const Key& key){
+                                return text < key.m_text.substr(0, text.size());
+                            }) - m_keys.begin();
+    //blocks waiting to be scored, best bound on top of a heap
+    enum Level { SUPER, BLOCK, RECENT };
+    struct Candidate {
+        size_t m_score; //Highest score a key in the range can have
+        int64_t m_last; //Newest last visit a key in the range can have
+        Level m_level; //What m_index counts
+        size_t m_index; //Super block, block or recent block
+    };
+    auto lower = [](const Candidate& a, const Candidate& b){
+        return a.m_score != b.m_score ? a.m_score < b.m_score : a.m_last < b.m_last;
+    };
+    vector<Candidate> heap;
+    auto push = [&](const Bound& bound, Level level, size_t index){
+        if (bound.m_count > 0){ //nothing under it was ever visited
+            heap.push_back({bound.m_count * Weight(now - bound.m_last), bound.m_last, level, index});
+            push_heap(heap.begin(), heap.end(), lower);
+        }
+    };
+    size_t superKeys = SEARCH_BLOCK * SEARCH_SUPER_BLOCKS;
+    for (size_t super = lo / superKeys; lo < hi && super <= (hi - 1) / superKeys; super++){
+        push(m_supers[super], SUPER, super);
+    }
+    for (size_t block = 0; block < m_recentBlocks.size(); block++){ //short unsorted tail
+        push(m_recentBlocks[block], RECENT, block);
+    }
+    while (!heap.empty()){
+        pop_heap(heap.begin(), heap.end(), lower);
+        Candidate next = heap.back();
+        heap.pop_back();
+        if (results.size() == count){ //stop once nothing left can beat the last result
+            const SearchResult& last = results.back();
+            if (next.m_score < last.m_score || (next.m_score == last.m_score && next.m_last <= last.m_lastTimeStamp)){
+                break;
+            }
+        }
+        if (next.m_level == SUPER){
+            size_t first = max(next.m_index * SEARCH_SUPER_BLOCKS, lo / SEARCH_BLOCK);
+            size_t end = min((next.m_index + 1) * SEARCH_SUPER_BLOCKS, (hi - 1) / SEARCH_BLOCK + 1);
+            for (size_t block = first; block < end; block++){
+                push(m_blocks[block], BLOCK, block);
+            }
+        } else if (next.m_level == BLOCK){
+            size_t end = min((next.m_index + 1) * SEARCH_BLOCK, hi);
+            for (size_t i = max(next.m_index * SEARCH_BLOCK, lo); i < end; i++){
+                Consider(m_keys[i].m_id, visits, now, count, results);
+            }
+        } else{
+            size_t end = min((next.m_index + 1) * SEARCH_BLOCK, m_recent.size());
+            for (size_t i = next.m_index * SEARCH_BLOCK; i < end; i++){
+                if (m_recent[i].m_text.substr(0, prefix.size()) == prefix){
+                    Consider(m_recent[i].m_id, visits, now, count, results);
+                }
+            }
+        }
+    }
+}
+
+// Name: GetKeyCount
+// Description: Returns the number of search keys
+// Preconditions: None
+// Postconditions: None
+size_t UrlSearch::GetKeyCount() const{return m_keys.size() + m_recent.size();}
+
+// Name: Merge
+// Description: Sorts m_recent into m_keys and rebuilds the key lists
+//              and block bounds
+// Preconditions: None
+// Postconditions: m_recent is empty
+void UrlSearch::Merge(){
+    auto byText = [](const Key& a, const Key& b){ return a.m_text < b.m_text; };
+    sort(m_recent.begin(), m_recent.end(), byText);
+    size_t middle = m_keys.size();
+    m_keys.insert(m_keys.end(), m_recent.begin(), m_recent.end());
+    inplace_merge(m_keys.begin(), m_keys.begin() + middle, m_keys.end(), byText);
+    m_recent.clear();
+    m_recentBlocks.clear();
+    m_recentStart.clear();
+    m_merged = static_cast<UrlId>(m_idBounds.size());
+    //group the key positions by id: count, prefix sum, then place
+    m_idStart.assign(m_merged + 1, 0);
+    for (const Key& key : m_keys){
+        m_idStart[key.m_id + 1]++;
+    }
+    for (size_t id = 0; id < m_merged; id++){
+        m_idStart[id + 1] += m_idStart[id];
+    }
+    m_idKeys.resize(m_keys.size());
+    vector<uint32_t> next(m_idStart.begin(), m_idStart.end() - 1);
+    m_blocks.assign((m_keys.size() + SEARCH_BLOCK - 1) / SEARCH_BLOCK, {0, INT64_MIN});
+    for (size_t i = 0; i < m_keys.size(); i++){
+        UrlId id = m_keys[i].m_id;
+        m_idKeys[next[id]++] = static_cast<uint32_t>(i);
+        Raise(m_blocks[i / SEARCH_BLOCK], m_idBounds[id]);
+    }
+    m_supers.assign((m_blocks.size() + SEARCH_SUPER_BLOCKS - 1) / SEARCH_SUPER_BLOCKS, {0, INT64_MIN});
+    for (size_t block = 0; block < m_blocks.size(); block++){
+        Raise(m_supers[block / SEARCH_SUPER_BLOCKS], m_blocks[block]);
+    }
+}
+
+// Name: Consider
+// Description: Scores a matching URL and keeps it if it is in the best
+//              count so far
+// Preconditions: results is sorted best first
+// Postconditions: results is sorted best first with no duplicate URL
+void UrlSearch::Consider(UrlId id, const VisitIndex& visits, int64_t now, size_t count,
+                         vector<SearchResult>& results) const{
+    VisitInfo info;
+    if (!visits.Find(id, info)){ //interned once but no longer in the history
+        return;
+    }
+    SearchResult result = {m_urls.Get(id), info.m_count, info.m_lastTimeStamp,
+                           info.m_count * Weight(now - info.m_lastTimeStamp)};
+    auto better = [](const SearchResult& a, const SearchResult& b){
+        return a.m_score != b.m_score ? a.m_score > b.m_score
+                                      : a.m_lastTimeStamp > b.m_lastTimeStamp;
+    };
+    if (results.size() == count && !better(result, results.back())){ //not in the best count
+        return;
+    }
+    for (size_t i = 0; i < results.size(); i++){ //a URL can match more than one key
+        if (results[i].m_url.data() == result.m_url.data()){
+            return;
+        }
+    }
+    if (results.size() == count){
+        results.pop_back();
+    }
+    results.insert(upper_bound(results.begin(), results.end(), result, better), result);
+}
+
+// Name: Weight
+// Description: Returns the recency weight of a last visit age ms before now
+// Preconditions: None
+// Postconditions: Older visits never weigh more
+size_t UrlSearch::Weight(int64_t age){
+    //recency buckets: the last visit within 4, 14, 31 and 90 days
+    return (age <= 4 * SEARCH_DAY) ? 100 : (age <= 14 * SEARCH_DAY) ? 70 :
+           (age <= 31 * SEARCH_DAY) ? 50 : (age <= 90 * SEARCH_DAY) ? 30 : 10;
+}
+
+// Name: Raise
+// Description: Raises bound so it also covers value
+// Preconditions: None
+// Postconditions: None
+void UrlSearch::Raise(Bound& bound, const Bound& value){
+    bound.m_count = max(bound.m_count, value.m_count);
+    bound.m_last = max(bound.m_last, value.m_last);
+}
@@ -0,0 +1,133 @@
+/*Title: UrlSearch.h
+  Author: Shariq Moghees
+  Date: 10/17/2026
+  Description: This class finds the history URLs that start with typed text
+               for autocomplete
+*/
+#ifndef URL_SEARCH_H //Header guards
+#define URL_SEARCH_H //Header guards
+
+#include <string_view>
+#include <vector>
+#include "UrlTable.h"
+#include "VisitIndex.h"
+using namespace std;
+
+//Constants
+const size_t SEARCH_MERGE_MIN = 4096; //Unsorted keys kept before merging
+const size_t SEARCH_MERGE_RATIO = 64; //Merge once unsorted keys are 1/64 of sorted ones
+const int64_t SEARCH_DAY = 24 * 60 * 60 * 1000LL; //Milliseconds in a day, for recency weights
+const size_t SEARCH_BLOCK = 64; //Keys under one score bound
+const size_t SEARCH_SUPER_BLOCKS = 64; //Blocks under one super block bound
+
+//One autocomplete suggestion
+struct SearchResult {
+  string_view m_url; //Suggested URL (owned by the UrlTable)
+  size_t m_count; //Entries in the history with this URL
+  int64_t m_lastTimeStamp; //Timestamp of the newest of them
+  size_t m_score; //Visit count weighted by how recent the last visit was
+};
+
+//Sorted search keys over every interned URL. A URL gets a key for its full
+//text and one for the start of each label of its host, so "goo" finds
+//"https://mail.google.com/". New keys wait in a short unsorted list and are
+//merged into the sorted array in bulk. Matches are ranked with the counts
+//and timestamps in a VisitIndex, so URLs that left the history drop out.
+//
+//Every block of SEARCH_BLOCK keys (and every super block of blocks) keeps
+//the largest visit count and newest last visit of its URLs, which bounds
+//the score of any key in it. Search takes blocks best bound first and
+//stops once no bound can beat the last of the count results, so a short
+//prefix matching millions of keys only scores the few blocks near the top.
+//Bounds only rise (Touch on every visit); entries leaving the history
+//leave them loose, which costs pruning but never a result.
+class UrlSearch {
+ public:
+  // Name: UrlSearch (Overloaded constructor)
+  // Description: Creates an empty search over URLs interned in urls
+  // Preconditions: urls outlives the search
+  // Postconditions: Creates a new UrlSearch with no keys
+  UrlSearch(const UrlTable& urls);
+  // Name: Add
+  // Description: Adds the keys of the URLs interned as first up to (not
+  //              including) end, merging at most once. Their score bounds
+  //              start from what visits holds for them.
+  // Preconditions: None of the ids has been added before
+  // Postconditions: Later searches can find the ids
+  void Add(UrlId first, UrlId end, const VisitIndex& visits);
+  // Name: Touch
+  // Description: Raises the score bounds of id's keys to what visits now
+  //              holds for it. Call after every visit to id.
+  // Preconditions: None
+  // Postconditions: Does nothing if id has not been added yet
+  void Touch(UrlId id, const VisitIndex& visits);
+  // Name: Search
+  // Description: Finds the best count URLs in visits with a key starting
+  //              with prefix, best first. A URL scores its visit count times
+  //              a weight for how long before now it was last visited.
+  // Preconditions: None
+  // Postconditions: results holds at most count suggestions
+  void Search(string_view prefix, const VisitIndex& visits, int64_t now, size_t count,
+              vector<SearchResult>& results) const;
+  // Name: GetKeyCount
+  // Description: Returns the number of search keys
+  // Preconditions: None
+  // Postconditions: None
+  size_t GetKeyCount() const;
+ private:
+  //Text that a URL can be found by
+  struct Key {
+    string_view m_text; //Suffix of the URL text
+    UrlId m_id; //URL the key belongs to
+  };
+  //Largest visit count and newest last visit of some URLs
+  struct Bound {
+    size_t m_count; //No URL under the bound has more visits
+    int64_t m_last; //No URL under the bound was visited later
+  };
+
+  // Name: Weight
+  // Description: Returns the recency weight of a last visit age ms before now
+  // Preconditions: None
+  // Postconditions: Older visits never weigh more
+  static size_t Weight(int64_t age);
+  // Name: Raise
+  // Description: Raises bound so it also covers value
+  // Preconditions: None
+  // Postconditions: None
+  static void Raise(Bound& bound, const Bound& value);
+
+  // Name: AddKeys
+  // Description: Appends the keys of one URL to m_recent and raises the
+  //              bounds of their blocks to bound
+  // Preconditions: id has not been added before
+  // Postconditions: None
+  void AddKeys(UrlId id, const Bound& bound);
+  // Name: Merge
+  // Description: Sorts m_recent into m_keys and rebuilds the key lists
+  //              and block bounds
+  // Preconditions: None
+  // Postconditions: m_recent is empty
+  void Merge();
+  // Name: Consider
+  // Description: Scores a matching URL and keeps it if it is in the best
+  //              count so far
+  // Preconditions: results is sorted best first
+  // Postconditions: results is sorted best first with no duplicate URL
+  void Consider(UrlId id, const VisitIndex& visits, int64_t now, size_t count,
+                vector<SearchResult>& results) const;
+
+  const UrlTable& m_urls; //Text of the searched URLs
+  vector<Key> m_keys; //Keys sorted by text
+  vector<Key> m_recent; //Keys added since the last merge, unsorted
+  vector<Bound> m_idBounds; //Bound of each added UrlId on its own
+  vector<Bound> m_blocks; //Bound of each SEARCH_BLOCK keys of m_keys
+  vector<Bound> m_supers; //Bound of each SEARCH_SUPER_BLOCKS blocks
+  vector<Bound> m_recentBlocks; //Bound of each SEARCH_BLOCK keys of m_recent
+  vector<uint32_t> m_idStart; //Keys of merged id are m_idKeys[m_idStart[id], m_idStart[id + 1])
+  vector<uint32_t> m_idKeys; //Positions in m_keys, grouped by UrlId
+  vector<uint32_t> m_recentStart; //First m_recent key of each id from m_merged on
+  UrlId m_merged; //Ids below this have their keys in m_keys
+};
+
+#endif
@@ -0,0 +1,93 @@
+/*Title: UrlTable.cpp
+  Author: Shariq Moghees
+  Date: 10/17/2026
+  Description: This class interns URLs so each distinct URL is stored once
+*/
+#include "UrlTable.h"
+#include <cstring>
+
+// Name: UrlTable (Default constructor)
+// Description: Creates an empty URL table
+// Preconditions: None
+// Postconditions: Creates a new UrlTable with no URLs
+UrlTable::UrlTable()
+    :m_chunkUsed(URL_CHUNK_SIZE),m_chunkBytes(0){}
+
+// Name: Intern
+// Description: Returns the ID of url, copying it into the table the first
+//              time it is seen
+// Preconditions: None
+// Postconditions: url is stored exactly once
+UrlId UrlTable::Intern(string_view url){
+    auto found = m_ids.find(url);
+    if (found != m_ids.end()){ //already interned
+        return found->second;
+    }
+    UrlId id = static_cast<UrlId>(m_urls.size());
+    string_view stored = Store(url);
+    m_urls.push_back(stored);
+    m_ids.emplace(stored, id); //key must view the stored copy, not the caller's
+    return id;
+}
+
+// Name: Find
+// Description: Looks up url without adding it
+// Preconditions: None
+// Postconditions: Returns true and sets id if url is in the table
+bool UrlTable::Find(string_view url, UrlId& id) const{
+    auto found = m_ids.find(url);
+    if (found == m_ids.end()){
+        return false;
+    }
+    id = found->second;
+    return true;
+}
+
+// Name: Get
+// Description: Returns the interned text for id (no copy)
+// Preconditions: id was returned by Intern
+// Postconditions: View stays valid while the table exists
+string_view UrlTable::Get(UrlId id) const{return m_urls[id];}
+
+// Name: GetSize
+// Description: Returns the number of distinct URLs
+// Preconditions: None
+// Postconditions: None
+size_t UrlTable::GetSize() const{return m_urls.size();}
+
+// Name: GetBytes
+// Description: Returns the bytes used by the URL text and lookup table
+// Preconditions: None
+// Postconditions: None
+size_t UrlTable::GetBytes() const{
+    //chunks + id array + hash nodes (key, id, next pointer, cached hash) + buckets
+    return m_chunkBytes + m_urls.capacity() * sizeof(string_view) +
+           m_ids.size() * (sizeof(string_view) + sizeof(UrlId) + 2 * sizeof(void*)) +
+           m_ids.bucket_count() * sizeof(void*);
+}
+
+// Name: Store
+// Description: Copies url into the current chunk, starting a new chunk if
+//              it does not fit
+// Preconditions: None
+// Postconditions: Returns a view of the stored copy
+string_view UrlTable::Store(string_view url){
+    if (url.empty()){ //nothing to copy
+        return string_view();
+    }
+    if (url.size() > URL_CHUNK_SIZE){ //oversized URL gets a chunk of its own
+        m_chunks.emplace(m_chunks.begin(), new char[url.size()]);
+        m_chunkBytes += url.size();
+        memcpy(m_chunks.front().get(), url.data(), url.size());
+        return string_view(m_chunks.front().get(), url.size());
+    }
+    if (URL_CHUNK_SIZE - m_chunkUsed < url.size()){ //current chunk is full
+        m_chunks.emplace_back(new char[URL_CHUNK_SIZE]);
+        m_chunkBytes += URL_CHUNK_SIZE;
+        m_chunkUsed = 0;
+    }
+    char* dest = m_chunks.back().get() + m_chunkUsed;
+    memcpy(dest, url.data(), url.size());
+    m_chunkUsed += url.size();
+    return string_view(dest, url.size());
+}
@@ -0,0 +1,74 @@
+/*Title: UrlTable.h
+  Author: Shariq Moghees
+  Date: 10/17/2026
+  Description: This class interns URLs so each distinct URL is stored once
+*/
+#ifndef URL_TABLE_H //Header guards
+#define URL_TABLE_H //Header guards
+
+#include <cstdint>
+#include <memory>
+#include <string_view>
+#include <unordered_map>
+#include <vector>
+using namespace std;
+
+//Constants
+const size_t URL_CHUNK_SIZE = 64 * 1024; //Bytes of URL text per storage chunk
+
+typedef uint32_t UrlId; //Compact handle for an interned URL
+
+//Stores every distinct URL once in large character chunks that never move,
+//so the string_views it hands out stay valid for the life of the table.
+class UrlTable {
+ public:
+  // Name: UrlTable (Default constructor)
+  // Description: Creates an empty URL table
+  // Preconditions: None
+  // Postconditions: Creates a new UrlTable with no URLs
+  UrlTable();
+  // Name: Intern
+  // Description: Returns the ID of url, copying it into the table the first
+  //              time it is seen
+  // Preconditions: None
+  // Postconditions: url is stored exactly once
+  UrlId Intern(string_view url);
+  // Name: Find
+  // Description: Looks up url without adding it
+  // Preconditions: None
+  // Postconditions: Returns true and sets id if url is in the table
+  bool Find(string_view url, UrlId& id) const;
+  // Name: Get
+  // Description: Returns the interned text for id (no copy)
+  // Preconditions: id was returned by Intern
+  // Postconditions: View stays valid while the table exists
+  string_view Get(UrlId id) const;
+  // Name: GetSize
+  // Description: Returns the number of distinct URLs
+  // Preconditions: None
+  // Postconditions: None
+  size_t GetSize() const;
+  // Name: GetBytes
+  // Description: Returns the bytes used by the URL text and lookup table
+  // Preconditions: None
+  // Postconditions: None
+  size_t GetBytes() const;
+ private:
+  UrlTable(const UrlTable&) = delete; //Views point into this table's chunks
+  UrlTable& operator=(const UrlTable&) = delete;
+
+  // Name: Store
+  // Description: Copies url into the current chunk, starting a new chunk if
+  //              it does not fit
+  // Preconditions: None
+  // Postconditions: Returns a view of the stored copy
+  string_view Store(string_view url);
+
+  vector<unique_ptr<char[]> > m_chunks; //URL text storage
+  size_t m_chunkUsed; //Bytes used in the newest chunk
+  size_t m_chunkBytes; //Bytes allocated across all chunks
+  vector<string_view> m_urls; //Interned text indexed by UrlId
+  unordered_map<string_view, UrlId> m_ids; //Interned text to UrlId
+};
+
+#endif
@@ -0,0 +1,241 @@
+/*Title: VisitIndex.cpp
+  Author: Shariq Moghees
+  Date: 10/17/2026
+  Description: This class indexes browser history by URL so visit counts and
+               last visits are found without walking the stacks
+*/
+#include "VisitIndex.h"
+#include <functional>
+
+// Name: VisitIndex (Overloaded constructor)
+// Description: Creates an empty index over URLs interned in urls that
+//              reads timestamps from times
+// Preconditions: urls and times outlive the index; times is kept to the
+//                same positions as the index
+// Postconditions: Creates a new VisitIndex with no entries
+VisitIndex::VisitIndex(const UrlTable& urls, const TimeIndex& times)
+    :m_urls(urls),m_times(times),m_used(0),m_base(0),m_cursor(0){}
+
+// Name: Append
+// Description: Adds a visit to id after the newest position and moves the
+//              cursor to it
+// Preconditions: The cursor is on the newest position (TruncateForward)
+// Postconditions: The new position is the current page
+void VisitIndex::Append(UrlId id){
+    if ((m_used + 1) * 4 > m_slots.size() * 3){ //keep the table under 3/4 full
+        Grow();
+    }
+    if (id >= m_slotOf.size()){
+        m_slotOf.resize(id + 1, NO_SLOT);
+    }
+    uint64_t serial = m_base + m_positions.size();
+    Position position = {id, 0, 0};
+    if (m_slotOf[id] == NO_SLOT){ //hash only to find a home for a new URL
+        string_view url = m_urls.Get(id);
+        uint64_t urlHash = hash<string_view>()(url);
+        m_slotOf[id] = static_cast<uint32_t>(FindSlot(url, urlHash));
+        m_slots[m_slotOf[id]].m_hash = urlHash;
+    }
+    Slot& slot = m_slots[m_slotOf[id]];
+    if (slot.m_count == 0){ //first position with this URL
+        slot.m_id = id;
+        slot.m_oldest = serial;
+        m_used++;
+    } else{ //link to the previous newest visit
+        position.m_prev = static_cast<uint32_t>(serial - slot.m_newest);
+        At(slot.m_newest).m_next = position.m_prev;
+    }
+    slot.m_count++;
+    slot.m_newest = serial;
+    m_positions.push_back(position);
+    m_cursor = serial;
+}
+
+// Name: RemoveOldest
+// Description: Drops the oldest position
+// Preconditions: GetSize() is greater than 0
+// Postconditions: The URL's count and first timestamp are updated
+void VisitIndex::RemoveOldest(){
+    const Position& oldest = m_positions.front();
+    size_t index = m_slotOf[oldest.m_id];
+    Slot& slot = m_slots[index];
+    if (slot.m_count == 1){ //last position with this URL
+        EraseSlot(index);
+    } else{ //the next visit becomes the oldest
+        slot.m_count--;
+        slot.m_oldest += oldest.m_next;
+        At(slot.m_oldest).m_prev = 0;
+    }
+    m_positions.pop_front();
+    m_base++;
+}
+
+// Name: TruncateForward
+// Description: Drops every position after the cursor
+// Preconditions: None
+// Postconditions: The cursor is on the newest position
+void VisitIndex::TruncateForward(){
+    while (m_base + m_positions.size() > m_cursor + 1){ //newest first
+        const Position& newest = m_positions.back();
+        size_t index = m_slotOf[newest.m_id];
+        Slot& slot = m_slots[index];
+        if (slot.m_count == 1){ //last position with this URL
+            EraseSlot(index);
+        } else{ //the previous visit becomes the newest
+            slot.m_count--;
+            slot.m_newest -= newest.m_prev;
+            At(slot.m_newest).m_next = 0;
+        }
+        m_positions.pop_back();
+    }
+}
+
+// Name: MoveCursor
+// Description: Moves the cursor steps positions (negative is back)
+// Preconditions: The new cursor is inside the history
+// Postconditions: Positions reported by Find are relative to the new cursor
+void VisitIndex::MoveCursor(long long steps){m_cursor += steps;}
+
+// Name: Clear
+// Description: Removes every position
+// Preconditions: None
+// Postconditions: GetSize() is 0
+void VisitIndex::Clear(){
+    m_slots.clear();
+    m_used = 0;
+    m_slotOf.clear();
+    m_positions.clear();
+    m_base = 0;
+    m_cursor = 0;
+}
+
+// Name: Find
+// Description: Looks up what the history holds for url
+// Preconditions: None
+// Postconditions: Returns true and fills info if url is in the history
+bool VisitIndex::Find(string_view url, VisitInfo& info) const{
+    if (m_used == 0){
+        return false;
+    }
+    const Slot& slot = m_slots[FindSlot(url, hash<string_view>()(url))];
+    if (slot.m_count == 0){
+        return false;
+    }
+    Fill(slot, info);
+    return true;
+}
+
+// Name: Find (by id)
+// Description: Looks up what the history holds for an interned URL
+//              without hashing its text
+// Preconditions: None
+// Postconditions: Returns true and fills info if id is in the history
+bool VisitIndex::Find(UrlId id, VisitInfo& info) const{
+    if (id >= m_slotOf.size() || m_slotOf[id] == NO_SLOT){
+        return false;
+    }
+    Fill(m_slots[m_slotOf[id]], info);
+    return true;
+}
+
+// Name: GetNewestTimeStamp
+// Description: Returns the timestamp of the newest position
+// Preconditions: GetSize() is greater than 0
+// Postconditions: None
+int64_t VisitIndex::GetNewestTimeStamp() const{
+    return m_times.GetTimeStamp(m_positions.size() - 1);
+}
+
+// Name: GetSize
+// Description: Returns the number of positions indexed
+// Preconditions: None
+// Postconditions: None
+size_t VisitIndex::GetSize() const{return m_positions.size();}
+
+// Name: GetBytes
+// Description: Returns the bytes used by the slots and position links
+// Preconditions: None
+// Postconditions: None
+size_t VisitIndex::GetBytes() const{
+    return m_slots.capacity() * sizeof(Slot) + m_slotOf.capacity() * sizeof(uint32_t) +
+           m_positions.size() * sizeof(Position);
+}
+
+// Name: FindSlot
+// Description: Probes for url, stopping at its slot or an empty one
+// Preconditions: m_slots is not empty
+// Postconditions: Returns the index of the slot
+size_t VisitIndex::FindSlot(string_view url, uint64_t hash) const{
+    size_t mask = m_slots.size() - 1;
+    size_t index = hash & mask;
+    //compare hashes first so most mismatches never touch the URL text
+    while (m_slots[index].m_count != 0 &&
+           (m_slots[index].m_hash != hash || m_urls.Get(m_slots[index].m_id) != url)){
+        index = (index + 1) & mask; //linear probing
+    }
+    return index;
+}
+
+// Name: EraseSlot
+// Description: Empties a slot and shifts later slots in its probe run back
+// Preconditions: slot holds a URL
+// Postconditions: Every remaining URL is reachable from its home slot
+void VisitIndex::EraseSlot(size_t slot){
+    size_t mask = m_slots.size() - 1;
+    size_t next = (slot + 1) & mask;
+    m_slotOf[m_slots[slot].m_id] = NO_SLOT;
+    while (m_slots[next].m_count != 0){
+        size_t home = m_slots[next].m_hash & mask;
+        //move next into the hole unless its home lies between the two
+        if (((next - home) & mask) >= ((next - slot) & mask)){
+            m_slots[slot] = m_slots[next];
+            m_slotOf[m_slots[slot].m_id] = static_cast<uint32_t>(slot);
+            slot = next;
+        }
+        next = (next + 1) & mask;
+    }
+    m_slots[slot].m_count = 0;
+    m_used--;
+}
+
+// Name: Grow
+// Description: Doubles the slot table and reinserts every URL
+// Preconditions: None
+// Postconditions: The table has twice as many slots
+void VisitIndex::Grow(){
+    vector<Slot> old;
+    old.swap(m_slots);
+    size_t size = old.empty() ? VISIT_INDEX_MIN_SLOTS : old.size() * 2;
+    m_slots.assign(size, Slot());
+    size_t mask = size - 1;
+    for (size_t i = 0; i < old.size(); i++){
+        if (old[i].m_count != 0){
+            size_t index = old[i].m_hash & mask;
+            while (m_slots[index].m_count != 0){ //URLs are distinct, no compare
+                index = (index + 1) & mask;
+            }
+            m_slots[index] = old[i];
+            m_slotOf[old[i].m_id] = static_cast<uint32_t>(index);
+        }
+    }
+}
+
+// Name: Fill
+// Description: Copies what a slot holds into info
+// Preconditions: slot holds a URL
+// Postconditions: None
+void VisitIndex::Fill(const Slot& slot, VisitInfo& info) const{
+    info.m_count = slot.m_count;
+    info.m_firstTimeStamp = m_times.GetTimeStamp(slot.m_oldest - m_base);
+    info.m_lastTimeStamp = m_times.GetTimeStamp(slot.m_newest - m_base);
+    info.m_position = static_cast<long long>(slot.m_newest - m_cursor);
+}
+
+// Name: At
+// Description: Returns the position with the given serial
+// Preconditions: serial is in the history
+// Postconditions: None
+VisitIndex::Position& VisitIndex::At(uint64_t serial){return m_positions[serial - m_base];}
+const VisitIndex::Position& VisitIndex::At(uint64_t serial) const{
+    return m_positions[serial - m_base];
+}
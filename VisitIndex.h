@@ -0,0 +1,153 @@
+/*Title: VisitIndex.h
+  Author: Shariq Moghees
+  Date: 10/17/2026
+  Description: This class indexes browser history by URL so visit counts and
+               last visits are found without walking the stacks
+*/
+#ifndef VISIT_INDEX_H //Header guards
+#define VISIT_INDEX_H //Header guards
+
+#include <cstdint>
+#include <deque>
+#include <string_view>
+#include <vector>
+#include "UrlTable.h"
+#include "TimeIndex.h"
+using namespace std;
+
+//Constants
+const size_t VISIT_INDEX_MIN_SLOTS = 16; //Slots in the table once it is used
+const uint32_t NO_SLOT = UINT32_MAX; //Slot of a URL that is not in the history
+
+//What the history holds for one URL
+struct VisitInfo {
+  size_t m_count; //Entries with this URL
+  int64_t m_firstTimeStamp; //Timestamp of the oldest entry with this URL
+  int64_t m_lastTimeStamp; //Timestamp of the newest entry with this URL
+  long long m_position; //Newest entry relative to the current page:
+                        //-k is k steps back, 0 is the current page and
+                        //+k is k steps forward
+};
+
+//Open-addressing hash table from URL to its entries in the history. Every
+//history position (oldest first) gets a serial number that never changes,
+//and each position links to the previous and next position with the same
+//URL. Dropping the oldest or newest position is then constant time, and
+//going back or forward only moves the cursor. Timestamps are not stored
+//here but read from a TimeIndex over the same positions.
+class VisitIndex {
+ public:
+  // Name: VisitIndex (Overloaded constructor)
+  // Description: Creates an empty index over URLs interned in urls that
+  //              reads timestamps from times
+  // Preconditions: urls and times outlive the index; times is kept to the
+  //                same positions as the index
+  // Postconditions: Creates a new VisitIndex with no entries
+  VisitIndex(const UrlTable& urls, const TimeIndex& times);
+  // Name: Append
+  // Description: Adds a visit to id after the newest position and moves the
+  //              cursor to it
+  // Preconditions: The cursor is on the newest position (TruncateForward)
+  // Postconditions: The new position is the current page
+  void Append(UrlId id);
+  // Name: RemoveOldest
+  // Description: Drops the oldest position
+  // Preconditions: GetSize() is greater than 0
+  // Postconditions: The URL's count and first timestamp are updated
+  void RemoveOldest();
+  // Name: TruncateForward
+  // Description: Drops every position after the cursor
+  // Preconditions: None
+  // Postconditions: The cursor is on the newest position
+  void TruncateForward();
+  // Name: MoveCursor
+  // Description: Moves the cursor steps positions (negative is back)
+  // Preconditions: The new cursor is inside the history
+  // Postconditions: Positions reported by Find are relative to the new cursor
+  void MoveCursor(long long steps);
+  // Name: Clear
+  // Description: Removes every position
+  // Preconditions: None
+  // Postconditions: GetSize() is 0
+  void Clear();
+  // Name: Find
+  // Description: Looks up what the history holds for url
+  // Preconditions: None
+  // Postconditions: Returns true and fills info if url is in the history
+  bool Find(string_view url, VisitInfo& info) const;
+  // Name: Find (by id)
+  // Description: Looks up what the history holds for an interned URL
+  //              without hashing its text
+  // Preconditions: None
+  // Postconditions: Returns true and fills info if id is in the history
+  bool Find(UrlId id, VisitInfo& info) const;
+  // Name: GetNewestTimeStamp
+  // Description: Returns the timestamp of the newest position
+  // Preconditions: GetSize() is greater than 0
+  // Postconditions: None
+  int64_t GetNewestTimeStamp() const;
+  // Name: GetSize
+  // Description: Returns the number of positions indexed
+  // Preconditions: None
+  // Postconditions: None
+  size_t GetSize() const;
+  // Name: GetBytes
+  // Description: Returns the bytes used by the slots and position links
+  // Preconditions: None
+  // Postconditions: None
+  size_t GetBytes() const;
+ private:
+  //One distinct URL. m_count is 0 for an empty slot.
+  struct Slot {
+    uint64_t m_hash; //Hash of the URL text
+    UrlId m_id; //Interned URL
+    uint32_t m_count; //Positions with this URL
+    uint64_t m_oldest; //Serial of the oldest position with this URL
+    uint64_t m_newest; //Serial of the newest position with this URL
+  };
+  //One history position. Links are distances to the neighbouring
+  //positions with the same URL, 0 when there is none.
+  struct Position {
+    UrlId m_id; //URL visited at this position
+    uint32_t m_prev; //Distance back to the previous visit of m_id
+    uint32_t m_next; //Distance forward to the next visit of m_id
+  };
+
+  // Name: FindSlot
+  // Description: Probes for url, stopping at its slot or an empty one
+  // Preconditions: m_slots is not empty
+  // Postconditions: Returns the index of the slot
+  size_t FindSlot(string_view url, uint64_t hash) const;
+  // Name: EraseSlot
+  // Description: Empties a slot and shifts later slots in its probe run back
+  // Preconditions: slot holds a URL
+  // Postconditions: Every remaining URL is reachable from its home slot
+  void EraseSlot(size_t slot);
+  // Name: Grow
+  // Description: Doubles the slot table and reinserts every URL
+  // Preconditions: None
+  // Postconditions: The table has twice as many slots
+  void Grow();
+  // Name: Fill
+  // Description: Copies what a slot holds into info
+  // Preconditions: slot holds a URL
+  // Postconditions: None
+  void Fill(const Slot& slot, VisitInfo& info) const;
+  // Name: At
+  // Description: Returns the position with the given serial
+  // Preconditions: serial is in the history
+  // Postconditions: None
+  Position& At(uint64_t serial);
+  const Position& At(uint64_t serial) const;
+
+  const UrlTable& m_urls; //Text of the indexed URLs
+  const TimeIndex& m_times; //Timestamps of the same positions
+  vector<Slot> m_slots; //Open-addressing table, size is a power of two
+  size_t m_used; //Slots holding a URL
+  vector<uint32_t> m_slotOf; //Slot of each UrlId, or NO_SLOT
+  deque<Position> m_positions; //History positions oldest first
+  uint64_t m_base; //Serial of m_positions.front()
+  uint64_t m_cursor; //Serial of the current page
+};
+
+#endif
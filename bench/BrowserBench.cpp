@@ -0,0 +1,1131 @@
+/*Title: BrowserBench.cpp
+  Author: Shariq Moghees
+  Date: 10/17/2026
+  Description: Replays synthetic workloads against Browser and the history
+               stacks without going through the menu, and prints one JSON
+               line per result so runs can be compared across commits.
+
+  Build (from the repository root):
+    cmake -S . -B build && cmake --build build --target browser_bench
+  with -DUSE_COLUMN_STACK=ON, -DUSE_TIMELINE_HISTORY=ON or -DUSE_METRICS=OFF
+  to pick the history model and -DUSE_POOL=OFF to allocate without the slab
+  pools, or by hand:
+    g++ -std=c++17 -O2 -pthread -I. -o browser_bench bench/BrowserBench.cpp \
+        bench/HistoryGenerator.cpp Browser.cpp ColumnStack.cpp CommandRunner.cpp \
+        HistoryLoader.cpp HistorySnapshot.cpp HistoryWriter.cpp Journal.cpp Metrics.cpp \
+        NavigationEntry.cpp ScanKernels.cpp SessionManager.cpp SharedHistory.cpp TimeFormatter.cpp \
+        TimeIndex.cpp Timeline.cpp UrlSearch.cpp UrlTable.cpp VisitIndex.cpp
+  By hand, the switches in Browser.h, Metrics.h and Pool.cpp
+  (-DUSE_COLUMN_STACK=1, -DUSE_POOL=0 and so on) apply as usual. Each line
+  names the model it was built with and whether the pools were on.
+
+  Usage:
+    browser_bench [--bench name,...] [--entries N] [--urls N] [--skew S]
+                  [--spacing MS] [--ops N] [--threads N] [--seed N]
+                  [--dir PATH] [--label TEXT]
+  Benchmarks: visit navigate stack scan load snapshot startup query display
+              format concurrent memory script fork (all by default). Peak RSS is for
+              the whole process, so run one benchmark per process when
+              comparing it.
+*/
+#include "HistoryGenerator.h"
+#include "../Browser.h"
+#include "../CommandRunner.h"
+#include "../ConcurrentStack.cpp"
+#include "../ScanKernels.h"
+#include "../SessionManager.h"
+#include <algorithm>
+#include <atomic>
+#include <climits>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <ctime>
+#include <mutex>
+#include <new>
+#include <thread>
+#include <sys/resource.h>
+#include <unistd.h>
+
+//Constants
+const size_t ALLOC_HEADER = 16; //Bytes before each block holding its size (keeps alignment)
+const size_t DEFAULT_ENTRIES = 1000000; //History size for --entries
+const size_t DEFAULT_URLS = 100000; //Distinct URLs for --urls
+const size_t DEFAULT_OPS = 1000000; //Timed operations for --ops
+const size_t STACK_LIMIT = 1000; //Entries kept by the eviction benchmark
+const size_t SYNC_OPS = 2000; //Visits timed with a sync per record
+const size_t QUERY_OPS = 100000; //Most lookups timed per query benchmark
+const size_t LINEAR_OPS = 100; //Lookups timed by full stack scans
+const size_t SCAN_ELEMENTS = 256 * 1024 * 1024; //Values each kernel benchmark scans in total
+const size_t FORK_COUNT = 1000; //Forks kept alive by the fork memory benchmark
+const size_t DEEP_COPIES = 10; //Full Stack copies timed by the fork benchmark
+
+//**********Allocation counting**********
+//Every operator new in the process goes through these, so a result's
+//allocations and bytes are exact. Live bytes need the size on delete, so
+//each block carries a small header.
+
+static atomic<uint64_t> g_allocs(0); //Allocations so far
+static atomic<uint64_t> g_allocBytes(0); //Bytes requested so far
+static atomic<int64_t> g_liveBytes(0); //Bytes allocated and not yet freed
+
+void* operator new(size_t size){
+    g_allocs.fetch_add(1, memory_order_relaxed);
+    g_allocBytes.fetch_add(size, memory_order_relaxed);
+    g_liveBytes.fetch_add(static_cast<int64_t>(size), memory_order_relaxed);
+    char* block = static_cast<char*>(malloc(size + ALLOC_HEADER));
+    if (block == nullptr){
+        throw bad_alloc();
+    }
+    memcpy(block, &size, sizeof(size));
+    return block + ALLOC_HEADER;
+}
+
+void operator delete(void* data) noexcept{
+    if (data == nullptr){
+        return;
+    }
+    char* block = static_cast<char*>(data) - ALLOC_HEADER;
+    size_t size;
+    memcpy(&size, block, sizeof(size));
+    g_liveBytes.fetch_sub(static_cast<int64_t>(size), memory_order_relaxed);
+    free(block);
+}
+
+void operator delete(void* data, size_t) noexcept{operator delete(data);}
+
+void* operator new(size_t size, const nothrow_t&) noexcept{ //used by stable_sort's buffer
+    try{
+        return operator new(size);
+    } catch (const bad_alloc&){
+        return nullptr;
+    }
+}
+
+void operator delete(void* data, const nothrow_t&) noexcept{operator delete(data);}
+
+void* operator new(size_t size, align_val_t align){ //over-aligned types skip the header
+    g_allocs.fetch_add(1, memory_order_relaxed);
+    g_allocBytes.fetch_add(size, memory_order_relaxed);
+    size_t alignment = static_cast<size_t>(align);
+    void* block = aligned_alloc(alignment, (size + alignment - 1) / alignment * alignment);
+    if (block == nullptr){
+        throw bad_alloc();
+    }
+    return block;
+}
+
+void operator delete(void* data, align_val_t) noexcept{free(data);}
+
+void operator delete(void* data, size_t, align_val_t) noexcept{free(data);}
+
+void* operator new(size_t size, align_val_t align, const nothrow_t&) noexcept{
+    try{
+        return operator new(size, align);
+    } catch (const bad_alloc&){
+        return nullptr;
+    }
+}
+
+void operator delete(void* data, align_val_t, const nothrow_t&) noexcept{free(data);}
+
+//**********Results**********
+
+//Settings from the command line
+struct BenchOptions {
+  vector<string> m_benches; //Benchmarks to run (empty for all)
+  size_t m_entries; //History size
+  size_t m_ops; //Timed operations per benchmark
+  unsigned m_threads; //Most threads used
+  GeneratorOptions m_history; //Shape of the synthetic history
+  string m_dir; //Where temporary files go
+  string m_label; //Copied into every line, e.g. a commit id
+};
+
+//One line of output
+struct BenchResult {
+  string m_name; //Benchmark name
+  size_t m_ops; //Operations timed
+  double m_seconds; //Wall time of all of them
+  vector<uint32_t> m_latencies; //Nanoseconds per operation (empty if not timed one by one)
+  uint64_t m_allocs; //Allocations during the run
+  uint64_t m_allocBytes; //Bytes allocated during the run
+  vector<pair<string, double>> m_extra; //Benchmark-specific numbers
+};
+
+// Name: GetModel
+// Description: Returns the history model Browser was built with
+// Preconditions: None
+// Postconditions: None
+static const char* GetModel(){
+#if USE_TIMELINE_HISTORY
+    return "timeline";
+#elif USE_COLUMN_STACK
+    return "column";
+#elif USE_RING_STACK
+    return "ring";
+#else
+    return "list";
+#endif
+}
+
+// Name: GetPeakRss
+// Description: Returns the most resident memory the process has used (KiB)
+// Preconditions: None
+// Postconditions: None
+static long GetPeakRss(){
+    struct rusage usage;
+    if (getrusage(RUSAGE_SELF, &usage) != 0){
+        return -1;
+    }
+#if defined(__APPLE__)
+    return usage.ru_maxrss / 1024; //bytes here, KiB on Linux
+#else
+    return usage.ru_maxrss;
+#endif
+}
+
+// Name: Escape
+// Description: Returns text quoted as a JSON string
+// Preconditions: None
+// Postconditions: None
+static string Escape(const string& text){
+    string out = "\"";
+    for (char c : text){
+        if (c == '"' || c == '\\'){
+            out.push_back('\\');
+        }
+        out.push_back((static_cast<unsigned char>(c) < ' ') ? ' ' : c);
+    }
+    return out + "\"";
+}
+
+// Name: Percentile
+// Description: Returns the latency below which share of the samples fall
+// Preconditions: sorted is sorted and not empty
+// Postconditions: None
+static uint32_t Percentile(const vector<uint32_t>& sorted, double share){
+    size_t index = static_cast<size_t>(share * static_cast<double>(sorted.size()));
+    return sorted[min(index, sorted.size() - 1)];
+}
+
+// Name: Print
+// Description: Writes result as one JSON line to stdout
+// Preconditions: None
+// Postconditions: None
+static void Print(const BenchOptions& options, BenchResult& result){
+    double rate = (result.m_seconds > 0) ? result.m_ops / result.m_seconds : 0;
+    printf("{\"label\":%s,\"bench\":%s,\"model\":\"%s\",\"pool\":%s,\"ops\":%zu,"
+           "\"seconds\":%.6f,\"ops_per_sec\":%.1f", Escape(options.m_label).c_str(),
+           Escape(result.m_name).c_str(), GetModel(), USE_POOL ? "true" : "false", result.m_ops,
+           result.m_seconds, rate);
+    if (result.m_latencies.empty()){
+        printf(",\"p50_ns\":null,\"p99_ns\":null");
+    } else{
+        sort(result.m_latencies.begin(), result.m_latencies.end());
+        printf(",\"p50_ns\":%u,\"p99_ns\":%u", Percentile(result.m_latencies, 0.50),
+               Percentile(result.m_latencies, 0.99));
+    }
+    printf(",\"allocs\":%llu,\"alloc_bytes\":%llu,\"peak_rss_kb\":%ld",
+           static_cast<unsigned long long>(result.m_allocs),
+           static_cast<unsigned long long>(result.m_allocBytes), GetPeakRss());
+    for (const pair<string, double>& extra : result.m_extra){
+        printf(",%s:%.6g", Escape(extra.first).c_str(), extra.second);
+    }
+    printf("}\n");
+    fflush(stdout);
+}
+
+// Name: Seconds
+// Description: Returns the seconds from start to now
+// Preconditions: None
+// Postconditions: None
+static double Seconds(chrono::steady_clock::time_point start){
+    return chrono::duration<double>(chrono::steady_clock::now() - start).count();
+}
+
+// Name: Timed
+// Description: Runs op(i) for i in [0, ops) and records each call's latency
+// Preconditions: None
+// Postconditions: Returns the result without extras
+template <typename F>
+static BenchResult Timed(const string& name, size_t ops, F op){
+    BenchResult result{name, ops, 0, vector<uint32_t>(ops), 0, 0, {}};
+    uint64_t allocs = g_allocs.load(memory_order_relaxed);
+    uint64_t bytes = g_allocBytes.load(memory_order_relaxed);
+    chrono::steady_clock::time_point start = chrono::steady_clock::now();
+    chrono::steady_clock::time_point last = start;
+    for (size_t i = 0; i < ops; i++){ //one clock read per operation
+        op(i);
+        chrono::steady_clock::time_point now = chrono::steady_clock::now();
+        long long nanoseconds = chrono::duration_cast<chrono::nanoseconds>(now - last).count();
+        result.m_latencies[i] = static_cast<uint32_t>(min<long long>(nanoseconds, UINT32_MAX));
+        last = now;
+    }
+    result.m_seconds = Seconds(start);
+    result.m_allocs = g_allocs.load(memory_order_relaxed) - allocs;
+    result.m_allocBytes = g_allocBytes.load(memory_order_relaxed) - bytes;
+    return result;
+}
+
+// Name: Once
+// Description: Runs body once and counts it as ops operations
+// Preconditions: None
+// Postconditions: Returns the result without latencies or extras
+template <typename F>
+static BenchResult Once(const string& name, size_t ops, F body){
+    BenchResult result{name, ops, 0, {}, 0, 0, {}};
+    uint64_t allocs = g_allocs.load(memory_order_relaxed);
+    uint64_t bytes = g_allocBytes.load(memory_order_relaxed);
+    chrono::steady_clock::time_point start = chrono::steady_clock::now();
+    body();
+    result.m_seconds = Seconds(start);
+    result.m_allocs = g_allocs.load(memory_order_relaxed) - allocs;
+    result.m_allocBytes = g_allocBytes.load(memory_order_relaxed) - bytes;
+    return result;
+}
+
+// Name: Fill
+// Description: Loads count generated visits into browser in one batch
+// Preconditions: None
+// Postconditions: None
+static void Fill(Browser& browser, HistoryGenerator& generator, size_t count){
+    vector<HistoryRecord> records;
+    generator.MakeRecords(count, records);
+    browser.VisitBatch(records.data(), records.size());
+}
+
+// Name: MakeEntries
+// Description: Sets entries to count generated entries for the stacks
+// Preconditions: None
+// Postconditions: The URLs view generator's text
+static void MakeEntries(HistoryGenerator& generator, UrlTable& urls, size_t count,
+                        vector<NavigationEntry>& entries){
+    entries.clear();
+    entries.reserve(count);
+    for (size_t i = 0; i < count; i++){
+        string_view url = generator.NextUrl();
+        entries.emplace_back(url, urls.Intern(url), generator.NextTimeStamp());
+    }
+}
+
+//**********Benchmarks**********
+
+// Name: BenchVisit
+// Description: Browser::Visit with Zipf URLs
+// Preconditions: None
+// Postconditions: None
+static void BenchVisit(const BenchOptions& options){
+    HistoryGenerator generator(options.m_history);
+    vector<HistoryRecord> records;
+    generator.MakeRecords(options.m_ops, records);
+    Browser browser("");
+    BenchResult result = Timed("visit", records.size(), [&](size_t i){
+        browser.Visit(records[i].m_url, records[i].m_timeStamp);
+    });
+    result.m_extra.push_back({"distinct_urls", static_cast<double>(browser.GetUrlTable().GetSize())});
+    Print(options, result);
+}
+
+// Name: BenchNavigate
+// Description: A scripted Visit, Back(k), Forward(k) mix on a full history,
+//              then single Back and Forward steps with their allocations
+// Preconditions: None
+// Postconditions: None
+static void BenchNavigate(const BenchOptions& options){
+    HistoryGenerator generator(options.m_history);
+    Browser browser("");
+    Fill(browser, generator, options.m_entries);
+    vector<WorkloadOp> ops;
+    generator.MakeWorkload(options.m_ops, {0.3, 0.2, 4}, ops);
+    BenchResult result = Timed("navigate", ops.size(), [&](size_t i){
+        const WorkloadOp& op = ops[i];
+        if (op.m_type == WORKLOAD_VISIT){
+            browser.Visit(op.m_url, op.m_timeStamp);
+        } else if (op.m_type == WORKLOAD_BACK){
+            browser.Back(op.m_steps);
+        } else{
+            browser.Forward(op.m_steps);
+        }
+    });
+    result.m_extra.push_back({"back_share", 0.3});
+    result.m_extra.push_back({"forward_share", 0.2});
+    result.m_extra.push_back({"allocs_per_op", static_cast<double>(result.m_allocs) / max<size_t>(ops.size(), 1)});
+    Print(options, result);
+
+    //one step at a time, back as far as --ops allows and then forward again,
+    //to see what a single navigation allocates
+    MetricsSnapshot depth;
+    browser.GetMetrics(depth);
+    size_t steps = min<size_t>(options.m_ops, depth.m_backDepth);
+    browser.Back(static_cast<int>(steps)); //warm up: the stacks reach their largest sizes
+    browser.Forward(static_cast<int>(steps));
+    for (bool back : {true, false}){
+        BenchResult single = Timed(back ? "navigate.back" : "navigate.forward", steps, [&](size_t){
+            if (back){
+                browser.Back(1);
+            } else{
+                browser.Forward(1);
+            }
+        });
+        single.m_extra.push_back({"allocs_per_op", static_cast<double>(single.m_allocs) / max<size_t>(steps, 1)});
+        Print(options, single);
+    }
+}
+
+// Name: BenchStack
+// Description: Push, Pop and bounded push with RemoveBottom on one stack type
+// Preconditions: None
+// Postconditions: None
+template <typename S>
+static void BenchStack(const BenchOptions& options, const string& name,
+                       vector<NavigationEntry>& entries){
+    S stack;
+    BenchResult push = Timed("stack." + name + ".push", entries.size(), [&](size_t i){
+        stack.Push(&entries[i]);
+    });
+    Print(options, push);
+    BenchResult pop = Timed("stack." + name + ".pop", entries.size(), [&](size_t){
+        stack.Pop();
+    });
+    Print(options, pop);
+    BenchResult evict = Timed("stack." + name + ".evict", entries.size(), [&](size_t i){
+        stack.Push(&entries[i]);
+        if (stack.GetSize() > STACK_LIMIT){ //what the history limit does
+            stack.RemoveBottom();
+        }
+    });
+    evict.m_extra.push_back({"limit", static_cast<double>(STACK_LIMIT)});
+    Print(options, evict);
+}
+
+// Name: RunStacks
+// Description: Compares the stack backends on the same entries
+// Preconditions: None
+// Postconditions: None
+static void RunStacks(const BenchOptions& options){
+    HistoryGenerator generator(options.m_history);
+    UrlTable urls;
+    vector<NavigationEntry> entries;
+    MakeEntries(generator, urls, options.m_ops, entries);
+    BenchStack<Stack<NavigationEntry*>>(options, "list", entries);
+    BenchStack<RingStack<NavigationEntry*>>(options, "ring", entries);
+    BenchStack<ColumnStack>(options, "column", entries);
+}
+
+// Name: BenchKernels
+// Description: Throughput of each scan kernel at every level the CPU has
+// Preconditions: None
+// Postconditions: Leaves the best level selected
+static void BenchKernels(const BenchOptions& options){
+    size_t count = max<size_t>(options.m_entries, 1024);
+    mt19937 random(static_cast<uint32_t>(options.m_history.m_seed));
+    vector<int32_t> deltas(count);
+    vector<uint32_t> ids(count);
+    for (size_t i = 0; i < count; i++){
+        deltas[i] = static_cast<int32_t>(random() % 2000000000) - 1000000000;
+        ids[i] = random() % options.m_history.m_urls;
+    }
+    vector<uint32_t> found(count);
+    size_t hours[HOURS_PER_DAY];
+    size_t reps = max<size_t>(SCAN_ELEMENTS / count, 1);
+    ScanLevel best = GetScanLevel();
+    for (ScanLevel level : {SCAN_SCALAR, SCAN_SSE4, SCAN_AVX2}){
+        if (!SetScanLevel(level)){
+            continue;
+        }
+        string suffix = string(".") + GetScanLevelName(level);
+        size_t sink = 0; //keeps the calls from being optimized away
+        BenchResult results[4] = {
+            Once("scan.count" + suffix, reps, [&](){
+                for (size_t r = 0; r < reps; r++){
+                    sink += CountInRange(deltas.data(), count, -100000000, 100000000);
+                }
+            }),
+            Once("scan.collect" + suffix, reps, [&](){
+                for (size_t r = 0; r < reps; r++){
+                    sink += CollectInRange(deltas.data(), count, -100000000, 100000000, found.data());
+                }
+            }),
+            Once("scan.ids" + suffix, reps, [&](){
+                for (size_t r = 0; r < reps; r++){
+                    sink += CollectEqual(ids.data(), count, static_cast<uint32_t>(r), found.data());
+                }
+            }),
+            Once("scan.hours" + suffix, reps, [&](){
+                for (size_t r = 0; r < reps; r++){
+                    AddHourCounts(deltas.data(), count, GENERATOR_START, hours);
+                }
+            })};
+        for (BenchResult& result : results){
+            double bytes = static_cast<double>(reps) * count * sizeof(int32_t);
+            result.m_extra.push_back({"elements", static_cast<double>(count)});
+            result.m_extra.push_back({"gb_per_sec", bytes / result.m_seconds / 1e9});
+            result.m_extra.push_back({"checksum", static_cast<double>(sink % 1000)});
+            Print(options, result);
+        }
+    }
+    SetScanLevel(best);
+}
+
+// Name: BenchScan
+// Description: Range counts and URL lookups through the stacks and through
+//              Browser's scan queries, then the raw kernels
+// Preconditions: None
+// Postconditions: None
+static void BenchScan(const BenchOptions& options){
+    HistoryGenerator generator(options.m_history);
+    UrlTable urls;
+    vector<NavigationEntry> entries;
+    MakeEntries(generator, urls, options.m_entries, entries);
+    Stack<NavigationEntry*> list;
+    ColumnStack column;
+    for (NavigationEntry& entry : entries){
+        list.Push(&entry);
+        column.Push(&entry);
+    }
+    int64_t from = entries.empty() ? 0 : entries[entries.size() / 4].GetTimeStamp();
+    int64_t to = entries.empty() ? 0 : entries[entries.size() * 3 / 4].GetTimeStamp();
+    size_t queries = max<size_t>(LINEAR_OPS, 1);
+    size_t sink = 0;
+    BenchResult listCount = Timed("scan.list.count_between", queries, [&](size_t){
+        list.ForEach([&](NavigationEntry* entry){ //one pointer chase per entry
+            sink += (entry->GetTimeStamp() >= from && entry->GetTimeStamp() <= to);
+        });
+    });
+    BenchResult columnCount = Timed("scan.column.count_between", queries, [&](size_t){
+        sink += column.CountBetween(from, to);
+    });
+    BenchResult listFind = Timed("scan.list.find_url", queries, [&](size_t i){
+        UrlId id = static_cast<UrlId>(i % urls.GetSize());
+        size_t depth = 0, found = SIZE_MAX;
+        list.ForEach([&](NavigationEntry* entry){ //no early exit in ForEach
+            if (found == SIZE_MAX && entry->GetURLId() == id){
+                found = depth;
+            }
+            depth++;
+        });
+        sink += found;
+    });
+    BenchResult columnFind = Timed("scan.column.find_url", queries, [&](size_t i){
+        size_t depth = 0;
+        sink += column.FindUrl(static_cast<UrlId>(i % urls.GetSize()), depth) ? depth : 0;
+    });
+    for (BenchResult* result : {&listCount, &columnCount, &listFind, &columnFind}){
+        result->m_extra.push_back({"entries", static_cast<double>(entries.size())});
+        result->m_extra.push_back({"entries_per_sec", entries.size() * result->m_ops / result->m_seconds});
+        Print(options, *result);
+    }
+
+    Browser browser("");
+    HistoryGenerator visits(options.m_history);
+    Fill(browser, visits, options.m_entries);
+    int64_t span = static_cast<int64_t>(options.m_entries) * options.m_history.m_spacing;
+    BenchResult count = Timed("scan.browser.count_between", queries, [&](size_t i){
+        int64_t start = GENERATOR_START + static_cast<int64_t>(i) * span / static_cast<int64_t>(queries);
+        sink += browser.CountVisitsBetween(start, start + span / 2);
+    });
+    vector<size_t> hours;
+    BenchResult byHour = Timed("scan.browser.count_by_hour", queries, [&](size_t){
+        browser.CountVisitsByHour(0, hours);
+        sink += hours[0];
+    });
+    for (BenchResult* result : {&count, &byHour}){
+        result->m_extra.push_back({"entries", static_cast<double>(options.m_entries)});
+        result->m_extra.push_back({"checksum", static_cast<double>(sink % 1000)});
+        Print(options, *result);
+    }
+    BenchKernels(options);
+}
+
+// Name: BenchLoad
+// Description: LoadFile on a generated CSV from 1 thread up to --threads
+// Preconditions: None
+// Postconditions: The CSV is removed
+static void BenchLoad(const BenchOptions& options){
+    string fileName = options.m_dir + "/bench_history.csv";
+    HistoryGenerator generator(options.m_history);
+    if (!generator.WriteFile(fileName, options.m_entries)){
+        fprintf(stderr, "Cannot write %s\n", fileName.c_str());
+        return;
+    }
+    MappedFile file;
+    file.Open(fileName);
+    double megabytes = file.GetSize() / 1e6;
+    file.Close();
+    for (unsigned threads = 1; threads <= options.m_threads; threads *= 2){
+        Browser browser(fileName);
+        browser.SetLoadThreads(threads);
+        BenchResult result = Once("load.t" + to_string(threads), options.m_entries, [&](){
+            browser.LoadFile();
+        });
+        result.m_extra.push_back({"threads", static_cast<double>(threads)});
+        result.m_extra.push_back({"mb_per_sec", megabytes / result.m_seconds});
+        Print(options, result);
+    }
+    remove(fileName.c_str());
+}
+
+// Name: BenchSnapshot
+// Description: SaveSnapshot and LoadSnapshot of a full history
+// Preconditions: None
+// Postconditions: The snapshot is removed
+static void BenchSnapshot(const BenchOptions& options){
+    string fileName = options.m_dir + "/bench_history.snapshot";
+    HistoryGenerator generator(options.m_history);
+    Browser source("");
+    Fill(source, generator, options.m_entries);
+    BenchResult save = Once("snapshot.save", options.m_entries, [&](){
+        source.SaveSnapshot(fileName);
+    });
+    MappedFile file;
+    file.Open(fileName);
+    double bytes = static_cast<double>(file.GetSize());
+    file.Close();
+    save.m_extra.push_back({"bytes", bytes});
+    Print(options, save);
+    Browser target("");
+    BenchResult load = Once("snapshot.load", options.m_entries, [&](){
+        target.LoadSnapshot(fileName);
+    });
+    load.m_extra.push_back({"bytes", bytes});
+    Print(options, load);
+    remove(fileName.c_str());
+}
+
+// Name: BenchStartup
+// Description: First start (CSV import and checkpoint), journal appends at
+//              group and single-record commit, then restart from the
+//              snapshot and journal tail against a plain CSV load
+// Preconditions: None
+// Postconditions: The files are removed
+static void BenchStartup(const BenchOptions& options){
+    string csvName = options.m_dir + "/bench_startup.csv";
+    string snapshotName = csvName + SNAPSHOT_SUFFIX;
+    string journalName = csvName + JOURNAL_SUFFIX;
+    remove(snapshotName.c_str());
+    remove(journalName.c_str());
+    HistoryGenerator generator(options.m_history);
+    if (!generator.WriteFile(csvName, options.m_entries)){
+        fprintf(stderr, "Cannot write %s\n", csvName.c_str());
+        return;
+    }
+    size_t tail = min(options.m_ops, QUERY_OPS);
+    {
+        Browser browser(csvName);
+        browser.SetCheckpointInterval(UNLIMITED); //keep the whole tail in the journal
+        BenchResult import = Once("startup.import", options.m_entries, [&](){
+            browser.OpenJournal(snapshotName, journalName);
+        });
+        Print(options, import);
+        vector<HistoryRecord> records;
+        generator.MakeRecords(tail, records);
+        BenchResult group = Timed("journal.visit", records.size(), [&](size_t i){
+            browser.Visit(records[i].m_url, records[i].m_timeStamp);
+        });
+        group.m_extra.push_back({"group_records", static_cast<double>(JOURNAL_GROUP_RECORDS)});
+        Print(options, group);
+        browser.SetJournalGroup(1, 0);
+        size_t synced = min(tail, SYNC_OPS);
+        BenchResult single = Timed("journal.visit_sync_each", synced, [&](size_t i){
+            browser.Visit(records[i].m_url, records[i].m_timeStamp);
+        });
+        single.m_extra.push_back({"group_records", 1});
+        Print(options, single);
+        tail += synced;
+    }
+    Browser restarted(csvName);
+    BenchResult journal = Once("startup.journal", options.m_entries + tail, [&](){
+        restarted.OpenJournal(snapshotName, journalName);
+    });
+    journal.m_extra.push_back({"journal_records", static_cast<double>(tail)});
+    Print(options, journal);
+    Browser csv(csvName);
+    BenchResult plain = Once("startup.csv", options.m_entries, [&](){
+        csv.LoadFile();
+    });
+    Print(options, plain);
+    remove(csvName.c_str());
+    remove(snapshotName.c_str());
+    remove(journalName.c_str());
+}
+
+// Name: BenchQuery
+// Description: FindVisit, time range queries and autocomplete on a full
+//              history, and FindVisit's job done by a full stack scan
+// Preconditions: None
+// Postconditions: None
+static void BenchQuery(const BenchOptions& options){
+    HistoryGenerator generator(options.m_history);
+    Browser browser("");
+    Fill(browser, generator, options.m_entries);
+    size_t ops = min(options.m_ops, QUERY_OPS);
+    vector<string_view> urls(ops);
+    for (size_t i = 0; i < ops; i++){
+        urls[i] = generator.NextUrl();
+    }
+    size_t sink = 0;
+    VisitInfo info;
+    BenchResult find = Timed("query.find_visit", ops, [&](size_t i){
+        sink += browser.FindVisit(urls[i], info) ? info.m_count : 0;
+    });
+    int64_t span = static_cast<int64_t>(options.m_entries) * options.m_history.m_spacing;
+    int64_t hour = 60 * 60 * 1000;
+    BenchResult between = Timed("query.between_hour", ops, [&](size_t i){
+        int64_t start = GENERATOR_START + static_cast<int64_t>(i % 1000) * max<int64_t>(span / 1000, 1);
+        TimeQuery query = browser.QueryBetween(start, start + hour);
+        string_view url;
+        int64_t timestamp;
+        while (query.Next(url, timestamp)){
+            sink++;
+        }
+    });
+    BenchResult before = Timed("query.before_20", ops, [&](size_t i){
+        TimeQuery query = browser.QueryBefore(GENERATOR_START + static_cast<int64_t>(i % 1000) * max<int64_t>(span / 1000, 1), 20);
+        string_view url;
+        int64_t timestamp;
+        while (query.Next(url, timestamp)){
+            sink++;
+        }
+    });
+    vector<SearchResult> results;
+    BenchResult search = Timed("query.search", ops, [&](size_t i){
+        string_view url = urls[i];
+        browser.Search(url.substr(7, 4), 10, results); //"sNNN" after http://
+        sink += results.size();
+    });
+    //one and two letter prefixes match most keys: the worst case for ranking
+    const char* shortPrefixes[] = {"h", "s", "e", "ht", "s1", "ex"};
+    BenchResult searchShort = Timed("query.search_short", ops, [&](size_t i){
+        browser.Search(shortPrefixes[i % 6], 10, results);
+        sink += results.size();
+    });
+    for (BenchResult* result : {&find, &between, &before, &search, &searchShort}){
+        result->m_extra.push_back({"entries", static_cast<double>(options.m_entries)});
+        result->m_extra.push_back({"checksum", static_cast<double>(sink % 1000)});
+        Print(options, *result);
+    }
+
+    UrlTable table;
+    vector<NavigationEntry> entries;
+    HistoryGenerator stackGenerator(options.m_history);
+    MakeEntries(stackGenerator, table, options.m_entries, entries);
+    Stack<NavigationEntry*> stack;
+    for (NavigationEntry& entry : entries){
+        stack.Push(&entry);
+    }
+    BenchResult linear = Timed("query.linear_find", min(ops, LINEAR_OPS), [&](size_t i){
+        size_t count = 0;
+        stack.ForEach([&](NavigationEntry* entry){
+            count += (entry->GetURLView() == urls[i]);
+        });
+        sink += count;
+    });
+    linear.m_extra.push_back({"entries", static_cast<double>(options.m_entries)});
+    linear.m_extra.push_back({"checksum", static_cast<double>(sink % 1000)});
+    Print(options, linear);
+}
+
+// Name: LegacyDisplay
+// Description: Writes records newest first the way Display did before
+//              HistoryWriter and TimeFormatter: localtime and strftime into
+//              a new string per entry, and an endl, so a flush, per line
+// Preconditions: None
+// Postconditions: Returns the number of lines written
+static size_t LegacyDisplay(ostream& out, const vector<HistoryRecord>& records){
+    out << "**Back Stack**" << endl;
+    for (size_t i = 1; i <= records.size(); i++){
+        const HistoryRecord& record = records[records.size() - i];
+        time_t seconds = static_cast<time_t>(record.m_timeStamp / MS_PER_SECOND);
+        char buffer[80];
+        strftime(buffer, sizeof(buffer), "%Y-%m-%d %H:%M:%S", localtime(&seconds));
+        out << i << ". " << "URL:" << record.m_url << " Visited On: " << string(buffer) << endl;
+    }
+    return records.size() + 1;
+}
+
+// Name: BenchDisplay
+// Description: Display of a full history into memory and into a file, and
+//              the same history through LegacyDisplay into the file
+// Preconditions: None
+// Postconditions: The file is removed
+static void BenchDisplay(const BenchOptions& options){
+    HistoryGenerator generator(options.m_history);
+    vector<HistoryRecord> records;
+    generator.MakeRecords(options.m_entries, records);
+    Browser browser("");
+    browser.VisitBatch(records.data(), records.size());
+    string text;
+    text.reserve(options.m_entries * 80);
+    StringSink sink(text);
+    BenchResult memory = Once("display", options.m_entries, [&](){
+        browser.Display(sink);
+    });
+    size_t lines = count(text.begin(), text.end(), '\n');
+    string fileName = options.m_dir + "/bench_display.txt";
+    ofstream file(fileName, ios::trunc);
+    BenchResult buffered = Once("display.file", options.m_entries, [&](){
+        StreamSink fileSink(file);
+        browser.Display(fileSink);
+        file.flush();
+    });
+    file.close();
+    file.open(fileName, ios::trunc);
+    size_t legacyLines = 0;
+    BenchResult legacy = Once("display.legacy", options.m_entries, [&](){
+        legacyLines = LegacyDisplay(file, records);
+    });
+    file.close();
+    remove(fileName.c_str());
+    memory.m_extra.push_back({"bytes", static_cast<double>(text.size())});
+    memory.m_extra.push_back({"mb_per_sec", text.size() / memory.m_seconds / 1e6});
+    memory.m_extra.push_back({"lines_per_sec", lines / memory.m_seconds});
+    buffered.m_extra.push_back({"lines_per_sec", lines / buffered.m_seconds});
+    legacy.m_extra.push_back({"lines_per_sec", legacyLines / legacy.m_seconds});
+    for (BenchResult* result : {&memory, &buffered, &legacy}){
+        Print(options, *result);
+    }
+}
+
+// Name: BenchFormat
+// Description: Timestamp text through the cached formatter, the string
+//              DisplayTimeStamp and plain localtime_r and strftime
+// Preconditions: None
+// Postconditions: None
+static void BenchFormat(const BenchOptions& options){
+    HistoryGenerator generator(options.m_history);
+    vector<int64_t> times(options.m_ops);
+    for (int64_t& time : times){
+        time = generator.NextTimeStamp();
+    }
+    NavigationEntry entry;
+    char buffer[TIME_TEXT_LENGTH + 1];
+    size_t sink = 0;
+    BenchResult cached = Timed("format.cached", times.size(), [&](size_t i){
+        sink += entry.DisplayTimeStamp(times[i], buffer);
+    });
+    BenchResult text = Timed("format.string", times.size(), [&](size_t i){
+        sink += entry.DisplayTimeStamp(times[i]).size();
+    });
+    BenchResult plain = Timed("format.strftime", times.size(), [&](size_t i){
+        time_t seconds = static_cast<time_t>(times[i] / MS_PER_SECOND);
+        struct tm local;
+        localtime_r(&seconds, &local);
+        sink += strftime(buffer, sizeof(buffer), "%Y-%m-%d %H:%M:%S", &local);
+    });
+    for (BenchResult* result : {&cached, &text, &plain}){
+        result->m_extra.push_back({"checksum", static_cast<double>(sink % 1000)});
+        Print(options, *result);
+    }
+}
+
+// Name: RunThreads
+// Description: Runs work(t) on threads threads and returns the wall time
+// Preconditions: threads is greater than 0
+// Postconditions: Every thread has finished
+template <typename F>
+static BenchResult RunThreads(const string& name, size_t ops, unsigned threads, F work){
+    return Once(name, ops, [&](){
+        vector<thread> workers;
+        for (unsigned t = 0; t < threads; t++){
+            workers.emplace_back(work, t);
+        }
+        for (thread& worker : workers){
+            worker.join();
+        }
+    });
+}
+
+// Name: BenchConcurrent
+// Description: Lock-free against mutex-guarded stacks, and SessionManager
+//              with one session per thread, from 1 thread up to --threads
+// Preconditions: None
+// Postconditions: None
+static void BenchConcurrent(const BenchOptions& options){
+    HistoryGenerator generator(options.m_history);
+    vector<HistoryRecord> records;
+    generator.MakeRecords(min(options.m_ops, QUERY_OPS), records);
+    for (unsigned threads = 1; threads <= options.m_threads; threads *= 2){
+        size_t each = options.m_ops / threads; //push and pop pairs per thread
+        ConcurrentStack<uint64_t> lockFree;
+        BenchResult treiber = RunThreads("concurrent.treiber.t" + to_string(threads), each * threads * 2,
+                                         threads, [&](unsigned t){
+            uint64_t value;
+            for (size_t i = 0; i < each; i++){
+                lockFree.Push(t * each + i);
+                lockFree.TryPop(value);
+            }
+        });
+        mutex lock;
+        Stack<uint64_t> locked;
+        BenchResult guarded = RunThreads("concurrent.mutex.t" + to_string(threads), each * threads * 2,
+                                         threads, [&](unsigned t){
+            for (size_t i = 0; i < each; i++){
+                {
+                    lock_guard<mutex> hold(lock);
+                    locked.Push(t * each + i);
+                }
+                lock_guard<mutex> hold(lock);
+                locked.Pop();
+            }
+        });
+        SessionManager sessions;
+        vector<SessionId> ids(threads);
+        for (SessionId& id : ids){
+            id = sessions.OpenSession();
+        }
+        BenchResult shared = RunThreads("sessions.t" + to_string(threads), each * threads, threads,
+                                        [&](unsigned t){
+            NavigationEntry page;
+            for (size_t i = 0; i < each; i++){ //mostly visits, some back and forward
+                const HistoryRecord& record = records[(t * each + i) % records.size()];
+                if (i % 10 == 7){
+                    sessions.Back(ids[t], 1, page);
+                } else if (i % 10 == 9){
+                    sessions.Forward(ids[t], 1, page);
+                } else{
+                    sessions.Visit(ids[t], record.m_url, record.m_timeStamp);
+                }
+            }
+        });
+        for (BenchResult* result : {&treiber, &guarded, &shared}){
+            result->m_extra.push_back({"threads", static_cast<double>(threads)});
+            Print(options, *result);
+        }
+    }
+}
+
+// Name: BenchMemory
+// Description: Live heap bytes per entry of a full history built by Visit
+// Preconditions: None
+// Postconditions: None
+static void BenchMemory(const BenchOptions& options){
+    HistoryGenerator generator(options.m_history);
+    vector<HistoryRecord> records;
+    generator.MakeRecords(options.m_entries, records);
+    int64_t before = g_liveBytes.load(memory_order_relaxed);
+    Browser* browser = new Browser("");
+    BenchResult result = Once("memory", records.size(), [&](){
+        for (const HistoryRecord& record : records){
+            browser->Visit(record.m_url, record.m_timeStamp);
+        }
+    });
+    double live = static_cast<double>(g_liveBytes.load(memory_order_relaxed) - before);
+    result.m_extra.push_back({"live_bytes", live});
+    result.m_extra.push_back({"bytes_per_entry", live / max<size_t>(records.size(), 1)});
+    result.m_extra.push_back({"distinct_urls", static_cast<double>(browser->GetUrlTable().GetSize())});
+    result.m_extra.push_back({"skew", options.m_history.m_skew});
+    Print(options, result);
+    delete browser;
+}
+
+// Name: BenchScript
+// Description: The navigate mix written as a command script and run by
+//              CommandRunner, on one thread and pipelined
+// Preconditions: None
+// Postconditions: The script is removed
+static void BenchScript(const BenchOptions& options){
+    string fileName = options.m_dir + "/bench_script.txt";
+    HistoryGenerator generator(options.m_history);
+    vector<WorkloadOp> ops;
+    generator.MakeWorkload(options.m_ops, {0.3, 0.2, 4}, ops);
+    FILE* file = fopen(fileName.c_str(), "wb");
+    if (file == nullptr){
+        fprintf(stderr, "Cannot write %s\n", fileName.c_str());
+        return;
+    }
+    for (const WorkloadOp& op : ops){
+        if (op.m_type == WORKLOAD_VISIT){
+            fprintf(file, "visit %.*s %lld.%03d\n", static_cast<int>(op.m_url.size()), op.m_url.data(),
+                    static_cast<long long>(op.m_timeStamp / 1000), static_cast<int>(op.m_timeStamp % 1000));
+        } else{
+            fprintf(file, "%s %d\n", (op.m_type == WORKLOAD_BACK) ? "back" : "forward", op.m_steps);
+        }
+    }
+    fprintf(file, "current\n");
+    long bytes = ftell(file);
+    fclose(file);
+    for (bool pipelined : {false, true}){
+        Browser browser("");
+        string text;
+        StringSink sink(text);
+        CommandRunner runner(browser, sink);
+        FILE* in = fopen(fileName.c_str(), "rb");
+        BenchResult result = Once(pipelined ? "script.pipelined" : "script.sequential", ops.size() + 1, [&](){
+            runner.Run(in, pipelined);
+        });
+        fclose(in);
+        result.m_extra.push_back({"mb_per_sec", bytes / result.m_seconds / 1e6});
+        result.m_extra.push_back({"commands", static_cast<double>(runner.GetCommandCount())});
+        Print(options, result);
+    }
+    remove(fileName.c_str());
+}
+
+// Name: BenchFork
+// Description: Forking a SharedHistory of the full history size against a
+//              deep Stack copy, single steps from the middle of a fork, and
+//              the memory forks cost once they diverge
+// Preconditions: None
+// Postconditions: None
+static void BenchFork(const BenchOptions& options){
+    HistoryGenerator generator(options.m_history);
+    vector<HistoryRecord> records;
+    generator.MakeRecords(options.m_entries, records);
+    Browser browser("");
+    browser.VisitBatch(records.data(), records.size());
+    int64_t before = g_liveBytes.load(memory_order_relaxed);
+    SharedHistory base;
+    BenchResult build = Once("fork.export", records.size(), [&](){
+        browser.GetSharedHistory(base);
+    });
+    double baseBytes = static_cast<double>(g_liveBytes.load(memory_order_relaxed) - before);
+    build.m_extra.push_back({"entries", static_cast<double>(records.size())});
+    build.m_extra.push_back({"live_bytes", baseBytes});
+    Print(options, build);
+
+    size_t sink = 0;
+    BenchResult copy = Timed("fork.copy", options.m_ops, [&](size_t){
+        SharedHistory fork = base;
+        sink += fork.GetBackSize();
+    });
+    copy.m_extra.push_back({"entries", static_cast<double>(records.size())});
+    copy.m_extra.push_back({"checksum", static_cast<double>(sink % 1000)});
+    Print(options, copy);
+
+    SharedHistory walker = base; //a step each way from deep in the history
+    walker.Back(static_cast<int>(min<size_t>(records.size() / 2, INT_MAX)));
+    BenchResult step = Timed("fork.step", options.m_ops, [&](size_t i){
+        sink += (i % 2 == 0) ? walker.Forward(1) : walker.Back(1);
+    });
+    step.m_extra.push_back({"entries", static_cast<double>(records.size())});
+    step.m_extra.push_back({"forward_pages", static_cast<double>(walker.GetForwardSize())});
+    step.m_extra.push_back({"checksum", static_cast<double>(sink % 1000)});
+    Print(options, step);
+
+    vector<SharedHistory> forks(FORK_COUNT);
+    before = g_liveBytes.load(memory_order_relaxed);
+    BenchResult diverge = Once("fork.diverge", FORK_COUNT, [&](){
+        for (size_t i = 0; i < FORK_COUNT; i++){ //each fork goes back and visits its own page
+            forks[i] = base;
+            forks[i].Back(static_cast<int>(i % 8));
+            forks[i].Visit(generator.NextUrl(), generator.NextTimeStamp());
+        }
+    });
+    double forkBytes = static_cast<double>(g_liveBytes.load(memory_order_relaxed) - before);
+    diverge.m_extra.push_back({"entries", static_cast<double>(records.size())});
+    diverge.m_extra.push_back({"live_bytes", forkBytes});
+    diverge.m_extra.push_back({"bytes_per_fork", forkBytes / FORK_COUNT});
+    diverge.m_extra.push_back({"base_bytes", baseBytes});
+    Print(options, diverge);
+    forks.clear();
+
+    Stack<NavigationEntry> stack; //what copying a history cost before
+    for (const HistoryRecord& record : records){
+        stack.Push(NavigationEntry(record.m_url, 0, record.m_timeStamp));
+    }
+    BenchResult deep = Timed("fork.deep_copy", DEEP_COPIES, [&](size_t){
+        before = g_liveBytes.load(memory_order_relaxed);
+        Stack<NavigationEntry> copied(stack);
+        sink += copied.GetSize();
+        baseBytes = static_cast<double>(g_liveBytes.load(memory_order_relaxed) - before);
+    });
+    deep.m_extra.push_back({"entries", static_cast<double>(records.size())});
+    deep.m_extra.push_back({"live_bytes", baseBytes});
+    Print(options, deep);
+}
+
+//**********Driver**********
+
+// Name: Usage
+// Description: Prints the command line options to stderr
+// Preconditions: None
+// Postconditions: None
+static void Usage(){
+    fprintf(stderr,
+            "usage: browser_bench [--bench name,...] [--entries N] [--urls N] [--skew S]\n"
+            "                     [--spacing MS] [--ops N] [--threads N] [--seed N]\n"
+            "                     [--dir PATH] [--label TEXT]\n"
+            "benchmarks: visit navigate stack scan load snapshot startup query display\n"
+            "            format concurrent memory script fork\n");
+}
+
+// Name: ParseOptions
+// Description: Reads the command line into options
+// Preconditions: None
+// Postconditions: Returns false on an unknown or incomplete option
+static bool ParseOptions(int argc, char* argv[], BenchOptions& options){
+    unsigned hardware = thread::hardware_concurrency();
+    options.m_entries = DEFAULT_ENTRIES;
+    options.m_ops = DEFAULT_OPS;
+    options.m_threads = (hardware == 0) ? 1 : hardware;
+    options.m_history = {DEFAULT_URLS, 1.0, 1000, 1};
+    options.m_dir = "/tmp";
+    for (int i = 1; i < argc; i++){
+        string name = argv[i];
+        if (i + 1 >= argc){
+            return false;
+        }
+        string value = argv[++i];
+        if (name == "--bench"){
+            for (size_t start = 0; start <= value.size();){ //comma separated
+                size_t comma = min(value.find(',', start), value.size());
+                options.m_benches.push_back(value.substr(start, comma - start));
+                start = comma + 1;
+            }
+        } else if (name == "--entries"){
+            options.m_entries = strtoull(value.c_str(), nullptr, 10);
+        } else if (name == "--urls"){
+            options.m_history.m_urls = max<size_t>(strtoull(value.c_str(), nullptr, 10), 1);
+        } else if (name == "--skew"){
+            options.m_history.m_skew = strtod(value.c_str(), nullptr);
+        } else if (name == "--spacing"){
+            options.m_history.m_spacing = strtoll(value.c_str(), nullptr, 10);
+        } else if (name == "--ops"){
+            options.m_ops = strtoull(value.c_str(), nullptr, 10);
+        } else if (name == "--threads"){
+            options.m_threads = max(static_cast<unsigned>(strtoul(value.c_str(), nullptr, 10)), 1u);
+        } else if (name == "--seed"){
+            options.m_history.m_seed = strtoull(value.c_str(), nullptr, 10);
+        } else if (name == "--dir"){
+            options.m_dir = value;
+        } else if (name == "--label"){
+            options.m_label = value;
+        } else{
+            return false;
+        }
+    }
+    return true;
+}
+
+int main(int argc, char* argv[]){
+    BenchOptions options;
+    if (!ParseOptions(argc, argv, options)){
+        Usage();
+        return 1;
+    }
+    const pair<const char*, void (*)(const BenchOptions&)> benches[] = {
+        {"visit", BenchVisit}, {"navigate", BenchNavigate}, {"stack", RunStacks},
+        {"scan", BenchScan}, {"load", BenchLoad}, {"snapshot", BenchSnapshot},
+        {"startup", BenchStartup}, {"query", BenchQuery}, {"display", BenchDisplay},
+        {"format", BenchFormat}, {"concurrent", BenchConcurrent}, {"memory", BenchMemory},
+        {"script", BenchScript}, {"fork", BenchFork}};
+    for (const string& name : options.m_benches){ //reject typos before running anything
+        bool known = false;
+        for (const auto& bench : benches){
+            known = known || (name == bench.first);
+        }
+        if (!known){
+            fprintf(stderr, "Unknown benchmark %s\n", name.c_str());
+            Usage();
+            return 1;
+        }
+    }
+    for (const auto& bench : benches){
+        if (options.m_benches.empty() ||
+            find(options.m_benches.begin(), options.m_benches.end(), bench.first) != options.m_benches.end()){
+            bench.second(options);
+        }
+    }
+    return 0;
+}
@@ -0,0 +1,118 @@
+/*Title: HistoryGenerator.cpp
+  Author: Shariq Moghees
+  Date: 10/17/2026
+  Description: This class generates synthetic browser histories and
+               navigation workloads for the benchmarks
+*/
+#include "HistoryGenerator.h"
+#include <algorithm>
+#include <cmath>
+#include <cstdio>
+
+// Name: HistoryGenerator (Overloaded constructor)
+// Description: Builds the URL text and the Zipf table for options
+// Preconditions: options.m_urls is greater than 0
+// Postconditions: The first visit is at GENERATOR_START
+HistoryGenerator::HistoryGenerator(const GeneratorOptions& options)
+    :m_options(options),m_random(options.m_seed),m_cdf(options.m_urls),
+     m_urls(options.m_urls),m_time(GENERATOR_START){
+    double total = 0;
+    for (size_t i = 0; i < m_cdf.size(); i++){ //weight of rank i is 1 / (i + 1)^skew
+        total += pow(static_cast<double>(i + 1), -m_options.m_skew);
+        m_cdf[i] = total;
+    }
+    for (size_t i = 0; i < m_cdf.size(); i++){
+        m_cdf[i] /= total;
+    }
+    for (size_t i = 0; i < m_urls.size(); i++){ //neighbouring ranks share a host
+        m_urls[i] = "http://s" + to_string(i / GENERATOR_URLS_PER_HOST) + ".example.com/p" +
+                    to_string(i);
+    }
+}
+
+// Name: NextUrl
+// Description: Returns a URL drawn from the Zipf distribution
+// Preconditions: None
+// Postconditions: The view stays valid as long as the generator
+string_view HistoryGenerator::NextUrl(){
+    double draw = uniform_real_distribution<double>(0.0, 1.0)(m_random);
+    size_t rank = lower_bound(m_cdf.begin(), m_cdf.end(), draw) - m_cdf.begin();
+    return m_urls[min(rank, m_urls.size() - 1)]; //rounding can leave the last sum under 1
+}
+
+// Name: NextTimeStamp
+// Description: Returns the next visit time, m_spacing ms later on average
+// Preconditions: None
+// Postconditions: Timestamps never go down
+int64_t HistoryGenerator::NextTimeStamp(){
+    if (m_options.m_spacing > 0){
+        exponential_distribution<double> gap(1.0 / static_cast<double>(m_options.m_spacing));
+        m_time += static_cast<int64_t>(gap(m_random));
+    }
+    return m_time;
+}
+
+// Name: GetUrl
+// Description: Returns the URL of a rank
+// Preconditions: rank < m_urls
+// Postconditions: None
+string_view HistoryGenerator::GetUrl(size_t rank) const{return m_urls[rank];}
+
+// Name: WriteFile
+// Description: Writes count visits to fileName in the url,timestamp,
+//              format LoadFile reads
+// Preconditions: None
+// Postconditions: Returns false if the file could not be written
+bool HistoryGenerator::WriteFile(const string& fileName, size_t count){
+    FILE* file = fopen(fileName.c_str(), "wb");
+    if (file == nullptr){
+        return false;
+    }
+    for (size_t i = 0; i < count; i++){ //timestamps are seconds with a fraction
+        string_view url = NextUrl();
+        int64_t time = NextTimeStamp();
+        fprintf(file, "%.*s,%lld.%03d,\n", static_cast<int>(url.size()), url.data(),
+                static_cast<long long>(time / 1000), static_cast<int>(time % 1000));
+    }
+    return fclose(file) == 0;
+}
+
+// Name: MakeRecords
+// Description: Sets records to count visits
+// Preconditions: None
+// Postconditions: The URLs view the generator's text
+void HistoryGenerator::MakeRecords(size_t count, vector<HistoryRecord>& records){
+    records.resize(count);
+    for (size_t i = 0; i < count; i++){
+        records[i].m_url = NextUrl();
+        records[i].m_timeStamp = NextTimeStamp();
+    }
+}
+
+// Name: MakeWorkload
+// Description: Sets ops to count operations in the proportions of mix
+// Preconditions: mix.m_maxSteps is greater than 0
+// Postconditions: The URLs view the generator's text
+void HistoryGenerator::MakeWorkload(size_t count, const WorkloadMix& mix, vector<WorkloadOp>& ops){
+    uniform_real_distribution<double> kind(0.0, 1.0);
+    uniform_int_distribution<int> steps(1, mix.m_maxSteps);
+    ops.resize(count);
+    for (size_t i = 0; i < count; i++){
+        double draw = kind(m_random);
+        WorkloadOp& op = ops[i];
+        op.m_url = string_view();
+        op.m_timeStamp = 0;
+        op.m_steps = 0;
+        if (draw < mix.m_back){
+            op.m_type = WORKLOAD_BACK;
+            op.m_steps = steps(m_random);
+        } else if (draw < mix.m_back + mix.m_forward){
+            op.m_type = WORKLOAD_FORWARD;
+            op.m_steps = steps(m_random);
+        } else{
+            op.m_type = WORKLOAD_VISIT;
+            op.m_url = NextUrl();
+            op.m_timeStamp = NextTimeStamp();
+        }
+    }
+}
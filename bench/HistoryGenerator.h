@@ -0,0 +1,102 @@
+/*Title: HistoryGenerator.h
+  Author: Shariq Moghees
+  Date: 10/17/2026
+  Description: This class generates synthetic browser histories and
+               navigation workloads for the benchmarks
+*/
+#ifndef HISTORY_GENERATOR_H //Header guards
+#define HISTORY_GENERATOR_H //Header guards
+
+#include <cstddef>
+#include <cstdint>
+#include <random>
+#include <string>
+#include <string_view>
+#include <vector>
+#include "../HistoryLoader.h"
+using namespace std;
+
+//Constants
+const size_t GENERATOR_URLS_PER_HOST = 16; //URL ranks that share one host name
+const int64_t GENERATOR_START = 1500000000000LL; //Timestamp of the first visit (ms)
+
+//Shape of a synthetic history
+struct GeneratorOptions {
+  size_t m_urls; //Distinct URLs (cardinality)
+  double m_skew; //Zipf exponent: 0 is uniform, about 1 is web-like
+  int64_t m_spacing; //Mean gap between visits (ms)
+  uint64_t m_seed; //Seed for every random choice
+};
+
+//Kinds of scripted navigation
+enum WorkloadType {
+  WORKLOAD_VISIT, //Browser::Visit(m_url, m_timeStamp)
+  WORKLOAD_BACK, //Browser::Back(m_steps)
+  WORKLOAD_FORWARD //Browser::Forward(m_steps)
+};
+
+//One step of a scripted workload
+struct WorkloadOp {
+  WorkloadType m_type; //What to do
+  string_view m_url; //URL to visit (owned by the generator)
+  int64_t m_timeStamp; //Timestamp of the visit (ms)
+  int m_steps; //Steps to move back or forward
+};
+
+//Mix of operations in a scripted workload; the rest are visits
+struct WorkloadMix {
+  double m_back; //Share of Back(k) operations
+  double m_forward; //Share of Forward(k) operations
+  int m_maxSteps; //k is uniform in [1, m_maxSteps]
+};
+
+//Draws URLs from a Zipf distribution over m_urls ranks (rank 0 is the
+//most visited) and timestamps with exponentially distributed gaps. The
+//same options and seed always give the same history.
+class HistoryGenerator {
+ public:
+  // Name: HistoryGenerator (Overloaded constructor)
+  // Description: Builds the URL text and the Zipf table for options
+  // Preconditions: options.m_urls is greater than 0
+  // Postconditions: The first visit is at GENERATOR_START
+  HistoryGenerator(const GeneratorOptions& options);
+  // Name: NextUrl
+  // Description: Returns a URL drawn from the Zipf distribution
+  // Preconditions: None
+  // Postconditions: The view stays valid as long as the generator
+  string_view NextUrl();
+  // Name: NextTimeStamp
+  // Description: Returns the next visit time, m_spacing ms later on average
+  // Preconditions: None
+  // Postconditions: Timestamps never go down
+  int64_t NextTimeStamp();
+  // Name: GetUrl
+  // Description: Returns the URL of a rank
+  // Preconditions: rank < m_urls
+  // Postconditions: None
+  string_view GetUrl(size_t rank) const;
+  // Name: WriteFile
+  // Description: Writes count visits to fileName in the url,timestamp,
+  //              format LoadFile reads
+  // Preconditions: None
+  // Postconditions: Returns false if the file could not be written
+  bool WriteFile(const string& fileName, size_t count);
+  // Name: MakeRecords
+  // Description: Sets records to count visits
+  // Preconditions: None
+  // Postconditions: The URLs view the generator's text
+  void MakeRecords(size_t count, vector<HistoryRecord>& records);
+  // Name: MakeWorkload
+  // Description: Sets ops to count operations in the proportions of mix
+  // Preconditions: mix.m_maxSteps is greater than 0
+  // Postconditions: The URLs view the generator's text
+  void MakeWorkload(size_t count, const WorkloadMix& mix, vector<WorkloadOp>& ops);
+ private:
+  GeneratorOptions m_options; //Shape of the history
+  mt19937_64 m_random; //Source of every random choice
+  vector<double> m_cdf; //Chance of each rank or a lower one
+  vector<string> m_urls; //Text of each rank
+  int64_t m_time; //Timestamp of the last visit
+};
+
+#endif
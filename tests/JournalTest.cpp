@@ -0,0 +1,291 @@
+/*Title: JournalTest.cpp
+  Author: Shariq Moghees
+  Date: 10/17/2026
+  Description: Restarts a Browser over journals left by crashes at each
+               step of a checkpoint and checks no visit is lost, doubled
+               or truncated away. Writes its files to the working
+               directory; returns non-zero if any check fails.
+*/
+#include "../Browser.h"
+#include <cstdio>
+#include <fstream>
+#include <iterator>
+#if defined(__unix__) || defined(__APPLE__)
+#include <csignal>
+#include <sys/resource.h>
+#endif
+
+//Constants
+const char TEST_CSV[] = "journal_test.csv"; //History imported on a first start
+const char TEST_MISSING_DIR[] = "journal_test_missing/"; //Never created, so files in it cannot be written
+
+static int g_failures = 0; //Checks failed so far
+
+// Name: Check
+// Description: Prints what failed if ok is false
+// Preconditions: None
+// Postconditions: Counts the failure
+static void Check(bool ok, const string& what){
+    if (!ok){
+        cerr << "FAIL: " << what << endl;
+        g_failures++;
+    }
+}
+
+// Name: ReadAll
+// Description: Returns the contents of fileName, or "" if it cannot be read
+// Preconditions: None
+// Postconditions: None
+static string ReadAll(const string& fileName){
+    ifstream file(fileName, ios::binary);
+    return string((istreambuf_iterator<char>(file)), istreambuf_iterator<char>());
+}
+
+// Name: WriteAll
+// Description: Replaces the contents of fileName with data
+// Preconditions: None
+// Postconditions: None
+static void WriteAll(const string& fileName, const string& data){
+    ofstream file(fileName, ios::binary | ios::trunc);
+    file << data;
+}
+
+// Name: Show
+// Description: Returns what Display prints for browser
+// Preconditions: None
+// Postconditions: None
+static string Show(const Browser& browser){
+    string text;
+    StringSink sink(text);
+    browser.Display(sink);
+    return text;
+}
+
+// Name: Start
+// Description: Writes the CSV and removes the snapshot and journal, so the
+//              next OpenJournal is a first start
+// Preconditions: None
+// Postconditions: None
+static void Start(const string& snapshotName, const string& journalName){
+    WriteAll(TEST_CSV, "http://a.com,1600000000\nhttp://b.com,1600000001\nhttp://c.com,1600000002\n");
+    remove(snapshotName.c_str());
+    remove(journalName.c_str());
+}
+
+// Name: Work
+// Description: Visits visits pages and goes back once, syncing every
+//              record if browser has a journal open
+// Preconditions: None
+// Postconditions: None
+static void Work(Browser& browser, int visits){
+    browser.SetJournalGroup(1, 0);
+    for (int i = 0; i < visits; i++){
+        browser.Visit("http://v" + to_string(i) + ".com", 1700000000000LL + i);
+    }
+    browser.Back(1);
+}
+
+// Name: Expected
+// Description: Returns what a browser shows after importing the CSV and
+//              then, if work is true, doing what Work(browser, 4) does
+// Preconditions: None
+// Postconditions: None
+static string Expected(bool work){
+    Browser browser(TEST_CSV);
+    browser.LoadFile();
+    if (work){
+        Work(browser, 4);
+    }
+    return Show(browser);
+}
+
+// Name: TestTornTail
+// Description: A record cut short by a crash is dropped; the records
+//              before it are replayed and new records follow them
+// Preconditions: None
+// Postconditions: None
+static void TestTornTail(){
+    string snapshotName = string(TEST_CSV) + SNAPSHOT_SUFFIX;
+    string journalName = string(TEST_CSV) + JOURNAL_SUFFIX;
+    Start(snapshotName, journalName);
+    {
+        Browser browser(TEST_CSV);
+        Check(browser.OpenJournal(snapshotName, journalName), "torn tail: first start");
+        Work(browser, 4);
+        browser.Visit("http://torn.com", 1800000000000LL);
+    }
+    string journal = ReadAll(journalName);
+    WriteAll(journalName, journal.substr(0, journal.size() - 3)); //cut into the last visit
+    {
+        Browser browser(TEST_CSV);
+        Check(browser.OpenJournal(snapshotName, journalName), "torn tail: restart");
+        Check(Show(browser) == Expected(true), "torn tail: the records before the tear are replayed");
+        browser.Forward(1);
+    }
+    Browser browser(TEST_CSV);
+    Check(browser.OpenJournal(snapshotName, journalName), "torn tail: second restart");
+    Browser expected(TEST_CSV);
+    expected.LoadFile();
+    Work(expected, 4);
+    expected.Forward(1);
+    Check(Show(browser) == Show(expected), "torn tail: later records follow the good ones");
+}
+
+// Name: TestCheckpointCrash
+// Description: A crash after a checkpoint replaced the snapshot but before
+//              it emptied the journal leaves records the snapshot already
+//              holds; they are not applied twice
+// Preconditions: None
+// Postconditions: None
+static void TestCheckpointCrash(){
+    string snapshotName = string(TEST_CSV) + SNAPSHOT_SUFFIX;
+    string journalName = string(TEST_CSV) + JOURNAL_SUFFIX;
+    Start(snapshotName, journalName);
+    string journal;
+    {
+        Browser browser(TEST_CSV);
+        Check(browser.OpenJournal(snapshotName, journalName), "checkpoint crash: first start");
+        Work(browser, 4);
+        journal = ReadAll(journalName); //the journal before the checkpoint
+        Check(browser.Checkpoint(), "checkpoint crash: checkpoint");
+    }
+    WriteAll(journalName, journal); //as if the crash came before Reset
+    for (int start = 0; start < 2; start++){
+        Browser browser(TEST_CSV);
+        Check(browser.OpenJournal(snapshotName, journalName), "checkpoint crash: restart");
+        Check(Show(browser) == Expected(true), "checkpoint crash: records are applied once");
+    }
+}
+
+// Name: TestMissingSnapshot
+// Description: Without a snapshot the CSV is imported and a journal that
+//              follows no snapshot is replayed on top; a journal that
+//              follows a lost snapshot is refused and left untouched
+// Preconditions: None
+// Postconditions: None
+static void TestMissingSnapshot(){
+    //the first checkpoint fails, so the records stay in a base-0 journal
+    string snapshotName = string(TEST_MISSING_DIR) + "snapshot";
+    string journalName = string(TEST_CSV) + JOURNAL_SUFFIX;
+    Start(snapshotName, journalName);
+    {
+        Browser browser(TEST_CSV);
+        Check(!browser.OpenJournal(snapshotName, journalName), "missing snapshot: checkpoint fails");
+        Work(browser, 4);
+    }
+    {
+        Browser browser(TEST_CSV);
+        browser.OpenJournal(snapshotName, journalName);
+        Check(Show(browser) == Expected(true), "missing snapshot: CSV and journal are both applied");
+    }
+    //the snapshot a journal follows is deleted
+    snapshotName = string(TEST_CSV) + SNAPSHOT_SUFFIX;
+    Start(snapshotName, journalName);
+    {
+        Browser browser(TEST_CSV);
+        Check(browser.OpenJournal(snapshotName, journalName), "lost snapshot: first start");
+        Work(browser, 4);
+    }
+    remove(snapshotName.c_str());
+    string journal = ReadAll(journalName);
+    bool thrown = false;
+    {
+        Browser browser(TEST_CSV);
+        try{
+            browser.OpenJournal(snapshotName, journalName);
+        } catch (const runtime_error&){
+            thrown = true;
+        }
+        Check(thrown, "lost snapshot: the journal is refused");
+        Check(Show(browser) == Expected(false), "lost snapshot: the CSV is still imported");
+    }
+    Check(ReadAll(journalName) == journal, "lost snapshot: the journal is not truncated");
+    //an unreadable snapshot is rebuilt from the CSV
+    Start(snapshotName, journalName);
+    WriteAll(snapshotName, "not a snapshot");
+    Browser browser(TEST_CSV);
+    Check(browser.OpenJournal(snapshotName, journalName), "bad snapshot: restart");
+    Check(Show(browser) == Expected(false), "bad snapshot: the CSV is imported");
+}
+
+// Name: TestLoadSnapshot
+// Description: Restoring the forward pages of a loaded snapshot is not a
+//              navigation, so it writes nothing to the journal the load
+//              has not checkpointed yet
+// Preconditions: None
+// Postconditions: None
+static void TestLoadSnapshot(){
+    string savedName = string(TEST_CSV) + ".saved";
+    string snapshotName = string(TEST_MISSING_DIR) + "snapshot"; //checkpoints fail
+    string journalName = string(TEST_CSV) + JOURNAL_SUFFIX;
+    Start(snapshotName, journalName);
+    {
+        Browser source(TEST_CSV);
+        source.LoadFile();
+        Work(source, 4); //leaves a forward page
+        Check(source.SaveSnapshot(savedName), "load snapshot: save");
+    }
+    Browser browser(TEST_CSV);
+    browser.OpenJournal(snapshotName, journalName);
+    browser.SetJournalGroup(1, 0);
+    string journal = ReadAll(journalName);
+    Check(browser.LoadSnapshot(savedName), "load snapshot: load");
+    Check(Show(browser) == Expected(true), "load snapshot: the forward page is restored");
+    Check(ReadAll(journalName) == journal, "load snapshot: nothing is logged");
+    remove(savedName.c_str());
+}
+
+// Name: TestFailedWrite
+// Description: A write cut short (here by a file size limit, as a full
+//              disk would) leaves no torn record for later records to
+//              hide behind: the group is retried and nothing is lost
+// Preconditions: None
+// Postconditions: None
+static void TestFailedWrite(){
+#if defined(__unix__) || defined(__APPLE__)
+    string journalName = string(TEST_CSV) + JOURNAL_SUFFIX;
+    remove(journalName.c_str());
+    Journal journal;
+    Check(journal.Open(journalName, 0, 0, 0), "failed write: open");
+    journal.SetGroupCommit(1, 0);
+    string url(40, 'u');
+    journal.Append({JOURNAL_VISIT, url, 1, 0});
+    size_t committed = ReadAll(journalName).size();
+    struct rlimit old;
+    getrlimit(RLIMIT_FSIZE, &old);
+    struct rlimit limit = old;
+    limit.rlim_cur = committed + 10; //the next record fits only in part
+    signal(SIGXFSZ, SIG_IGN); //fail the write instead of ending the process
+    setrlimit(RLIMIT_FSIZE, &limit);
+    journal.Append({JOURNAL_VISIT, url, 2, 0});
+    Check(journal.HasFailed(), "failed write: the failure is reported");
+    Check(ReadAll(journalName).size() == committed, "failed write: the torn record is cut off");
+    setrlimit(RLIMIT_FSIZE, &old);
+    journal.Append({JOURNAL_VISIT, url, 3, 0});
+    Check(!journal.HasFailed(), "failed write: the retry succeeds");
+    journal.Close();
+    string data = ReadAll(journalName);
+    uint64_t base;
+    vector<JournalRecord> records;
+    size_t validSize;
+    Check(DecodeJournal(data.data(), data.size(), base, records, validSize) && records.size() == 3 &&
+          records[1].m_timeStamp == 2 && records[2].m_timeStamp == 3,
+          "failed write: every record is read back in order");
+#endif
+}
+
+int main(){
+    TestTornTail();
+    TestCheckpointCrash();
+    TestMissingSnapshot();
+    TestLoadSnapshot();
+    TestFailedWrite();
+    remove(TEST_CSV);
+    remove((string(TEST_CSV) + SNAPSHOT_SUFFIX).c_str());
+    remove((string(TEST_CSV) + JOURNAL_SUFFIX).c_str());
+    if (g_failures > 0){
+        return 1;
+    }
+    cout << "All journal checks passed" << endl;
+    return 0;
+}
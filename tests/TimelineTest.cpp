@@ -0,0 +1,67 @@
+/*Title: TimelineTest.cpp
+  Author: Shariq Moghees
+  Date: 10/17/2026
+  Description: Checks that Timeline's URL byte totals stay exact while the
+               oldest entries are evicted and the array is compacted.
+               Returns non-zero if any check fails.
+*/
+#include "../Timeline.h"
+#include <iostream>
+#include <string>
+
+//Constants
+const size_t TEST_ENTRIES = 3000; //Entries pushed, enough to compact
+const size_t TEST_URL_BYTES = 10; //Length of every URL
+
+static int g_failures = 0; //Checks failed so far
+
+// Name: Check
+// Description: Prints what failed if ok is false
+// Preconditions: None
+// Postconditions: Counts the failure
+static void Check(bool ok, const string& what){
+    if (!ok){
+        cerr << "FAIL: " << what << endl;
+        g_failures++;
+    }
+}
+
+// Name: TestEvictedBytes
+// Description: Evicts half the entries, past a compaction, and checks the
+//              back bytes count only the entries that are left
+// Preconditions: None
+// Postconditions: None
+static void TestEvictedBytes(){
+    string url(TEST_URL_BYTES, 'u');
+    vector<NavigationEntry> entries(TEST_ENTRIES, NavigationEntry(url, 0, 0));
+    Timeline timeline;
+    for (NavigationEntry& entry : entries){
+        timeline.Push(&entry);
+    }
+    for (size_t i = 0; i < TEST_ENTRIES / 2; i++){
+        timeline.RemoveOldest();
+        size_t back = timeline.GetBackSize();
+        Check(timeline.GetBackBytes() == back * TEST_URL_BYTES,
+              "evicted bytes: back bytes after " + to_string(i + 1) + " evictions");
+    }
+    timeline.Back(10);
+    Check(timeline.GetBackBytes() == timeline.GetBackSize() * TEST_URL_BYTES,
+          "evicted bytes: back bytes after moving back");
+    timeline.TruncateForward();
+    timeline.Push(&entries[0]);
+    Check(timeline.GetBackBytes() == timeline.GetBackSize() * TEST_URL_BYTES,
+          "evicted bytes: back bytes after a push");
+    timeline.Clear();
+    timeline.Push(&entries[0]);
+    timeline.Push(&entries[1]);
+    Check(timeline.GetBackBytes() == TEST_URL_BYTES, "evicted bytes: back bytes after clearing");
+}
+
+int main(){
+    TestEvictedBytes();
+    if (g_failures > 0){
+        return 1;
+    }
+    cout << "All timeline checks passed" << endl;
+    return 0;
+}